@@ -41,148 +41,263 @@
 #include <stdio.h>
 #include <string.h>
 #include "arbre_binaire.h"
+#include "arbre_binaire_interne.h"
 
 /**
- *  \brief Alloue un espace mémoire pour y placer l'arbre binaire et y placer
- *         l'élément racine.
+ *  \brief Erreur inscrite lorsqu'un arbre ordonné est modifié directement.
+ */
+#define MESSAGE_ORDONNE "L'arbre est ordonne, utiliser \
+inserer_element_arbre_binaire."
+
+/**
+ *  \brief Erreur inscrite lorsqu'un enfant d'un arbre ordonné est retiré
+ *         directement.
+ */
+#define MESSAGE_ORDONNE_RETRAIT "L'arbre est ordonne, utiliser \
+supprimer_element_arbre_binaire."
+
+/**
+ *  \brief Alloue un noeud appartenant à l'arbre du contexte.
  *
- *  \param valeur : La valeur de la racine de l'arbre.
+ *  \param contexte : Le contexte de l'arbre qui contiendra le noeud.
+ *  \param valeur   : La valeur à placer dans le noeud.
  *
- *  \return L'arbre binaire avec la valeur de la racine.
+ *  \return Le nouveau noeud ou NULL s'il n'y a plus de mémoire.
  */
-arbre_binaire* creer_arbre_binaire(int valeur)
+arbre_binaire* allouer_noeud_arbre_binaire(arbre_binaire_contexte* contexte,
+                                           int valeur)
 {
     struct arbre_binaire_struct * noeud;
-    noeud = calloc(1, sizeof(struct arbre_binaire_struct));
-    noeud -> valeur = valeur;
-    noeud -> premier_fils = NULL;
-    noeud -> second_fils = NULL;
-    noeud -> a_erreur = false;
-    noeud -> erreur = calloc(ERREUR_TAILLE, sizeof(char));
+
+    if (contexte->options & ARBRE_BINAIRE_OPTION_ARENE) {
+        noeud = allouer_arene(&contexte->arene);
+    } else {
+        noeud = malloc(contexte->taille_noeud);
+    }
+    if (noeud) {
+        STATISTIQUE_AJOUTER(noeuds_alloues, 1);
+        noeud -> valeur = valeur;
+        noeud -> premier_fils = NULL;
+        noeud -> second_fils = NULL;
+        noeud -> contexte = contexte;
+        if (contexte->options & ARBRE_BINAIRE_OPTION_PARENT) {
+            NOEUD_PARENT(noeud) -> parent = NULL;
+        }
+        if (contexte->options & ARBRE_BINAIRE_OPTION_AUGMENTE) {
+            NOEUD_ETENDU(noeud) -> taille = 1;
+            NOEUD_ETENDU(noeud) -> feuilles = 1;
+            NOEUD_ETENDU(noeud) -> hauteur = 1;
+        }
+        if (contexte->options & ARBRE_BINAIRE_OPTION_PERSISTANT) {
+            NOEUD_PERSISTANT(noeud) -> references = 1;
+        }
+    }
 
     return noeud;
 }
 
 /**
- *  \brief Lire les données de l'arbre dans le fichier.
+ *  \brief Libère un seul noeud (sans ses enfants) de l'arbre.
  *
- *  \param fichier      : Le fichier dans lequel lire les données.
- *
- *  \note  L'arbre ne doit pas être NULL.
+ *  \param noeud : Le noeud à libérer.
  */
-void lire_fichier(arbre_binaire* arbre, FILE* fichier)
+void liberer_noeud_arbre_binaire(arbre_binaire* noeud)
 {
-    int contenu[2];
+    arbre_binaire_contexte* contexte = noeud->contexte;
 
-    retirer_erreur_arbre_binaire(arbre);
-    fread(contenu, sizeof(int), 2, fichier);
-    modifier_element_arbre_binaire(arbre, contenu[0]);
-    if (contenu[1] == 0) {
-
-    } else if (contenu[1] == 1) {
-        creer_premier_enfant_arbre_binaire(arbre, 0);
-        lire_fichier(arbre->premier_fils, fichier);
-    } else if (contenu[1] == 2) {
-        creer_second_enfant_arbre_binaire(arbre, 0);
-        lire_fichier(arbre->second_fils, fichier);
-    } else if (contenu[1] == 3) {
-        creer_premier_enfant_arbre_binaire(arbre, 0);
-        lire_fichier(arbre->premier_fils, fichier);
-        creer_second_enfant_arbre_binaire(arbre, 0);
-        lire_fichier(arbre->second_fils, fichier);
+    STATISTIQUE_AJOUTER(noeuds_liberes, 1);
+    if (contexte->options & ARBRE_BINAIRE_OPTION_ARENE) {
+        liberer_arene(&contexte->arene, noeud);
+    } else {
+        free(noeud);
     }
 }
 
 /**
- *  \brief Récupère les données d'un fichier pour créer un arbre binaire.
+ *  \brief Recalcule les informations d'un noeud étendu à partir de ses
+ *         enfants.
  *
- *  \param nom_fichier : Le nom du fichier qui contient les données.
- *
- *  \return Un nouvel arbre binaire créé à l'aide des données d'un fichier.
+ *  \param arbre : Le noeud à recalculer.
  */
-arbre_binaire* charger_arbre_binaire(char *nom_fichier)
+void calculer_noeud_etendu_arbre_binaire(arbre_binaire* arbre)
 {
-    FILE* fichier;
-    arbre_binaire* arbre;
-
-    arbre = creer_arbre_binaire(0);
-    fichier = fopen(nom_fichier, "rb");
-    lire_fichier(arbre, fichier);
-    fclose(fichier);
-
-    return arbre;
+    struct arbre_binaire_noeud_etendu* noeud = NOEUD_ETENDU(arbre);
+    struct arbre_binaire_noeud_etendu* premier;
+    struct arbre_binaire_noeud_etendu* second;
+
+    premier = NOEUD_ETENDU(arbre->premier_fils);
+    second = NOEUD_ETENDU(arbre->second_fils);
+    noeud->taille = 1;
+    noeud->feuilles = 0;
+    noeud->hauteur = 0;
+    if (premier) {
+        noeud->taille = noeud->taille + premier->taille;
+        noeud->feuilles = premier->feuilles;
+        noeud->hauteur = premier->hauteur;
+    }
+    if (second) {
+        noeud->taille = noeud->taille + second->taille;
+        noeud->feuilles = noeud->feuilles + second->feuilles;
+        if (second->hauteur > noeud->hauteur) {
+            noeud->hauteur = second->hauteur;
+        }
+    }
+    if (noeud->feuilles == 0) {
+        noeud->feuilles = 1;
+    }
+    noeud->hauteur = noeud->hauteur + 1;
 }
 
 /**
- *  \brief Libère l'espace mémoire d'un arbre binaire.
+ *  \brief Recalcule les informations d'un noeud étendu et de tous ses
+ *         ancêtres à partir de leurs enfants.
  *
- *  \param arbre : L'arbre binaire à supprimer.
+ *  \param arbre : Le premier noeud à recalculer.
  */
-void detruire_arbre_binaire(arbre_binaire* arbre)
+void mettre_a_jour_ancetres_arbre_binaire(arbre_binaire* arbre)
 {
-    retirer_erreur_arbre_binaire(arbre);
-    if (arbre->premier_fils != NULL) {
-        detruire_arbre_binaire(arbre->premier_fils);
+    while (arbre) {
+        calculer_noeud_etendu_arbre_binaire(arbre);
+        arbre = NOEUD_ETENDU(arbre)->parent;
     }
-    if (arbre->second_fils != NULL) {
-        detruire_arbre_binaire(arbre->second_fils);
-    }
-    free(arbre->erreur);
-    free(arbre);
 }
 
 /**
- *  \brief Écrit les données de l'arbre dans le fichier.
+ *  \brief Alloue un espace mémoire pour y placer l'arbre binaire et y placer
+ *         l'élément racine.
  *
- *  \param arbre        : L'arbre à enregistrer dans le fichier.
- *  \param fichier      : Le fichier dans lequel écrire les données.
+ *  \param valeur : La valeur de la racine de l'arbre.
  *
- *  \note  L'arbre ne doit pas être NULL.
+ *  \return L'arbre binaire avec la valeur de la racine.
  */
-void ecrire_fichier(arbre_binaire* arbre, FILE* fichier)
+arbre_binaire* creer_arbre_binaire(int valeur)
 {
-    int contenu[2];
-    contenu[0] = arbre->valeur;
+    return creer_arbre_binaire_options(valeur, 0);
+}
 
-    retirer_erreur_arbre_binaire(arbre);
-    if (arbre->premier_fils == NULL && arbre->second_fils == NULL) {
-        contenu[1] = 0;
-    } else if (arbre->premier_fils && arbre->second_fils == NULL) {
-        contenu[1] = 1;
-    } else if (arbre->premier_fils == NULL && arbre->second_fils) {
-        contenu[1] = 2;
-    } else {
-        contenu[1] = 3;
+/**
+ *  \brief Alloue un arbre binaire en précisant son mode de fonctionnement.
+ *
+ *  \param valeur  : La valeur de la racine de l'arbre.
+ *  \param options : Combinaison des options ARBRE_BINAIRE_OPTION_*.
+ *
+ *  \return L'arbre binaire avec la valeur de la racine.
+ */
+arbre_binaire* creer_arbre_binaire_options(int valeur, unsigned int options)
+{
+    arbre_binaire_contexte* contexte;
+    arbre_binaire* arbre = NULL;
+
+    if (options & ARBRE_BINAIRE_OPTION_PERSISTANT) {
+        options = (options & ~(ARBRE_BINAIRE_OPTION_ORDONNE |
+                               ARBRE_BINAIRE_OPTION_EQUILIBRE |
+                               ARBRE_BINAIRE_OPTION_CONCURRENT)) |
+                  ARBRE_BINAIRE_OPTION_AUGMENTE;
+    }
+    if (options & ARBRE_BINAIRE_OPTION_CONCURRENT) {
+        options = options & ~(ARBRE_BINAIRE_OPTION_ORDONNE |
+                              ARBRE_BINAIRE_OPTION_EQUILIBRE |
+                              ARBRE_BINAIRE_OPTION_AUGMENTE |
+                              ARBRE_BINAIRE_OPTION_PARENT |
+                              ARBRE_BINAIRE_OPTION_MORRIS);
     }
-    fwrite(contenu, sizeof(int), 2, fichier);
-    if (arbre->premier_fils) {
-        ecrire_fichier(arbre->premier_fils, fichier);
+    if (options & ARBRE_BINAIRE_OPTION_EQUILIBRE) {
+        options = options | ARBRE_BINAIRE_OPTION_ORDONNE |
+                  ARBRE_BINAIRE_OPTION_AUGMENTE;
     }
-    if (arbre->second_fils) {
-        ecrire_fichier(arbre->second_fils, fichier);
+    if (options & ARBRE_BINAIRE_OPTION_AUGMENTE) {
+        options = options | ARBRE_BINAIRE_OPTION_PARENT;
+    }
+    contexte = calloc(1, sizeof(arbre_binaire_contexte));
+    if (contexte && options & ARBRE_BINAIRE_OPTION_CONCURRENT &&
+        !initialiser_concurrence_arbre_binaire(contexte)) {
+        free(contexte);
+        contexte = NULL;
+    }
+    if (contexte) {
+        contexte->options = options;
+        contexte->versions = 1;
+        if (options & ARBRE_BINAIRE_OPTION_PERSISTANT) {
+            contexte->taille_noeud =
+                    sizeof(struct arbre_binaire_noeud_persistant);
+        } else if (options & ARBRE_BINAIRE_OPTION_AUGMENTE) {
+            contexte->taille_noeud = sizeof(struct arbre_binaire_noeud_etendu);
+        } else if (options & ARBRE_BINAIRE_OPTION_PARENT) {
+            contexte->taille_noeud = sizeof(struct arbre_binaire_noeud_parent);
+        } else {
+            contexte->taille_noeud = sizeof(struct arbre_binaire_struct);
+        }
+        initialiser_arene(&contexte->arene, contexte->taille_noeud);
+        arbre = allouer_noeud_arbre_binaire(contexte, valeur);
+        if (arbre) {
+            contexte->racine = arbre;
+        } else {
+            liberer_concurrence_arbre_binaire(contexte);
+            free(contexte);
+        }
     }
+
+    return arbre;
 }
 
 /**
- *  \brief Sauvegarde les données d'un arbre binaire dans un fichier.
+ *  \brief Visiteur qui libère chaque noeud d'un sous-arbre. Le parcours
+ *         préfixe lit les enfants avant de visiter le noeud.
+ */
+static bool liberer_noeud(arbre_binaire* noeud, int profondeur, void* donnees)
+{
+    liberer_noeud_arbre_binaire(noeud);
+    return true;
+}
+
+/**
+ *  \brief Libère les noeuds d'un sous-arbre.
  *
- *  \param arbre        : L'arbre à enregistrer dans le fichier.
- *  \param nom_fichier  : Le fichier dans lequel sauvergarder les données.
+ *  \param arbre : Le sous-arbre à libérer.
+ */
+static void liberer_sous_arbre(arbre_binaire* arbre)
+{
+    parcourir_arbre_binaire(arbre, ARBRE_BINAIRE_PREFIXE, liberer_noeud, NULL);
+}
+
+/**
+ *  \brief Libère l'espace mémoire d'un arbre binaire.
  *
- *  \note  L'arbre ne doit pas être NULL.
+ *  \param arbre : L'arbre binaire à supprimer.
+ *
+ *  \note  Si l'arbre est la racine, toute la mémoire appartenant à l'arbre
+ *         (incluant les pages de l'arène) est libérée.
  */
-void sauvegarder_arbre_binaire(arbre_binaire* arbre, char * nom_fichier)
+void detruire_arbre_binaire(arbre_binaire* arbre)
 {
-    retirer_erreur_arbre_binaire(arbre);
-    FILE* fichier;
-    fichier = fopen(nom_fichier, "wb");
-    if (fichier) {
-        ecrire_fichier(arbre, fichier);
-        fclose(fichier);
+    arbre_binaire_contexte* contexte = arbre->contexte;
+
+    STATISTIQUE_DEBUT(ARBRE_BINAIRE_FONCTION_DETRUIRE);
+    if (contexte->options & ARBRE_BINAIRE_OPTION_PERSISTANT) {
+        detruire_persistant_arbre_binaire(arbre);
+    } else if (contexte->racine == arbre) {
+        liberer_concurrence_arbre_binaire(contexte);
+        if (contexte->options & ARBRE_BINAIRE_OPTION_ARENE) {
+            STATISTIQUE_AJOUTER(noeuds_liberes,
+                                compter_noeuds_arene(&contexte->arene));
+            vider_arene(&contexte->arene);
+        } else {
+            liberer_sous_arbre(arbre);
+        }
+        free(contexte);
     } else {
-        inscrire_erreur_arbre_binaire(arbre, "Il est impossible d'ecrire dans \
-                                      ce fichier");
+        liberer_sous_arbre(arbre);
     }
+    STATISTIQUE_FIN();
+}
+
+/**
+ *  \brief Visiteur qui compte les noeuds.
+ */
+static bool compter_noeud(arbre_binaire* noeud, int profondeur, void* donnees)
+{
+    *(int*)donnees = *(int*)donnees + 1;
+    return true;
 }
 
 /**
@@ -194,26 +309,33 @@ void sauvegarder_arbre_binaire(arbre_binaire* arbre, char * nom_fichier)
  */
 int nombre_elements_arbre_binaire(arbre_binaire* arbre)
 {
-    int nombre;
-    int nombre_premier = 0;
-    int nombre_second = 0;
+    int nombre = 0;
 
     retirer_erreur_arbre_binaire(arbre);
-    if (arbre == NULL) {
-        nombre = 0;
+    STATISTIQUE_DEBUT(ARBRE_BINAIRE_FONCTION_NOMBRE_ELEMENTS);
+    if (arbre && arbre->contexte->options & ARBRE_BINAIRE_OPTION_AUGMENTE) {
+        nombre = NOEUD_ETENDU(arbre)->taille;
     } else {
-        if (arbre->premier_fils != NULL) {
-           nombre_premier = nombre_elements_arbre_binaire(arbre->premier_fils);
-        }
-        if (arbre->second_fils) {
-            nombre_second = nombre_elements_arbre_binaire(arbre->second_fils);
-        }
-        nombre = 1 + nombre_premier + nombre_second;
+        parcourir_arbre_binaire(arbre, ordre_lecture_arbre_binaire(arbre),
+                                compter_noeud, &nombre);
     }
+    STATISTIQUE_FIN();
 
     return nombre;
 }
 
+/**
+ *  \brief Visiteur qui compte les noeuds sans enfant.
+ */
+static bool compter_feuille(arbre_binaire* noeud, int profondeur,
+                            void* donnees)
+{
+    if (noeud->premier_fils == NULL && noeud->second_fils == NULL) {
+        *(int*)donnees = *(int*)donnees + 1;
+    }
+    return true;
+}
+
 /**
  *  \brief Indique le nombre de feuilles que contient l'arbre binaire.
  *
@@ -223,28 +345,33 @@ int nombre_elements_arbre_binaire(arbre_binaire* arbre)
  */
 int nombre_feuilles_arbre_binaire(arbre_binaire* arbre)
 {
-    int feuilles;
-    int feuilles_premier = 0;
-    int feuilles_second = 0;
+    int feuilles = 0;
 
     retirer_erreur_arbre_binaire(arbre);
-    if (arbre == NULL) {
-        feuilles = 0;
-    } else if (arbre->premier_fils == NULL && arbre->second_fils == NULL) {
-        feuilles = 1;
+    STATISTIQUE_DEBUT(ARBRE_BINAIRE_FONCTION_NOMBRE_FEUILLES);
+    if (arbre && arbre->contexte->options & ARBRE_BINAIRE_OPTION_AUGMENTE) {
+        feuilles = NOEUD_ETENDU(arbre)->feuilles;
     } else {
-        if (arbre->premier_fils) {
-        feuilles_premier = nombre_feuilles_arbre_binaire(arbre->premier_fils);
-        }
-        if (arbre->second_fils) {
-            feuilles_second = nombre_feuilles_arbre_binaire(arbre->second_fils);
-        }
-        feuilles = feuilles_premier + feuilles_second;
+        parcourir_arbre_binaire(arbre, ordre_lecture_arbre_binaire(arbre),
+                                compter_feuille, &feuilles);
     }
+    STATISTIQUE_FIN();
 
     return feuilles;
 }
 
+/**
+ *  \brief Visiteur qui conserve la plus grande profondeur rencontrée.
+ */
+static bool mesurer_profondeur(arbre_binaire* noeud, int profondeur,
+                               void* donnees)
+{
+    if (profondeur > *(int*)donnees) {
+        *(int*)donnees = profondeur;
+    }
+    return true;
+}
+
 /**
  *  \brief Indique la hauteur de l'arbre binaire.
  *
@@ -254,26 +381,17 @@ int nombre_feuilles_arbre_binaire(arbre_binaire* arbre)
  */
 int hauteur_arbre_binaire(arbre_binaire* arbre)
 {
-    int hauteur;
-    int hauteur_premier = 0;
-    int hauteur_second = 0;
+    int hauteur = 0;
 
     retirer_erreur_arbre_binaire(arbre);
-    if (arbre == NULL) {
-        hauteur = 0;
+    STATISTIQUE_DEBUT(ARBRE_BINAIRE_FONCTION_HAUTEUR);
+    if (arbre && arbre->contexte->options & ARBRE_BINAIRE_OPTION_AUGMENTE) {
+        hauteur = NOEUD_ETENDU(arbre)->hauteur;
     } else {
-        if (arbre->premier_fils != NULL) {
-            hauteur_premier = hauteur_arbre_binaire(arbre->premier_fils);
-        }
-        if (arbre->second_fils) {
-            hauteur_second = hauteur_arbre_binaire(arbre->second_fils);
-        }
-        if (hauteur_premier >= hauteur_second) {
-            hauteur = hauteur_premier + 1;
-        } else {
-            hauteur = hauteur_second + 1;
-        }
+        parcourir_arbre_binaire(arbre, ordre_lecture_arbre_binaire(arbre),
+                                mesurer_profondeur, &hauteur);
     }
+    STATISTIQUE_FIN();
 
     return hauteur;
 }
@@ -290,7 +408,7 @@ int hauteur_arbre_binaire(arbre_binaire* arbre)
 int element_arbre_binaire(arbre_binaire* arbre)
 {
     retirer_erreur_arbre_binaire(arbre);
-    return arbre->valeur;
+    return LIRE_VALEUR(arbre);
 }
 
 /**
@@ -299,12 +417,31 @@ int element_arbre_binaire(arbre_binaire* arbre)
  *  \param arbre  : L'arbre dans lequel faire la modification.
  *  \param valeur : La nouvelle valeur de la racine.
  *
- *  \note  L'arbre ne doit pas être NULL.
+ *  \note  L'arbre ne doit pas être NULL. Dans un arbre ordonné, la valeur
+ *         n'est pas modifiée et une erreur est inscrite.
  */
 void modifier_element_arbre_binaire(arbre_binaire* arbre, int valeur)
 {
+    arbre_binaire* noeud;
+
     retirer_erreur_arbre_binaire(arbre);
-    arbre->valeur = valeur;
+    if (arbre->contexte->options & ARBRE_BINAIRE_OPTION_ORDONNE) {
+        inscrire_erreur_arbre_binaire(arbre, MESSAGE_ORDONNE);
+    } else {
+        noeud = preparer_ecriture_arbre_binaire(arbre);
+        if (noeud) {
+            ECRIRE_VALEUR(noeud, valeur);
+        }
+    }
+}
+
+/**
+ *  \brief Visiteur qui arrête le parcours dès que la valeur est trouvée.
+ */
+static bool comparer_valeur(arbre_binaire* noeud, int profondeur,
+                            void* donnees)
+{
+    return LIRE_VALEUR(noeud) != *(int*)donnees;
 }
 
 /**
@@ -320,18 +457,16 @@ bool contient_element_arbre_binaire(arbre_binaire* arbre, int valeur)
     bool presence = false;
 
     retirer_erreur_arbre_binaire(arbre);
-    if (arbre == NULL) {
-        presence = false;
-    }
-    if (arbre->valeur == valeur) {
-        presence = true;
-    }
-    if (arbre->premier_fils != NULL && presence == false) {
-        presence = contient_element_arbre_binaire(arbre->premier_fils, valeur);
-    }
-    if (arbre->second_fils != NULL && presence == false) {
-        presence = contient_element_arbre_binaire(arbre->second_fils, valeur);
+    STATISTIQUE_DEBUT(ARBRE_BINAIRE_FONCTION_CONTIENT);
+    if (arbre && arbre->contexte->options & ARBRE_BINAIRE_OPTION_ORDONNE) {
+        presence = chercher_element_arbre_binaire(arbre, valeur) != NULL;
+    } else if (arbre) {
+        presence = !parcourir_arbre_binaire(arbre,
+                                            ordre_lecture_arbre_binaire(arbre),
+                                            comparer_valeur, &valeur) &&
+                   !a_erreur_arbre_binaire(arbre);
     }
+    STATISTIQUE_FIN();
     return presence;
 }
 
@@ -348,7 +483,7 @@ bool contient_element_arbre_binaire(arbre_binaire* arbre, int valeur)
 arbre_binaire* premier_enfant_arbre_binaire(arbre_binaire* arbre)
 {
     retirer_erreur_arbre_binaire(arbre);
-    return arbre->premier_fils;
+    return LIRE_FILS(arbre, premier_fils);
 }
 
 /**
@@ -358,16 +493,46 @@ arbre_binaire* premier_enfant_arbre_binaire(arbre_binaire* arbre)
  *  \param arbre  : L'arbre binaire dans lequel créer un premier enfant.
  *  \param valeur : La valeur à placer dans le premier enfant.
  */
-void creer_premier_enfant_arbre_binaire(arbre_binaire* arbre, int valeur)
+arbre_binaire_statut creer_premier_enfant_arbre_binaire(arbre_binaire* arbre,
+                                                   int valeur)
 {
+    arbre_binaire_statut statut = ARBRE_BINAIRE_SUCCES;
+    arbre_binaire* enfant;
+    arbre_binaire* noeud;
+
     retirer_erreur_arbre_binaire(arbre);
     if (arbre == NULL) {
-        inscrire_erreur_arbre_binaire(arbre, "L'arbre est inexistant.");
-    } else if (arbre->premier_fils == NULL) {
-        arbre->premier_fils = creer_arbre_binaire(valeur);
+        return ARBRE_BINAIRE_ERREUR_INEXISTANT;
+    }
+    STATISTIQUE_DEBUT(ARBRE_BINAIRE_FONCTION_CREER_ENFANT);
+    verrouiller_ecriture_arbre_binaire(arbre->contexte);
+    if (arbre->contexte->options & ARBRE_BINAIRE_OPTION_ORDONNE) {
+        statut = inscrire_erreur_arbre_binaire(arbre, MESSAGE_ORDONNE);
+    } else if (arbre->premier_fils != NULL) {
+        statut = inscrire_erreur_arbre_binaire(arbre, "Il y a deja un premier \
+fils.");
     } else {
-        inscrire_erreur_arbre_binaire(arbre, "Il y a deja un premier fils.");
+        noeud = preparer_ecriture_arbre_binaire(arbre);
+        enfant = noeud ? allouer_noeud_arbre_binaire(arbre->contexte, valeur)
+                       : NULL;
+        if (noeud == NULL) {
+            statut = ARBRE_BINAIRE_ERREUR;
+        } else if (enfant == NULL) {
+            statut = inscrire_erreur_arbre_binaire(arbre, "Il n'y a plus de \
+memoire.");
+        } else {
+            if (arbre->contexte->options & ARBRE_BINAIRE_OPTION_PARENT) {
+                NOEUD_PARENT(enfant)->parent = noeud;
+            }
+            PUBLIER_FILS(noeud, premier_fils, enfant);
+            if (arbre->contexte->options & ARBRE_BINAIRE_OPTION_AUGMENTE) {
+                mettre_a_jour_ancetres_arbre_binaire(noeud);
+            }
+        }
     }
+    deverrouiller_ecriture_arbre_binaire(arbre->contexte);
+    STATISTIQUE_FIN();
+    return statut;
 }
 
 /**
@@ -375,13 +540,34 @@ void creer_premier_enfant_arbre_binaire(arbre_binaire* arbre, int valeur)
  *
  *  \param arbre : L'arbre duquel on supprime le premier enfant.
  *
- *  \note  L'arbre ne doit pas être NULL.
+ *  \note  L'arbre ne doit pas être NULL. Un arbre ordonné n'est pas
+ *         modifié et reçoit une erreur.
  */
 void retirer_premier_enfant_arbre_binaire(arbre_binaire* arbre)
 {
+    arbre_binaire* enfant;
+    arbre_binaire* noeud = NULL;
+
     retirer_erreur_arbre_binaire(arbre);
-    detruire_arbre_binaire(arbre->premier_fils);
-    arbre->premier_fils = NULL;
+    verrouiller_ecriture_arbre_binaire(arbre->contexte);
+    if (arbre->contexte->options & ARBRE_BINAIRE_OPTION_ORDONNE) {
+        inscrire_erreur_arbre_binaire(arbre, MESSAGE_ORDONNE_RETRAIT);
+    } else if (arbre->premier_fils) {
+        noeud = preparer_ecriture_arbre_binaire(arbre);
+    }
+    if (noeud) {
+        enfant = noeud->premier_fils;
+        PUBLIER_FILS(noeud, premier_fils, NULL);
+        if (arbre->contexte->concurrence) {
+            differer_liberation_arbre_binaire(enfant);
+        } else {
+            detruire_arbre_binaire(enfant);
+        }
+        if (arbre->contexte->options & ARBRE_BINAIRE_OPTION_AUGMENTE) {
+            mettre_a_jour_ancetres_arbre_binaire(noeud);
+        }
+    }
+    deverrouiller_ecriture_arbre_binaire(arbre->contexte);
 }
 
 /**
@@ -397,7 +583,7 @@ void retirer_premier_enfant_arbre_binaire(arbre_binaire* arbre)
 arbre_binaire* second_enfant_arbre_binaire(arbre_binaire* arbre)
 {
     retirer_erreur_arbre_binaire(arbre);
-    return arbre->second_fils;
+    return LIRE_FILS(arbre, second_fils);
 }
 
 /**
@@ -407,16 +593,46 @@ arbre_binaire* second_enfant_arbre_binaire(arbre_binaire* arbre)
  *  \param arbre  : L'arbre binaire dans lequel créer un second enfant.
  *  \param valeur : La valeur à placer dans le second enfant.
  */
-void creer_second_enfant_arbre_binaire(arbre_binaire* arbre, int valeur)
+arbre_binaire_statut creer_second_enfant_arbre_binaire(arbre_binaire* arbre,
+                                                   int valeur)
 {
+    arbre_binaire_statut statut = ARBRE_BINAIRE_SUCCES;
+    arbre_binaire* enfant;
+    arbre_binaire* noeud;
+
     retirer_erreur_arbre_binaire(arbre);
     if (arbre == NULL) {
-        inscrire_erreur_arbre_binaire(arbre, "L'arbre est inexistant.");
-    } else if (arbre->second_fils == NULL) {
-        arbre->second_fils = creer_arbre_binaire(valeur);
+        return ARBRE_BINAIRE_ERREUR_INEXISTANT;
+    }
+    STATISTIQUE_DEBUT(ARBRE_BINAIRE_FONCTION_CREER_ENFANT);
+    verrouiller_ecriture_arbre_binaire(arbre->contexte);
+    if (arbre->contexte->options & ARBRE_BINAIRE_OPTION_ORDONNE) {
+        statut = inscrire_erreur_arbre_binaire(arbre, MESSAGE_ORDONNE);
+    } else if (arbre->second_fils != NULL) {
+        statut = inscrire_erreur_arbre_binaire(arbre, "Il y a deja un second \
+fils.");
     } else {
-        inscrire_erreur_arbre_binaire(arbre, "Il y a deja un second fils.");
+        noeud = preparer_ecriture_arbre_binaire(arbre);
+        enfant = noeud ? allouer_noeud_arbre_binaire(arbre->contexte, valeur)
+                       : NULL;
+        if (noeud == NULL) {
+            statut = ARBRE_BINAIRE_ERREUR;
+        } else if (enfant == NULL) {
+            statut = inscrire_erreur_arbre_binaire(arbre, "Il n'y a plus de \
+memoire.");
+        } else {
+            if (arbre->contexte->options & ARBRE_BINAIRE_OPTION_PARENT) {
+                NOEUD_PARENT(enfant)->parent = noeud;
+            }
+            PUBLIER_FILS(noeud, second_fils, enfant);
+            if (arbre->contexte->options & ARBRE_BINAIRE_OPTION_AUGMENTE) {
+                mettre_a_jour_ancetres_arbre_binaire(noeud);
+            }
+        }
     }
+    deverrouiller_ecriture_arbre_binaire(arbre->contexte);
+    STATISTIQUE_FIN();
+    return statut;
 }
 
 /**
@@ -424,38 +640,147 @@ void creer_second_enfant_arbre_binaire(arbre_binaire* arbre, int valeur)
  *
  *  \param arbre : L'arbre duquel on supprime le second enfant.
  *
- *  \note  L'arbre ne doit pas être NULL.
+ *  \note  L'arbre ne doit pas être NULL. Un arbre ordonné n'est pas
+ *         modifié et reçoit une erreur.
  */
 void retirer_second_enfant_arbre_binaire(arbre_binaire* arbre)
 {
+    arbre_binaire* enfant;
+    arbre_binaire* noeud = NULL;
+
     retirer_erreur_arbre_binaire(arbre);
-    detruire_arbre_binaire(arbre->second_fils);
-    arbre->second_fils = NULL;
+    verrouiller_ecriture_arbre_binaire(arbre->contexte);
+    if (arbre->contexte->options & ARBRE_BINAIRE_OPTION_ORDONNE) {
+        inscrire_erreur_arbre_binaire(arbre, MESSAGE_ORDONNE_RETRAIT);
+    } else if (arbre->second_fils) {
+        noeud = preparer_ecriture_arbre_binaire(arbre);
+    }
+    if (noeud) {
+        enfant = noeud->second_fils;
+        PUBLIER_FILS(noeud, second_fils, NULL);
+        if (arbre->contexte->concurrence) {
+            differer_liberation_arbre_binaire(enfant);
+        } else {
+            detruire_arbre_binaire(enfant);
+        }
+        if (arbre->contexte->options & ARBRE_BINAIRE_OPTION_AUGMENTE) {
+            mettre_a_jour_ancetres_arbre_binaire(noeud);
+        }
+    }
+    deverrouiller_ecriture_arbre_binaire(arbre->contexte);
 }
 
 /**
- *  \brief Cherche s'il y a une erreur dans l'arbre binaire et retourne
- *         la réponse (Vrai/Faux).
+ *  \brief Place une copie d'un sous-arbre comme enfant d'un noeud.
  *
- *  \param arbre : l'arbre binaire à vérifier.
+ *  \param arbre   : Le noeud qui reçoit la copie.
+ *  \param greffon : Le sous-arbre à copier (d'un arbre quelconque).
+ *  \param premier : Vrai pour le premier enfant, Faux pour le second.
  *
- *  \return Vrai s'il y a erreur et Faux en cas inverse.
+ *  \return ARBRE_BINAIRE_SUCCES si la copie a été placée.
  */
-bool a_erreur_arbre_binaire(arbre_binaire* arbre)
+static arbre_binaire_statut greffer_enfant(arbre_binaire* arbre,
+                                           arbre_binaire* greffon,
+                                           bool premier)
 {
-    bool contient_erreur = false;
+    arbre_binaire_statut statut = ARBRE_BINAIRE_SUCCES;
+    arbre_binaire* copie;
+    arbre_binaire* noeud;
+    unsigned int options;
 
-    if (arbre->a_erreur) {
-        contient_erreur = true;
+    retirer_erreur_arbre_binaire(arbre);
+    if (arbre == NULL || greffon == NULL) {
+        return ARBRE_BINAIRE_ERREUR_INEXISTANT;
+    }
+    options = arbre->contexte->options;
+    verrouiller_ecriture_arbre_binaire(arbre->contexte);
+    if (options & ARBRE_BINAIRE_OPTION_ORDONNE) {
+        statut = inscrire_erreur_arbre_binaire(arbre, MESSAGE_ORDONNE);
+    } else if (premier && arbre->premier_fils != NULL) {
+        statut = inscrire_erreur_arbre_binaire(arbre, "Il y a deja un premier \
+fils.");
+    } else if (premier == false && arbre->second_fils != NULL) {
+        statut = inscrire_erreur_arbre_binaire(arbre, "Il y a deja un second \
+fils.");
     } else {
-        if (arbre->premier_fils) {
-            contient_erreur = a_erreur_arbre_binaire(arbre->premier_fils);
+        noeud = preparer_ecriture_arbre_binaire(arbre);
+        if (noeud && options & ARBRE_BINAIRE_OPTION_ARENE &&
+            greffon->contexte->options & ARBRE_BINAIRE_OPTION_AUGMENTE) {
+            reserver_arene(&arbre->contexte->arene,
+                           NOEUD_ETENDU(greffon)->taille);
         }
-        if (arbre->second_fils && contient_erreur == false) {
-            contient_erreur = a_erreur_arbre_binaire(arbre->second_fils);
+        copie = noeud ? allouer_noeud_arbre_binaire(arbre->contexte, 0)
+                      : NULL;
+        if (noeud == NULL) {
+            statut = ARBRE_BINAIRE_ERREUR;
+        } else if (copie == NULL) {
+            statut = inscrire_erreur_arbre_binaire(arbre, "Il n'y a plus de \
+memoire.");
+        } else if (!copier_sous_arbre_binaire(copie, greffon)) {
+            liberer_sous_arbre(copie);
+            statut = inscrire_erreur_arbre_binaire(arbre, "Il n'y a plus de \
+memoire.");
+        } else {
+            if (options & ARBRE_BINAIRE_OPTION_PARENT) {
+                NOEUD_PARENT(copie)->parent = noeud;
+            }
+            if (premier) {
+                PUBLIER_FILS(noeud, premier_fils, copie);
+            } else {
+                PUBLIER_FILS(noeud, second_fils, copie);
+            }
+            if (options & ARBRE_BINAIRE_OPTION_AUGMENTE) {
+                mettre_a_jour_ancetres_arbre_binaire(noeud);
+            }
         }
     }
-    return contient_erreur;
+    deverrouiller_ecriture_arbre_binaire(arbre->contexte);
+    return statut;
+}
+
+/**
+ *  \brief Place une copie d'un sous-arbre (qui peut appartenir à un autre
+ *         arbre) comme premier enfant de l'arbre binaire. S'il y a un
+ *         premier enfant, ajoute une erreur.
+ *
+ *  \param arbre   : L'arbre binaire qui reçoit la copie.
+ *  \param greffon : Le sous-arbre à copier.
+ *
+ *  \return ARBRE_BINAIRE_SUCCES si la copie a été placée.
+ */
+arbre_binaire_statut greffer_premier_enfant_arbre_binaire(arbre_binaire* arbre,
+                                                     arbre_binaire* greffon)
+{
+    return greffer_enfant(arbre, greffon, true);
+}
+
+/**
+ *  \brief Place une copie d'un sous-arbre (qui peut appartenir à un autre
+ *         arbre) comme second enfant de l'arbre binaire. S'il y a un
+ *         second enfant, ajoute une erreur.
+ *
+ *  \param arbre   : L'arbre binaire qui reçoit la copie.
+ *  \param greffon : Le sous-arbre à copier.
+ *
+ *  \return ARBRE_BINAIRE_SUCCES si la copie a été placée.
+ */
+arbre_binaire_statut greffer_second_enfant_arbre_binaire(arbre_binaire* arbre,
+                                                    arbre_binaire* greffon)
+{
+    return greffer_enfant(arbre, greffon, false);
+}
+
+/**
+ *  \brief Indique s'il y a une erreur dans l'arbre binaire et retourne
+ *         la réponse (Vrai/Faux).
+ *
+ *  \param arbre : l'arbre binaire à vérifier.
+ *
+ *  \return Vrai s'il y a erreur et Faux en cas inverse.
+ */
+bool a_erreur_arbre_binaire(arbre_binaire* arbre)
+{
+    return erreur_contexte_arbre_binaire(arbre->contexte)->a_erreur;
 }
 
 /**
@@ -463,36 +788,43 @@ bool a_erreur_arbre_binaire(arbre_binaire* arbre)
  *
  *  \param arbre : L'arbre binaire à vérifier.
  *
- *  \return Le texte de l'erreur.
+ *  \return Le texte de l'erreur (vide s'il n'y a pas d'erreur).
  */
 char* erreur_arbre_binaire(arbre_binaire* arbre)
 {
-    char* message_erreur;
+    struct arbre_binaire_erreur* erreur;
 
-    if (arbre->a_erreur == false) {
-        message_erreur = strncpy(arbre->erreur, "", ERREUR_TAILLE);
-    } else {
-        if (a_erreur_arbre_binaire(arbre->premier_fils)) {
-            message_erreur = erreur_arbre_binaire(arbre->premier_fils);
-        }
-        if (a_erreur_arbre_binaire(arbre->second_fils)) {
-            message_erreur = erreur_arbre_binaire(arbre->second_fils);
-        }
+    erreur = erreur_contexte_arbre_binaire(arbre->contexte);
+    if (erreur->a_erreur == false) {
+        erreur->texte[0] = '\0';
     }
-    return message_erreur;
+    return erreur->texte;
 }
 
 /**
- *  \brief Place le message d'erreur dans l'arbre binaire et conserve
- *         celle-ci dans la librairie. Mets "a_erreur_arbre_binaire" à Vrai.
+ *  \brief Place le message d'erreur dans le contexte de l'arbre binaire.
+ *         Mets "a_erreur_arbre_binaire" à Vrai.
  *
  *  \param arbre : L'arbre binaire qui a été vérifié.
  *  \param erreur : La description de l'erreur.
+ *
+ *  \return ARBRE_BINAIRE_ERREUR, ou ARBRE_BINAIRE_ERREUR_INEXISTANT si
+ *          l'arbre est NULL.
  */
-void inscrire_erreur_arbre_binaire(arbre_binaire* arbre, const char* erreur)
+arbre_binaire_statut inscrire_erreur_arbre_binaire(arbre_binaire* arbre,
+                                                   const char* erreur)
 {
-    arbre->a_erreur = true;
-    strncpy(arbre->erreur, erreur, ERREUR_TAILLE);
+    arbre_binaire_statut statut = ARBRE_BINAIRE_ERREUR_INEXISTANT;
+    struct arbre_binaire_erreur* emplacement;
+
+    if (arbre) {
+        emplacement = erreur_contexte_arbre_binaire(arbre->contexte);
+        emplacement->a_erreur = true;
+        strncpy(emplacement->texte, erreur, ERREUR_TAILLE - 1);
+        emplacement->texte[ERREUR_TAILLE - 1] = '\0';
+        statut = ARBRE_BINAIRE_ERREUR;
+    }
+    return statut;
 }
 
 /**
@@ -502,11 +834,12 @@ void inscrire_erreur_arbre_binaire(arbre_binaire* arbre, const char* erreur)
  */
 void retirer_erreur_arbre_binaire(arbre_binaire* arbre)
 {
-    arbre->a_erreur = false;
-    if (arbre->premier_fils) {
-        retirer_erreur_arbre_binaire(arbre);
-    }
-    if (arbre->second_fils) {
-        retirer_erreur_arbre_binaire(arbre);
+    struct arbre_binaire_erreur* erreur;
+
+    if (arbre) {
+        erreur = erreur_contexte_arbre_binaire(arbre->contexte);
+        if (erreur->a_erreur) {
+            erreur->a_erreur = false;
+        }
     }
 }
@@ -39,23 +39,293 @@
 #define ARBRE_BINAIRE_H_INCLUDED
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #define ERREUR_TAILLE 255
 
+/**
+ *  \brief Les noeuds de l'arbre sont alloués par pages contiguës qui
+ *         appartiennent à l'arbre. Détruire l'arbre complet ne libère que
+ *         les pages.
+ */
+#define ARBRE_BINAIRE_OPTION_ARENE 0x01
+
+/**
+ *  \brief Chaque noeud conserve la taille, le nombre de feuilles et la
+ *         hauteur de son sous-arbre. Ces valeurs sont mises à jour lors de
+ *         l'ajout et du retrait d'un enfant, ce qui rend les fonctions
+ *         nombre_elements, nombre_feuilles et hauteur instantanées.
+ */
+#define ARBRE_BINAIRE_OPTION_AUGMENTE 0x02
+
+/**
+ *  \brief L'arbre est un arbre binaire de recherche: les valeurs sont
+ *         placées par inserer_element_arbre_binaire et la recherche d'une
+ *         valeur ne parcourt qu'un chemin de la racine vers une feuille.
+ *         Les enfants ne peuvent pas être créés ni modifiés directement.
+ */
+#define ARBRE_BINAIRE_OPTION_ORDONNE 0x04
+
+/**
+ *  \brief L'arbre ordonné reste équilibré (arbre AVL): sa hauteur reste
+ *         logarithmique même si les valeurs sont insérées en ordre. Cette
+ *         option active aussi ARBRE_BINAIRE_OPTION_ORDONNE et
+ *         ARBRE_BINAIRE_OPTION_AUGMENTE, dont la hauteur est utilisée.
+ *
+ *  \note  Les rotations échangent les valeurs des noeuds: un noeud obtenu
+ *         avant une insertion ou un retrait peut contenir une autre valeur
+ *         après celle-ci.
+ */
+#define ARBRE_BINAIRE_OPTION_EQUILIBRE 0x08
+
+/**
+ *  \brief Plusieurs fils peuvent lire l'arbre sans verrou pendant qu'un fil
+ *         le modifie. Les créations et les retraits d'enfants sont
+ *         sérialisés entre eux; un sous-arbre retiré n'est libéré
+ *         que lorsque les lectures commencées avant son retrait sont
+ *         terminées. Les erreurs sont conservées pour chaque fil. Cette
+ *         option ne peut pas être combinée aux options ORDONNE, EQUILIBRE,
+ *         AUGMENTE et PARENT, qui sont ignorées.
+ */
+#define ARBRE_BINAIRE_OPTION_CONCURRENT 0x10
+
+/**
+ *  \brief L'arbre conserve ses versions précédentes: instantane_arbre_binaire
+ *         en donne une copie en temps constant. Une modification copie
+ *         seulement le chemin de la racine jusqu'au noeud modifié et partage
+ *         le reste avec les instantanés. Cette option active aussi
+ *         ARBRE_BINAIRE_OPTION_AUGMENTE; les options ORDONNE, EQUILIBRE et
+ *         CONCURRENT sont ignorées.
+ *
+ *  \note  Un noeud copié par une modification reste dans les instantanés:
+ *         un noeud obtenu avant la modification (autre que la racine)
+ *         doit être obtenu de nouveau à partir de la racine.
+ */
+#define ARBRE_BINAIRE_OPTION_PERSISTANT 0x20
+
+/**
+ *  \brief Chaque noeud conserve un lien vers son parent, ce qui permet de
+ *         parcourir l'arbre pas à pas avec un arbre_binaire_iterateur, sans
+ *         pile ni récursion. L'option ARBRE_BINAIRE_OPTION_AUGMENTE active
+ *         aussi cette option.
+ */
+#define ARBRE_BINAIRE_OPTION_PARENT 0x40
+
+/**
+ *  \brief Les parcours qui lisent l'arbre sans le modifier (nombres
+ *         d'éléments, recherches, sauvegarde) utilisent l'ordre
+ *         ARBRE_BINAIRE_PREFIXE_MORRIS: ils n'ont besoin d'aucune pile, même
+ *         pour un arbre très profond, mais relient temporairement certains
+ *         noeuds et sont environ deux fois plus lents. Cette option est
+ *         ignorée avec ARBRE_BINAIRE_OPTION_CONCURRENT.
+ */
+#define ARBRE_BINAIRE_OPTION_MORRIS 0x80
+
+/**
+ *  \brief Attendre que les données soient réellement écrites sur le disque
+ *         (fsync) avant de terminer la sauvegarde.
+ */
+#define ARBRE_BINAIRE_SAUVEGARDE_SYNCHRONISER 0x01
+
+/**
+ *  \brief Écrire le fichier au format compact (version 2): un entête
+ *         (signature, version, nombre de noeuds, hauteur), les masques des
+ *         enfants sur 2 bits, les valeurs en entiers de longueur variable
+ *         et une somme de contrôle. Le chargement reconnaît les deux
+ *         formats.
+ */
+#define ARBRE_BINAIRE_SAUVEGARDE_COMPACT 0x02
+
+/**
+ *  \brief Résultat des fonctions qui peuvent échouer.
+ */
+typedef enum {
+    ARBRE_BINAIRE_SUCCES = 0,
+    ARBRE_BINAIRE_ERREUR,               /**< Voir erreur_arbre_binaire. */
+    ARBRE_BINAIRE_ERREUR_INEXISTANT     /**< L'arbre est NULL. */
+} arbre_binaire_statut;
+
 /**
  *  \brief Une liste implémenté à l'aide d'un arbre binaire.
  */
 typedef struct arbre_binaire_struct arbre_binaire;
 
+/**
+ *  \brief L'ordre dans lequel les noeuds sont visités par un parcours.
+ */
+typedef enum {
+    ARBRE_BINAIRE_PREFIXE,      /**< Le noeud, puis ses enfants. */
+    ARBRE_BINAIRE_INFIXE,       /**< Le premier enfant, le noeud, le second. */
+    ARBRE_BINAIRE_POSTFIXE,     /**< Les enfants, puis le noeud. */
+    ARBRE_BINAIRE_LARGEUR,      /**< Niveau par niveau. */
+    ARBRE_BINAIRE_PREFIXE_MORRIS,   /**< Préfixe, sans pile (Morris). */
+    ARBRE_BINAIRE_INFIXE_MORRIS     /**< Infixe, sans pile (Morris). */
+} arbre_binaire_ordre;
+
+/**
+ *  \brief Fonction appelée pour chaque noeud visité par un parcours.
+ *
+ *  \param noeud      : Le noeud visité.
+ *  \param profondeur : La profondeur du noeud (1 pour la racine).
+ *  \param donnees    : Les données passées au parcours.
+ *
+ *  \return Faux pour arrêter le parcours.
+ */
+typedef bool (*arbre_binaire_visiteur)(arbre_binaire* noeud, int profondeur,
+                                       void* donnees);
+
+/**
+ *  \brief Informations partagées par tous les noeuds d'un même arbre.
+ */
+typedef struct arbre_binaire_contexte_struct arbre_binaire_contexte;
+
+/**
+ *  \brief Copie immuable d'un arbre binaire rangée en ordre de largeur
+ *         dans des tableaux contigus.
+ */
+typedef struct arbre_binaire_fige_struct arbre_binaire_fige;
+
+/**
+ *  \brief Fonction appelée pour chaque noeud visité par le parcours d'un
+ *         arbre figé.
+ *
+ *  \param valeur     : La valeur du noeud visité.
+ *  \param profondeur : La profondeur du noeud (1 pour la racine).
+ *  \param donnees    : Les données passées au parcours.
+ *
+ *  \return Faux pour arrêter le parcours.
+ */
+typedef bool (*arbre_binaire_visiteur_fige)(int valeur, int profondeur,
+                                            void* donnees);
+
+/**
+ *  \brief Lecture séquentielle d'un fichier d'arbre binaire, noeud par
+ *         noeud, sans construire l'arbre en mémoire.
+ */
+typedef struct arbre_binaire_flux_struct arbre_binaire_flux;
+
+/**
+ *  \brief Arbre dont tous les noeuds sont rangés dans un même tableau. Un
+ *         noeud n'occupe que 12 octets (contre 32 pour un arbre_binaire sur
+ *         une machine 64 bits): sa valeur et les indices (32 bits) de ses
+ *         enfants.
+ */
+typedef struct arbre_binaire_compact_struct arbre_binaire_compact;
+
+/**
+ *  \brief Désigne un noeud d'un arbre compact. Contrairement à un pointeur,
+ *         il reste valide lorsque le tableau des noeuds est agrandi.
+ */
+typedef uint32_t arbre_binaire_noeud_compact;
+
+/**
+ *  \brief Absence de noeud (par exemple, un enfant qui n'existe pas).
+ */
+#define ARBRE_BINAIRE_COMPACT_AUCUN 0
+
+/**
+ *  \brief La racine d'un arbre compact. Elle ne change jamais.
+ */
+#define ARBRE_BINAIRE_COMPACT_RACINE 1
+
+/**
+ *  \brief Fonction appelée pour chaque noeud visité par le parcours d'un
+ *         arbre compact.
+ *
+ *  \param compact    : L'arbre compact parcouru.
+ *  \param noeud      : Le noeud visité.
+ *  \param profondeur : La profondeur du noeud (1 pour la racine).
+ *  \param donnees    : Les données passées au parcours.
+ *
+ *  \return Faux pour arrêter le parcours.
+ */
+typedef bool (*arbre_binaire_visiteur_compact)(arbre_binaire_compact* compact,
+                                        arbre_binaire_noeud_compact noeud,
+                                        int profondeur, void* donnees);
+
+/**
+ *  \brief Position d'un parcours infixe pas à pas d'un arbre créé avec
+ *         ARBRE_BINAIRE_OPTION_PARENT. L'itérateur n'alloue pas de mémoire:
+ *         il peut être placé sur la pile et abandonné à tout moment.
+ *
+ *  \note  Retirer un enfant ou modifier un arbre ordonné ou persistant
+ *         invalide les itérateurs de l'arbre. Un instantané d'un arbre
+ *         persistant ne peut pas être parcouru par un itérateur: ses noeuds
+ *         partagés ont leur parent dans la version courante.
+ */
+typedef struct arbre_binaire_iterateur_struct {
+    struct arbre_binaire_struct * racine;   /**< Le sous-arbre parcouru. */
+    struct arbre_binaire_struct * courant;  /**< NULL hors du parcours. */
+    bool apres_fin;     /**< Si courant est NULL: après le dernier noeud. */
+} arbre_binaire_iterateur;
+
+/**
+ *  \brief Les fonctions dont la durée est mesurée par les statistiques.
+ *         Les noeuds visités hors de ces fonctions sont comptés dans
+ *         ARBRE_BINAIRE_FONCTION_AUTRE.
+ */
+typedef enum {
+    ARBRE_BINAIRE_FONCTION_AUTRE,
+    ARBRE_BINAIRE_FONCTION_CHARGER,
+    ARBRE_BINAIRE_FONCTION_SAUVEGARDER,
+    ARBRE_BINAIRE_FONCTION_DETRUIRE,
+    ARBRE_BINAIRE_FONCTION_CREER_ENFANT,
+    ARBRE_BINAIRE_FONCTION_CONTIENT,
+    ARBRE_BINAIRE_FONCTION_CONTIENT_LOT,
+    ARBRE_BINAIRE_FONCTION_NOMBRE_ELEMENTS,
+    ARBRE_BINAIRE_FONCTION_NOMBRE_FEUILLES,
+    ARBRE_BINAIRE_FONCTION_HAUTEUR,
+    ARBRE_BINAIRE_FONCTION_PARCOURIR,
+    ARBRE_BINAIRE_FONCTION_INSERER,
+    ARBRE_BINAIRE_FONCTION_SUPPRIMER,
+    ARBRE_BINAIRE_FONCTION_CHERCHER,
+    ARBRE_BINAIRE_FONCTION_CLONER,
+    ARBRE_BINAIRE_NOMBRE_FONCTIONS
+} arbre_binaire_fonction;
+
+/**
+ *  \brief Nombre de classes des histogrammes de durée: la classe i compte
+ *         les appels qui ont duré de 2^i à 2^(i+1) - 1 nanosecondes (la
+ *         dernière classe compte aussi les appels plus longs).
+ */
+#define ARBRE_BINAIRE_CLASSES_DUREE 32
+
+/**
+ *  \brief Compteurs d'un fil d'exécution, remplis seulement si la librairie
+ *         a été compilée avec ARBRE_BINAIRE_STATISTIQUES. Lorsqu'une
+ *         fonction mesurée en appelle une autre, les noeuds visités sont
+ *         comptés dans la fonction appelée par le programme.
+ */
+typedef struct {
+    unsigned long long noeuds_alloues;   /**< Noeuds alloués. */
+    unsigned long long noeuds_liberes;   /**< Noeuds libérés. */
+    unsigned long long lectures;         /**< Appels à read (ou mmap). */
+    unsigned long long octets_lus;       /**< Octets lus ou projetés. */
+    unsigned long long ecritures;        /**< Appels à write. */
+    unsigned long long octets_ecrits;    /**< Octets écrits. */
+    unsigned long long pile_maximale;    /**< Plus grand nombre d'éléments
+                                              d'une pile de parcours (la
+                                              profondeur de récursion
+                                              évitée). */
+    unsigned long long appels[ARBRE_BINAIRE_NOMBRE_FONCTIONS];
+    unsigned long long nanosecondes[ARBRE_BINAIRE_NOMBRE_FONCTIONS];
+    unsigned long long noeuds_visites[ARBRE_BINAIRE_NOMBRE_FONCTIONS];
+    unsigned long long durees[ARBRE_BINAIRE_NOMBRE_FONCTIONS]
+                             [ARBRE_BINAIRE_CLASSES_DUREE];
+} arbre_binaire_statistiques;
+
 /**
  * \brief Un arbre binaire.
+ *
+ * L'erreur n'est pas conservée dans chaque noeud, mais une seule fois par
+ * arbre, dans le contexte partagé par tous ses noeuds.
  */
 struct arbre_binaire_struct {
     int valeur;
     struct arbre_binaire_struct * premier_fils;
     struct arbre_binaire_struct * second_fils;
-    bool a_erreur;
-    char* erreur;
+    arbre_binaire_contexte * contexte;
 };
 
 
@@ -69,6 +339,16 @@ struct arbre_binaire_struct {
  */
 arbre_binaire* creer_arbre_binaire(int valeur);
 
+/**
+ *  \brief Alloue un arbre binaire en précisant son mode de fonctionnement.
+ *
+ *  \param valeur  : La valeur de la racine de l'arbre.
+ *  \param options : Combinaison des options ARBRE_BINAIRE_OPTION_*.
+ *
+ *  \return L'arbre binaire avec la valeur de la racine.
+ */
+arbre_binaire* creer_arbre_binaire_options(int valeur, unsigned int options);
+
 /**
  *  \brief Récupère les données d'un fichier pour créer un arbre binaire.
  *
@@ -78,10 +358,95 @@ arbre_binaire* creer_arbre_binaire(int valeur);
  */
 arbre_binaire* charger_arbre_binaire(char *nom_fichier);
 
+/**
+ *  \brief Récupère les données d'un fichier pour créer un arbre binaire
+ *         en précisant son mode de fonctionnement.
+ *
+ *  \param nom_fichier : Le nom du fichier qui contient les données.
+ *  \param options     : Combinaison des options ARBRE_BINAIRE_OPTION_*.
+ *
+ *  \return Un nouvel arbre binaire créé à l'aide des données d'un fichier.
+ *
+ *  \note  Avec ARBRE_BINAIRE_OPTION_ORDONNE ou EQUILIBRE, l'arbre chargé
+ *         est vérifié: s'il n'est pas ordonné (ou pas équilibré), une
+ *         erreur est inscrite dans l'arbre.
+ */
+arbre_binaire* charger_arbre_binaire_options(char *nom_fichier,
+                                             unsigned int options);
+
+/**
+ *  \brief Construit un arbre équilibré dont le parcours infixe donne les
+ *         valeurs dans l'ordre du tableau. Chaque noeud est alloué une
+ *         seule fois, sans passer par creer_*_enfant_arbre_binaire.
+ *
+ *  \param valeurs : Les valeurs, triées en ordre croissant.
+ *  \param nombre  : Le nombre de valeurs.
+ *  \param options : Combinaison des options ARBRE_BINAIRE_OPTION_*.
+ *
+ *  \return Le nouvel arbre, ou NULL s'il n'y a aucune valeur ou plus de
+ *          mémoire.
+ *
+ *  \note  Pour un arbre ordonné, les doublons sont ignorés et des valeurs
+ *         qui ne sont pas triées laissent une erreur dans l'arbre.
+ */
+arbre_binaire* construire_trie_arbre_binaire(const int* valeurs,
+                                             size_t nombre,
+                                             unsigned int options);
+
+/**
+ *  \brief Construit un arbre à partir de ses noeuds en ordre préfixe,
+ *         comme ils sont enregistrés dans un fichier.
+ *
+ *  \param valeurs : Les valeurs des noeuds, en ordre préfixe.
+ *  \param masques : Les enfants de chaque noeud: 1 pour le premier, 2 pour
+ *                   le second, 3 pour les deux et 0 pour une feuille.
+ *  \param nombre  : Le nombre de noeuds.
+ *  \param options : Combinaison des options ARBRE_BINAIRE_OPTION_*.
+ *
+ *  \return Le nouvel arbre, ou NULL s'il n'y a aucun noeud ou plus de
+ *          mémoire. Si les masques ne correspondent pas au nombre de
+ *          noeuds, une erreur est inscrite dans l'arbre.
+ *
+ *  \note  Pour un arbre ordonné, des valeurs qui ne sont pas strictement
+ *         croissantes en ordre infixe (ou, avec l'option EQUILIBRE, un
+ *         arbre qui n'est pas équilibré) laissent une erreur dans l'arbre.
+ */
+arbre_binaire* construire_prefixe_arbre_binaire(const int* valeurs,
+                                                const unsigned char* masques,
+                                                size_t nombre,
+                                                unsigned int options);
+
+/**
+ *  \brief Construit un arbre à partir de ses positions en ordre de
+ *         largeur: les enfants de la position i sont aux positions 2i + 1
+ *         et 2i + 2.
+ *
+ *  \param valeurs   : La valeur de chaque position.
+ *  \param presences : Un bit par position (le bit i % 8 de l'octet i / 8),
+ *                     à 1 si la position contient un noeud.
+ *  \param nombre    : Le nombre de positions.
+ *  \param options   : Combinaison des options ARBRE_BINAIRE_OPTION_*.
+ *
+ *  \return Le nouvel arbre, ou NULL si la racine est absente ou s'il n'y a
+ *          plus de mémoire. Si un noeud présent n'a pas de parent, une
+ *          erreur est inscrite dans l'arbre.
+ *
+ *  \note  Pour un arbre ordonné, des valeurs qui ne sont pas strictement
+ *         croissantes en ordre infixe (ou, avec l'option EQUILIBRE, un
+ *         arbre qui n'est pas équilibré) laissent une erreur dans l'arbre.
+ */
+arbre_binaire* construire_largeur_arbre_binaire(const int* valeurs,
+                                            const unsigned char* presences,
+                                            size_t nombre,
+                                            unsigned int options);
+
 /**
  *  \brief Libère l'espace mémoire d'un arbre binaire.
  *
  *  \param arbre : L'arbre binaire à supprimer.
+ *
+ *  \note  Si l'arbre est la racine, toute la mémoire appartenant à l'arbre
+ *         (incluant les pages de l'arène) est libérée.
  */
 void detruire_arbre_binaire(arbre_binaire* arbre);
 
@@ -90,8 +455,25 @@ void detruire_arbre_binaire(arbre_binaire* arbre);
  *
  *  \param arbre        : L'arbre à enregistrer dans le fichier.
  *  \param nom_fichier  : Le fichier dans lequel sauvergarder les données.
+ *
+ *  \return ARBRE_BINAIRE_SUCCES si le fichier a pu être écrit.
  */
-void sauvegarder_arbre_binaire(arbre_binaire* arbre, char * nom_fichier);
+arbre_binaire_statut sauvegarder_arbre_binaire(arbre_binaire* arbre,
+                                               char * nom_fichier);
+
+/**
+ *  \brief Sauvegarde les données d'un arbre binaire dans un fichier en
+ *         précisant la manière de l'écrire.
+ *
+ *  \param arbre        : L'arbre à enregistrer dans le fichier.
+ *  \param nom_fichier  : Le fichier dans lequel sauvergarder les données.
+ *  \param options      : Combinaison des options ARBRE_BINAIRE_SAUVEGARDE_*.
+ *
+ *  \return ARBRE_BINAIRE_SUCCES si le fichier a pu être écrit.
+ */
+arbre_binaire_statut sauvegarder_arbre_binaire_options(arbre_binaire* arbre,
+                                                       char * nom_fichier,
+                                                       unsigned int options);
 
 /**
  *  \brief Indique le nombre d'éléments que contient l'arbre binaire.
@@ -134,6 +516,9 @@ int element_arbre_binaire(arbre_binaire* arbre);
  *
  *  \param arbre  : L'arbre dans lequel faire la modification.
  *  \param valeur : La nouvelle valeur de la racine.
+ *
+ *  \note  Dans un arbre ordonné, la valeur n'est pas modifiée et une
+ *         erreur est inscrite.
  */
 void modifier_element_arbre_binaire(arbre_binaire* arbre, int valeur);
 
@@ -147,6 +532,49 @@ void modifier_element_arbre_binaire(arbre_binaire* arbre, int valeur);
  */
 bool contient_element_arbre_binaire(arbre_binaire* arbre, int valeur);
 
+/**
+ *  \brief Vérifie quelles valeurs sont dans un arbre binaire. Dans un arbre
+ *         ordonné, les recherches sont entrelacées pour que plusieurs
+ *         noeuds soient lus en même temps; un arbre qui n'est pas ordonné
+ *         n'est parcouru qu'une seule fois pour toutes les valeurs.
+ *
+ *  \param arbre     : L'arbre dans lequel chercher.
+ *  \param valeurs   : Les valeurs à chercher.
+ *  \param nombre    : Le nombre de valeurs à chercher.
+ *  \param resultats : Reçoit un bit par valeur (le bit i % 8 de l'octet
+ *                     i / 8), à 1 si valeurs[i] est présente. Le tableau
+ *                     doit contenir (nombre + 7) / 8 octets.
+ *
+ *  \return Le nombre de valeurs présentes.
+ */
+int contient_elements_arbre_binaire(arbre_binaire* arbre, const int* valeurs,
+                                    int nombre, unsigned char* resultats);
+
+/**
+ *  \brief Visite tous les noeuds de l'arbre binaire dans l'ordre demandé.
+ *         Le parcours utilise une pile (ou une file) explicite et ne
+ *         dépend donc pas de la taille de la pile d'exécution.
+ *
+ *  \param arbre    : L'arbre binaire à parcourir.
+ *  \param ordre    : L'ordre du parcours.
+ *  \param visiteur : La fonction appelée pour chaque noeud.
+ *  \param donnees  : Données passées telles quelles au visiteur.
+ *
+ *  \return Vrai si tous les noeuds ont été visités, Faux si le visiteur a
+ *          arrêté le parcours ou s'il n'y a plus de mémoire (dans ce cas
+ *          une erreur est inscrite dans l'arbre).
+ *
+ *  \note  Les ordres ARBRE_BINAIRE_PREFIXE_MORRIS et
+ *         ARBRE_BINAIRE_INFIXE_MORRIS n'utilisent que quelques variables:
+ *         l'arbre est relié temporairement puis rétabli, même si le
+ *         visiteur arrête le parcours. Le visiteur ne doit alors pas
+ *         modifier l'arbre ni lire les enfants d'un autre noeud que celui
+ *         qu'il reçoit. En mode concurrent, les ordres habituels sont
+ *         utilisés à leur place.
+ */
+bool parcourir_arbre_binaire(arbre_binaire* arbre, arbre_binaire_ordre ordre,
+                             arbre_binaire_visiteur visiteur, void* donnees);
+
 /**
  *  \brief Renvoie le premier sous-arbre enfant de l'arbre binaire, s'l
  *         n'y a pas d'enfant retourne NULL.
@@ -163,11 +591,15 @@ arbre_binaire* premier_enfant_arbre_binaire(arbre_binaire* arbre);
  *
  *  \param arbre  : L'arbre binaire dans lequel créer un premier enfant.
  *  \param valeur : La valeur à placer dans le premier enfant.
+ *
+ *  \return ARBRE_BINAIRE_SUCCES si l'enfant a été ajouté.
  */
-void creer_premier_enfant_arbre_binaire(arbre_binaire* arbre, int valeur);
+arbre_binaire_statut creer_premier_enfant_arbre_binaire(arbre_binaire* arbre,
+                                                   int valeur);
 
 /**
- *  \brief Supprime le premier enfant d'un arbre binaire.
+ *  \brief Supprime le premier enfant d'un arbre binaire. Un arbre ordonné
+ *         reçoit une erreur: utiliser supprimer_element_arbre_binaire.
  *
  *  \param arbre : L'arbre duquel on supprime le premier enfant.
  */
@@ -189,18 +621,60 @@ arbre_binaire* second_enfant_arbre_binaire(arbre_binaire* arbre);
  *
  *  \param arbre  : L'arbre binaire dans lequel créer un second enfant.
  *  \param valeur : La valeur à placer dans le second enfant.
+ *
+ *  \return ARBRE_BINAIRE_SUCCES si l'enfant a été ajouté.
  */
-void creer_second_enfant_arbre_binaire(arbre_binaire* arbre, int valeur);
+arbre_binaire_statut creer_second_enfant_arbre_binaire(arbre_binaire* arbre,
+                                                   int valeur);
 
 /**
- *  \brief Supprime le second enfant d'un arbre binaire.
+ *  \brief Supprime le second enfant d'un arbre binaire. Un arbre ordonné
+ *         reçoit une erreur: utiliser supprimer_element_arbre_binaire.
  *
  *  \param arbre : L'arbre duquel on supprime le second enfant.
  */
 void retirer_second_enfant_arbre_binaire(arbre_binaire* arbre);
 
 /**
- *  \brief Cherche s'il y a une erreur dans l'arbre binaire et retourne
+ *  \brief Place une copie d'un sous-arbre (qui peut appartenir à un autre
+ *         arbre) comme premier enfant de l'arbre binaire. S'il y a un
+ *         premier enfant, ajoute une erreur.
+ *
+ *  \param arbre   : L'arbre binaire qui reçoit la copie.
+ *  \param greffon : Le sous-arbre à copier.
+ *
+ *  \return ARBRE_BINAIRE_SUCCES si la copie a été placée.
+ */
+arbre_binaire_statut greffer_premier_enfant_arbre_binaire(arbre_binaire* arbre,
+                                                     arbre_binaire* greffon);
+
+/**
+ *  \brief Place une copie d'un sous-arbre (qui peut appartenir à un autre
+ *         arbre) comme second enfant de l'arbre binaire. S'il y a un
+ *         second enfant, ajoute une erreur.
+ *
+ *  \param arbre   : L'arbre binaire qui reçoit la copie.
+ *  \param greffon : Le sous-arbre à copier.
+ *
+ *  \return ARBRE_BINAIRE_SUCCES si la copie a été placée.
+ */
+arbre_binaire_statut greffer_second_enfant_arbre_binaire(arbre_binaire* arbre,
+                                                    arbre_binaire* greffon);
+
+/**
+ *  \brief Copie un arbre (ou un sous-arbre) dans un nouvel arbre qui a les
+ *         mêmes options. Un arbre complet qui utilise une arène est copié
+ *         page par page, sans allouer chaque noeud.
+ *
+ *  \param arbre : L'arbre à copier.
+ *
+ *  \return La copie, à libérer par detruire_arbre_binaire, ou NULL en cas
+ *          d'erreur.
+ */
+arbre_binaire* cloner_arbre_binaire(arbre_binaire* arbre);
+
+/**
+ *  \brief Indique s'il y a une erreur dans l'arbre binaire et retourne
  *         la réponse (Vrai/Faux).
  *
  *  \param arbre : l'arbre binaire à vérifier.
@@ -214,18 +688,22 @@ bool a_erreur_arbre_binaire(arbre_binaire* arbre);
  *
  *  \param arbre : L'arbre binaire à vérifier.
  *
- *  \return Le texte de l'erreur.
+ *  \return Le texte de l'erreur (vide s'il n'y a pas d'erreur).
  */
 char* erreur_arbre_binaire(arbre_binaire* arbre);
 
 /**
- *  \brief Place le message d'erreur dans l'arbre binaire et conserve
- *         celle-ci dans la librairie. Mets "a_erreur_arbre_binaire" à Vrai.
+ *  \brief Place le message d'erreur dans le contexte de l'arbre binaire.
+ *         Mets "a_erreur_arbre_binaire" à Vrai.
  *
  *  \param arbre : L'arbre binaire qui a été vérifié.
  *  \param erreur : La description de l'erreur.
+ *
+ *  \return ARBRE_BINAIRE_ERREUR, ou ARBRE_BINAIRE_ERREUR_INEXISTANT si
+ *          l'arbre est NULL.
  */
-void inscrire_erreur_arbre_binaire(arbre_binaire* arbre, const char* erreur);
+arbre_binaire_statut inscrire_erreur_arbre_binaire(arbre_binaire* arbre,
+                                                   const char* erreur);
 
 /**
  *  \brief Retire l'erreur en mettant "a_erreur_arbre_binaire" à Faux.
@@ -234,6 +712,646 @@ void inscrire_erreur_arbre_binaire(arbre_binaire* arbre, const char* erreur);
  */
 void retirer_erreur_arbre_binaire(arbre_binaire* arbre);
 
+/**
+ *  \brief Ajoute une valeur dans un arbre ordonné. Si la valeur est déjà
+ *         présente, l'arbre n'est pas modifié.
+ *
+ *  \param arbre  : L'arbre ordonné dans lequel ajouter la valeur.
+ *  \param valeur : La valeur à ajouter.
+ *
+ *  \return ARBRE_BINAIRE_SUCCES si la valeur est dans l'arbre.
+ */
+arbre_binaire_statut inserer_element_arbre_binaire(arbre_binaire* arbre,
+                                                   int valeur);
+
+/**
+ *  \brief Retire une valeur d'un arbre ordonné.
+ *
+ *  \param arbre  : L'arbre ordonné duquel retirer la valeur.
+ *  \param valeur : La valeur à retirer.
+ *
+ *  \return ARBRE_BINAIRE_SUCCES si la valeur a été retirée.
+ *
+ *  \note  La racine ne peut pas être retirée si elle est le seul élément
+ *         de l'arbre.
+ */
+arbre_binaire_statut supprimer_element_arbre_binaire(arbre_binaire* arbre,
+                                                     int valeur);
+
+/**
+ *  \brief Cherche le noeud qui contient une valeur dans un arbre ordonné.
+ *
+ *  \param arbre  : L'arbre ordonné dans lequel chercher.
+ *  \param valeur : La valeur à chercher.
+ *
+ *  \return Le noeud contenant la valeur ou NULL si elle est absente.
+ */
+arbre_binaire* chercher_element_arbre_binaire(arbre_binaire* arbre,
+                                              int valeur);
+
+/**
+ *  \brief Cherche, dans un arbre ordonné, le noeud ayant la plus petite
+ *         valeur qui est plus grande ou égale à "valeur".
+ *
+ *  \param arbre  : L'arbre ordonné dans lequel chercher.
+ *  \param valeur : La valeur de référence.
+ *
+ *  \return Le noeud trouvé ou NULL si toutes les valeurs sont plus petites.
+ */
+arbre_binaire* borne_inferieure_arbre_binaire(arbre_binaire* arbre, int valeur);
+
+/**
+ *  \brief Cherche, dans un arbre ordonné, le noeud ayant la plus petite
+ *         valeur qui est strictement plus grande que "valeur".
+ *
+ *  \param arbre  : L'arbre ordonné dans lequel chercher.
+ *  \param valeur : La valeur de référence.
+ *
+ *  \return Le noeud trouvé ou NULL si aucune valeur n'est plus grande.
+ */
+arbre_binaire* borne_superieure_arbre_binaire(arbre_binaire* arbre, int valeur);
+
+/**
+ *  \brief Ouvre un fichier d'arbre binaire (format 1 ou compact) pour le
+ *         lire noeud par noeud. La mémoire utilisée ne dépend que de la
+ *         hauteur de l'arbre.
+ *
+ *  \param nom_fichier : Le nom du fichier à lire.
+ *
+ *  \return Le flux (NULL s'il n'y a plus de mémoire). Si le fichier ne
+ *          peut pas être lu, le flux est vide et contient une erreur.
+ */
+arbre_binaire_flux* ouvrir_flux_arbre_binaire(char* nom_fichier);
+
+/**
+ *  \brief Lit le prochain noeud du flux, en ordre préfixe.
+ *
+ *  \param flux       : Le flux à lire.
+ *  \param valeur     : Reçoit la valeur du noeud.
+ *  \param profondeur : Reçoit la profondeur du noeud (1 pour la racine).
+ *  \param masque     : Reçoit les enfants du noeud (1: premier, 2: second,
+ *                      3: les deux).
+ *
+ *  \return Faux à la fin du flux ou en cas d'erreur.
+ */
+bool lire_flux_arbre_binaire(arbre_binaire_flux* flux, int* valeur,
+                             int* profondeur, int* masque);
+
+/**
+ *  \brief Ferme le flux et libère sa mémoire.
+ *
+ *  \param flux : Le flux à fermer.
+ */
+void fermer_flux_arbre_binaire(arbre_binaire_flux* flux);
+
+/**
+ *  \brief Indique s'il y a une erreur dans le flux.
+ *
+ *  \param flux : Le flux à vérifier.
+ *
+ *  \return Vrai s'il y a erreur et Faux en cas inverse.
+ */
+bool a_erreur_flux_arbre_binaire(arbre_binaire_flux* flux);
+
+/**
+ *  \brief Indique le texte de l'erreur qui est dans le flux.
+ *
+ *  \param flux : Le flux à vérifier.
+ *
+ *  \return Le texte de l'erreur (vide s'il n'y a pas d'erreur).
+ */
+char* erreur_flux_arbre_binaire(arbre_binaire_flux* flux);
+
+/**
+ *  \brief Compte les noeuds qui restent dans le flux. Le flux est lu
+ *         jusqu'à la fin.
+ *
+ *  \param flux : Le flux à lire.
+ *
+ *  \return Le nombre de noeuds lus.
+ */
+int nombre_elements_flux_arbre_binaire(arbre_binaire_flux* flux);
+
+/**
+ *  \brief Compte les feuilles qui restent dans le flux. Le flux est lu
+ *         jusqu'à la fin.
+ *
+ *  \param flux : Le flux à lire.
+ *
+ *  \return Le nombre de feuilles lues.
+ */
+int nombre_feuilles_flux_arbre_binaire(arbre_binaire_flux* flux);
+
+/**
+ *  \brief Trouve la plus grande profondeur des noeuds qui restent dans le
+ *         flux. Le flux est lu jusqu'à la fin.
+ *
+ *  \param flux : Le flux à lire.
+ *
+ *  \return La hauteur de l'arbre lorsque le flux vient d'être ouvert.
+ */
+int hauteur_flux_arbre_binaire(arbre_binaire_flux* flux);
+
+/**
+ *  \brief Cherche une valeur dans le flux. La lecture s'arrête au premier
+ *         noeud qui contient la valeur.
+ *
+ *  \param flux   : Le flux à lire.
+ *  \param valeur : La valeur à chercher.
+ *
+ *  \return Vrai si un noeud lu contient la valeur.
+ */
+bool contient_element_flux_arbre_binaire(arbre_binaire_flux* flux,
+                                         int valeur);
+
+/**
+ *  \brief Crée une copie immuable de l'arbre: les valeurs sont rangées en
+ *         ordre de largeur dans un tableau contigu et la présence des
+ *         enfants dans un tableau de bits. Les requêtes sur la copie ne
+ *         suivent aucun pointeur.
+ *
+ *  \param arbre : L'arbre à figer (il n'est pas modifié).
+ *
+ *  \return La copie, ou NULL s'il n'y a plus de mémoire (une erreur est
+ *          alors inscrite dans l'arbre).
+ */
+arbre_binaire_fige* figer_arbre_binaire(arbre_binaire* arbre);
+
+/**
+ *  \brief Recrée un arbre modifiable à partir d'une copie figée. Le nouvel
+ *         arbre a les mêmes options que l'arbre qui a été figé.
+ *
+ *  \param fige : La copie figée.
+ *
+ *  \return Le nouvel arbre, ou NULL s'il n'y a plus de mémoire.
+ */
+arbre_binaire* degeler_arbre_binaire(arbre_binaire_fige* fige);
+
+/**
+ *  \brief Libère la mémoire d'une copie figée.
+ *
+ *  \param fige : La copie à détruire.
+ */
+void detruire_arbre_binaire_fige(arbre_binaire_fige* fige);
+
+/**
+ *  \brief Indique le nombre d'éléments d'une copie figée.
+ *
+ *  \param fige : La copie figée.
+ *
+ *  \return Le nombre d'éléments.
+ */
+int nombre_elements_arbre_binaire_fige(arbre_binaire_fige* fige);
+
+/**
+ *  \brief Indique le nombre de feuilles d'une copie figée.
+ *
+ *  \param fige : La copie figée.
+ *
+ *  \return Le nombre de feuilles.
+ */
+int nombre_feuilles_arbre_binaire_fige(arbre_binaire_fige* fige);
+
+/**
+ *  \brief Indique la hauteur d'une copie figée.
+ *
+ *  \param fige : La copie figée.
+ *
+ *  \return La hauteur.
+ */
+int hauteur_arbre_binaire_fige(arbre_binaire_fige* fige);
+
+/**
+ *  \brief Vérifie si une valeur est dans une copie figée. Si l'arbre figé
+ *         était ordonné, la recherche descend l'arbre, sinon le tableau
+ *         des valeurs est lu d'un bout à l'autre.
+ *
+ *  \param fige   : La copie figée.
+ *  \param valeur : La valeur à chercher.
+ *
+ *  \return Vrai si la valeur est présente.
+ */
+bool contient_element_arbre_binaire_fige(arbre_binaire_fige* fige,
+                                         int valeur);
+
+/**
+ *  \brief Vérifie quelles valeurs sont dans une copie figée. Si l'arbre
+ *         figé n'était pas ordonné, le tableau des valeurs n'est lu qu'une
+ *         seule fois pour toutes les valeurs.
+ *
+ *  \param fige      : La copie figée.
+ *  \param valeurs   : Les valeurs à chercher.
+ *  \param nombre    : Le nombre de valeurs à chercher.
+ *  \param resultats : Reçoit un bit par valeur (le bit i % 8 de l'octet
+ *                     i / 8), à 1 si valeurs[i] est présente. Le tableau
+ *                     doit contenir (nombre + 7) / 8 octets.
+ *
+ *  \return Le nombre de valeurs présentes.
+ */
+int contient_elements_arbre_binaire_fige(arbre_binaire_fige* fige,
+                                         const int* valeurs, int nombre,
+                                         unsigned char* resultats);
+
+/**
+ *  \brief Visite toutes les valeurs d'une copie figée dans l'ordre
+ *         demandé. Les ordres de Morris sont traités comme les ordres
+ *         préfixe et infixe habituels.
+ *
+ *  \param fige     : La copie figée.
+ *  \param ordre    : L'ordre du parcours.
+ *  \param visiteur : La fonction appelée pour chaque noeud.
+ *  \param donnees  : Données passées telles quelles au visiteur.
+ *
+ *  \return Vrai si tous les noeuds ont été visités, Faux si le visiteur a
+ *          arrêté le parcours ou s'il n'y a plus de mémoire.
+ */
+bool parcourir_arbre_binaire_fige(arbre_binaire_fige* fige,
+                                  arbre_binaire_ordre ordre,
+                                  arbre_binaire_visiteur_fige visiteur,
+                                  void* donnees);
+
+/**
+ *  \brief Crée un arbre compact qui ne contient que sa racine.
+ *
+ *  \param valeur : La valeur de la racine.
+ *
+ *  \return Le nouvel arbre, ou NULL s'il n'y a plus de mémoire.
+ */
+arbre_binaire_compact* creer_arbre_binaire_compact(int valeur);
+
+/**
+ *  \brief Copie un arbre dans un arbre compact. Les noeuds sont rangés en
+ *         ordre de largeur. Les options de l'arbre sont conservées pour
+ *         decompacter_arbre_binaire; si l'arbre est ordonné, la recherche
+ *         dans l'arbre compact descend l'arbre et il ne peut pas être
+ *         modifié.
+ *
+ *  \param arbre : L'arbre à copier (il n'est pas modifié).
+ *
+ *  \return La copie, ou NULL s'il n'y a plus de mémoire (une erreur est
+ *          alors inscrite dans l'arbre).
+ */
+arbre_binaire_compact* compacter_arbre_binaire(arbre_binaire* arbre);
+
+/**
+ *  \brief Recrée un arbre de noeuds ordinaires à partir d'un arbre compact.
+ *         Le nouvel arbre a les options de l'arbre qui a été compacté.
+ *
+ *  \param compact : L'arbre compact.
+ *
+ *  \return Le nouvel arbre, ou NULL s'il n'y a plus de mémoire.
+ */
+arbre_binaire* decompacter_arbre_binaire(arbre_binaire_compact* compact);
+
+/**
+ *  \brief Libère la mémoire d'un arbre compact.
+ *
+ *  \param compact : L'arbre à détruire.
+ */
+void detruire_arbre_binaire_compact(arbre_binaire_compact* compact);
+
+/**
+ *  \brief Indique la valeur d'un noeud d'un arbre compact.
+ *
+ *  \param compact : L'arbre compact.
+ *  \param noeud   : Le noeud.
+ *
+ *  \return La valeur du noeud (0 si le noeud n'existe pas).
+ */
+int element_arbre_binaire_compact(arbre_binaire_compact* compact,
+                                  arbre_binaire_noeud_compact noeud);
+
+/**
+ *  \brief Modifie la valeur d'un noeud d'un arbre compact. Si le noeud
+ *         n'existe pas ou si l'arbre est ordonné, ajoute une erreur.
+ *
+ *  \param compact : L'arbre compact.
+ *  \param noeud   : Le noeud à modifier.
+ *  \param valeur  : La nouvelle valeur.
+ */
+void modifier_element_arbre_binaire_compact(arbre_binaire_compact* compact,
+                                            arbre_binaire_noeud_compact noeud,
+                                            int valeur);
+
+/**
+ *  \brief Donne le premier enfant d'un noeud d'un arbre compact.
+ *
+ *  \param compact : L'arbre compact.
+ *  \param noeud   : Le noeud.
+ *
+ *  \return Le premier enfant, ou ARBRE_BINAIRE_COMPACT_AUCUN.
+ */
+arbre_binaire_noeud_compact premier_enfant_arbre_binaire_compact(
+        arbre_binaire_compact* compact, arbre_binaire_noeud_compact noeud);
+
+/**
+ *  \brief Donne le second enfant d'un noeud d'un arbre compact.
+ *
+ *  \param compact : L'arbre compact.
+ *  \param noeud   : Le noeud.
+ *
+ *  \return Le second enfant, ou ARBRE_BINAIRE_COMPACT_AUCUN.
+ */
+arbre_binaire_noeud_compact second_enfant_arbre_binaire_compact(
+        arbre_binaire_compact* compact, arbre_binaire_noeud_compact noeud);
+
+/**
+ *  \brief Ajoute un premier enfant à un noeud d'un arbre compact. S'il y a
+ *         un premier enfant, ajoute une erreur.
+ *
+ *  \param compact : L'arbre compact.
+ *  \param noeud   : Le noeud qui reçoit l'enfant.
+ *  \param valeur  : La valeur de l'enfant.
+ *
+ *  \return ARBRE_BINAIRE_SUCCES si l'enfant a été créé.
+ */
+arbre_binaire_statut creer_premier_enfant_arbre_binaire_compact(
+        arbre_binaire_compact* compact, arbre_binaire_noeud_compact noeud,
+        int valeur);
+
+/**
+ *  \brief Ajoute un second enfant à un noeud d'un arbre compact. S'il y a
+ *         un second enfant, ajoute une erreur.
+ *
+ *  \param compact : L'arbre compact.
+ *  \param noeud   : Le noeud qui reçoit l'enfant.
+ *  \param valeur  : La valeur de l'enfant.
+ *
+ *  \return ARBRE_BINAIRE_SUCCES si l'enfant a été créé.
+ */
+arbre_binaire_statut creer_second_enfant_arbre_binaire_compact(
+        arbre_binaire_compact* compact, arbre_binaire_noeud_compact noeud,
+        int valeur);
+
+/**
+ *  \brief Supprime le premier enfant (et ses descendants) d'un noeud d'un
+ *         arbre compact. Leurs places sont réutilisées par les prochains
+ *         noeuds créés.
+ *
+ *  \param compact : L'arbre compact.
+ *  \param noeud   : Le noeud.
+ */
+void retirer_premier_enfant_arbre_binaire_compact(
+        arbre_binaire_compact* compact, arbre_binaire_noeud_compact noeud);
+
+/**
+ *  \brief Supprime le second enfant (et ses descendants) d'un noeud d'un
+ *         arbre compact. Leurs places sont réutilisées par les prochains
+ *         noeuds créés.
+ *
+ *  \param compact : L'arbre compact.
+ *  \param noeud   : Le noeud.
+ */
+void retirer_second_enfant_arbre_binaire_compact(
+        arbre_binaire_compact* compact, arbre_binaire_noeud_compact noeud);
+
+/**
+ *  \brief Indique le nombre d'éléments d'un arbre compact.
+ *
+ *  \param compact : L'arbre compact.
+ *
+ *  \return Le nombre d'éléments.
+ */
+int nombre_elements_arbre_binaire_compact(arbre_binaire_compact* compact);
+
+/**
+ *  \brief Indique le nombre de feuilles d'un arbre compact. Le tableau des
+ *         noeuds est lu d'un bout à l'autre, sans parcourir l'arbre.
+ *
+ *  \param compact : L'arbre compact.
+ *
+ *  \return Le nombre de feuilles.
+ */
+int nombre_feuilles_arbre_binaire_compact(arbre_binaire_compact* compact);
+
+/**
+ *  \brief Indique la hauteur d'un arbre compact.
+ *
+ *  \param compact : L'arbre compact.
+ *
+ *  \return La hauteur.
+ */
+int hauteur_arbre_binaire_compact(arbre_binaire_compact* compact);
+
+/**
+ *  \brief Vérifie si une valeur est dans un arbre compact. Si l'arbre est
+ *         ordonné, la recherche descend l'arbre, sinon le tableau des
+ *         noeuds est lu d'un bout à l'autre.
+ *
+ *  \param compact : L'arbre compact.
+ *  \param valeur  : La valeur à chercher.
+ *
+ *  \return Vrai si la valeur est présente.
+ */
+bool contient_element_arbre_binaire_compact(arbre_binaire_compact* compact,
+                                            int valeur);
+
+/**
+ *  \brief Visite tous les noeuds d'un arbre compact dans l'ordre demandé.
+ *         Les ordres de Morris sont remplacés par les ordres préfixe et
+ *         infixe. Le visiteur peut modifier les valeurs, mais ne doit ni
+ *         ajouter ni retirer de noeuds.
+ *
+ *  \param compact  : L'arbre compact.
+ *  \param ordre    : L'ordre du parcours.
+ *  \param visiteur : La fonction appelée pour chaque noeud.
+ *  \param donnees  : Données passées telles quelles au visiteur.
+ *
+ *  \return Vrai si tous les noeuds ont été visités, Faux si le visiteur a
+ *          arrêté le parcours ou s'il n'y a plus de mémoire (dans ce cas
+ *          une erreur est inscrite dans l'arbre).
+ */
+bool parcourir_arbre_binaire_compact(arbre_binaire_compact* compact,
+                                     arbre_binaire_ordre ordre,
+                                     arbre_binaire_visiteur_compact visiteur,
+                                     void* donnees);
+
+/**
+ *  \brief Indique s'il y a une erreur dans un arbre compact.
+ *
+ *  \param compact : L'arbre compact.
+ *
+ *  \return Vrai s'il y a une erreur.
+ */
+bool a_erreur_arbre_binaire_compact(arbre_binaire_compact* compact);
+
+/**
+ *  \brief Indique le texte de l'erreur d'un arbre compact.
+ *
+ *  \param compact : L'arbre compact.
+ *
+ *  \return Le texte de l'erreur (vide s'il n'y a pas d'erreur).
+ */
+char* erreur_arbre_binaire_compact(arbre_binaire_compact* compact);
+
+/**
+ *  \brief Indique le nombre d'éléments de l'arbre en le parcourant avec
+ *         plusieurs fils d'exécution. Les petits arbres sont parcourus par
+ *         le fil appelant seulement.
+ *
+ *  \param arbre        : L'arbre à trouver son nombre d'éléments.
+ *  \param travailleurs : Le nombre de fils (0: un par processeur).
+ *
+ *  \return Le nombre d'éléments.
+ */
+int nombre_elements_parallele_arbre_binaire(arbre_binaire* arbre,
+                                            int travailleurs);
+
+/**
+ *  \brief Indique le nombre de feuilles de l'arbre en le parcourant avec
+ *         plusieurs fils d'exécution.
+ *
+ *  \param arbre        : L'arbre à trouver son nombre de feuilles.
+ *  \param travailleurs : Le nombre de fils (0: un par processeur).
+ *
+ *  \return Le nombre de feuilles.
+ */
+int nombre_feuilles_parallele_arbre_binaire(arbre_binaire* arbre,
+                                            int travailleurs);
+
+/**
+ *  \brief Indique la hauteur de l'arbre en le parcourant avec plusieurs
+ *         fils d'exécution.
+ *
+ *  \param arbre        : L'arbre à trouver sa hauteur.
+ *  \param travailleurs : Le nombre de fils (0: un par processeur).
+ *
+ *  \return La hauteur de l'arbre.
+ */
+int hauteur_parallele_arbre_binaire(arbre_binaire* arbre, int travailleurs);
+
+/**
+ *  \brief Vérifie si un élément est dans l'arbre en le parcourant avec
+ *         plusieurs fils d'exécution. Les autres fils s'arrêtent dès qu'un
+ *         fil trouve l'élément.
+ *
+ *  \param arbre        : L'arbre dans lequel chercher.
+ *  \param valeur       : L'élément à chercher.
+ *  \param travailleurs : Le nombre de fils (0: un par processeur).
+ *
+ *  \return Vrai si l'élément est présent.
+ */
+bool contient_element_parallele_arbre_binaire(arbre_binaire* arbre,
+                                              int valeur, int travailleurs);
+
+/**
+ *  \brief Commence une lecture d'un arbre en mode concurrent. Les noeuds
+ *         obtenus pendant la lecture (par exemple à l'aide de
+ *         premier_enfant_arbre_binaire) restent valides jusqu'à
+ *         sortir_lecture_arbre_binaire, même si un autre fil les retire.
+ *         Les fonctions qui parcourent l'arbre le font d'elles-mêmes.
+ *
+ *  \param arbre : L'arbre à lire.
+ *
+ *  \return Le jeton à passer à sortir_lecture_arbre_binaire.
+ *
+ *  \note  Un fil ne doit pas retirer d'enfant pendant sa propre lecture:
+ *         il pourrait attendre qu'elle se termine.
+ */
+int entrer_lecture_arbre_binaire(arbre_binaire* arbre);
+
+/**
+ *  \brief Termine une lecture commencée par entrer_lecture_arbre_binaire.
+ *
+ *  \param arbre : L'arbre lu.
+ *  \param jeton : Le jeton reçu au début de la lecture.
+ */
+void sortir_lecture_arbre_binaire(arbre_binaire* arbre, int jeton);
+
+/**
+ *  \brief Prend un instantané d'un arbre créé avec
+ *         ARBRE_BINAIRE_OPTION_PERSISTANT, en temps constant. L'instantané
+ *         ne change plus lorsque l'arbre est modifié et ne peut pas être
+ *         modifié lui-même. Il doit être libéré par detruire_arbre_binaire.
+ *
+ *  \param arbre : L'arbre (ou le sous-arbre) à copier.
+ *
+ *  \return L'instantané, ou NULL en cas d'erreur.
+ */
+arbre_binaire* instantane_arbre_binaire(arbre_binaire* arbre);
+
+/**
+ *  \brief Place un itérateur sur le premier noeud (en ordre infixe) d'un
+ *         arbre créé avec ARBRE_BINAIRE_OPTION_PARENT.
+ *
+ *  \param iterateur : L'itérateur à placer.
+ *  \param arbre     : L'arbre (ou le sous-arbre) à parcourir.
+ *
+ *  \return Le premier noeud, ou NULL en cas d'erreur.
+ */
+arbre_binaire* commencer_iterateur_arbre_binaire(
+        arbre_binaire_iterateur* iterateur, arbre_binaire* arbre);
+
+/**
+ *  \brief Place un itérateur sur le dernier noeud (en ordre infixe) d'un
+ *         arbre créé avec ARBRE_BINAIRE_OPTION_PARENT.
+ *
+ *  \param iterateur : L'itérateur à placer.
+ *  \param arbre     : L'arbre (ou le sous-arbre) à parcourir.
+ *
+ *  \return Le dernier noeud, ou NULL en cas d'erreur.
+ */
+arbre_binaire* finir_iterateur_arbre_binaire(
+        arbre_binaire_iterateur* iterateur, arbre_binaire* arbre);
+
+/**
+ *  \brief Place un itérateur, dans un arbre ordonné créé avec
+ *         ARBRE_BINAIRE_OPTION_PARENT, sur le noeud ayant la plus petite
+ *         valeur qui est plus grande ou égale à "valeur".
+ *
+ *  \param iterateur : L'itérateur à placer.
+ *  \param arbre     : L'arbre (ou le sous-arbre) à parcourir.
+ *  \param valeur    : La valeur de référence.
+ *
+ *  \return Le noeud trouvé, ou NULL si toutes les valeurs sont plus petites
+ *          (l'itérateur est alors après le dernier noeud) ou en cas
+ *          d'erreur.
+ */
+arbre_binaire* chercher_iterateur_arbre_binaire(
+        arbre_binaire_iterateur* iterateur, arbre_binaire* arbre, int valeur);
+
+/**
+ *  \brief Avance un itérateur au noeud suivant, en temps constant amorti.
+ *         Après le dernier noeud, l'itérateur ne donne plus que NULL;
+ *         avant le premier, il donne le premier noeud.
+ *
+ *  \param iterateur : L'itérateur à avancer.
+ *
+ *  \return Le noeud suivant, ou NULL à la fin du parcours.
+ */
+arbre_binaire* suivant_iterateur_arbre_binaire(
+        arbre_binaire_iterateur* iterateur);
+
+/**
+ *  \brief Recule un itérateur au noeud précédent, en temps constant amorti.
+ *         Avant le premier noeud, l'itérateur ne donne plus que NULL;
+ *         après le dernier, il donne le dernier noeud.
+ *
+ *  \param iterateur : L'itérateur à reculer.
+ *
+ *  \return Le noeud précédent, ou NULL au début du parcours.
+ */
+arbre_binaire* precedent_iterateur_arbre_binaire(
+        arbre_binaire_iterateur* iterateur);
+
+/**
+ *  \brief Copie les statistiques du fil d'exécution appelant. Les fils
+ *         créés par les fonctions *_parallele_arbre_binaire ont leurs
+ *         propres compteurs, qui ne sont pas repris.
+ *
+ *  \param statistiques : Reçoit les compteurs (mis à zéro si la librairie
+ *                        a été compilée sans ARBRE_BINAIRE_STATISTIQUES).
+ *
+ *  \return Faux si la librairie a été compilée sans statistiques.
+ */
+bool lire_statistiques_arbre_binaire(arbre_binaire_statistiques*
+                                     statistiques);
+
+/**
+ *  \brief Remet à zéro les statistiques du fil d'exécution appelant.
+ */
+void remettre_statistiques_arbre_binaire(void);
+
 #endif // ARBRE_BINAIRE_H_INCLUDED
 
 /* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,342 @@
+/*
+
+    Copyright (c) 2015 Nicolas Bisson
+
+    L'autorisation est accordée, gracieusement, à toute personne acquérant une
+    copie de cette bibliothèque et des fichiers de documentation associés
+    (la "Bibliothèque"), de commercialiser la Bibliothèque sans restriction,
+    notamment les droits d'utiliser, de copier, de modifier, de fusionner, de
+    publier, de distribuer, de sous-licencier et / ou de vendre des copies de
+    la Bibliothèque, ainsi que d'autoriser les personnes auxquelles la
+    Bibliothèque est fournie à le faire, sous réserve des conditions suivantes:
+
+    La déclaration de copyright ci-dessus et la présente autorisation doivent
+    être incluses dans toutes copies ou parties substantielles de la
+    Bibliothèque.
+
+    LA BIBLIOTHÈQUE EST FOURNIE "TELLE QUELLE", SANS GARANTIE D'AUCUNE SORTE,
+    EXPLICITE OU IMPLICITE, NOTAMMENT SANS GARANTIE DE QUALITÉ MARCHANDE,
+    D’ADÉQUATION À UN USAGE PARTICULIER ET D'ABSENCE DE CONTREFAÇON. EN AUCUN
+    CAS, LES AUTEURS OU TITULAIRES DU DROIT D'AUTEUR NE SERONT RESPONSABLES DE
+    TOUT DOMMAGE, RÉCLAMATION OU AUTRE RESPONSABILITÉ, QUE CE SOIT DANS LE
+    CADRE D'UN CONTRAT, D'UN DÉLIT OU AUTRE, EN PROVENANCE DE, CONSÉCUTIF À OU
+    EN RELATION AVEC LA BIBLIOTHÈQUE OU SON UTILISATION, OU AVEC D'AUTRES
+    ÉLÉMENTS DE LA BIBLIOTHÈQUE.
+
+*/
+
+/**
+ *  \file arbre_binaire_arene.c
+ *
+ *  Allocateur par pages des noeuds d'un arbre binaire. Les noeuds sont
+ *  pris les uns à la suite des autres dans de grands blocs contigus et
+ *  les noeuds retirés sont conservés dans une liste de noeuds libres.
+ *  Détruire l'arbre ne demande que de libérer les pages.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "arbre_binaire_interne.h"
+
+/**
+ *  \brief Taille de l'entête d'une page, arrondie pour que les noeuds
+ *         qui suivent soient correctement alignés.
+ */
+#define ARENE_TAILLE_ENTETE ((sizeof(struct arbre_binaire_page) + 15) & ~(size_t)15)
+
+/**
+ *  \brief Prépare une arène vide.
+ *
+ *  \param arene       : L'arène à initialiser.
+ *  \param taille_noeud : La taille en octets d'un noeud de l'arène.
+ */
+void initialiser_arene(struct arbre_binaire_arene* arene, size_t taille_noeud)
+{
+    if (taille_noeud < sizeof(void*)) {
+        taille_noeud = sizeof(void*);
+    }
+    arene->taille_noeud = (taille_noeud + sizeof(void*) - 1) &
+                          ~(sizeof(void*) - 1);
+    arene->taille_page = ARENE_PAGE_MINIMUM;
+    arene->pages = NULL;
+    arene->courant = NULL;
+    arene->fin = NULL;
+    arene->libres = NULL;
+}
+
+/**
+ *  \brief Ajoute une nouvelle page d'au moins "nombre" noeuds à l'arène.
+ *
+ *  \param arene  : L'arène à agrandir.
+ *  \param nombre : Le nombre de noeuds de la page.
+ *
+ *  \return Vrai si la page a pu être allouée.
+ */
+static bool ajouter_page_arene(struct arbre_binaire_arene* arene, size_t nombre)
+{
+    struct arbre_binaire_page* page;
+    bool reussi = false;
+
+    page = malloc(ARENE_TAILLE_ENTETE + nombre * arene->taille_noeud);
+    if (page) {
+        if (arene->pages) {
+            arene->pages->fin = arene->courant;
+        }
+        page->nombre_noeuds = nombre;
+        page->debut = (char*)page + ARENE_TAILLE_ENTETE;
+        page->fin = page->debut + nombre * arene->taille_noeud;
+        page->suivante = arene->pages;
+        arene->pages = page;
+        arene->courant = page->debut;
+        arene->fin = page->debut + nombre * arene->taille_noeud;
+        reussi = true;
+    }
+    return reussi;
+}
+
+/**
+ *  \brief Réserve un noeud (mis à zéro) dans l'arène.
+ *
+ *  \param arene : L'arène dans laquelle allouer le noeud.
+ *
+ *  \return Le noeud alloué ou NULL s'il n'y a plus de mémoire.
+ */
+void* allouer_arene(struct arbre_binaire_arene* arene)
+{
+    void* noeud = NULL;
+
+    if (arene->libres) {
+        noeud = arene->libres;
+        arene->libres = *(void**)noeud;
+    } else {
+        if (arene->courant == arene->fin) {
+            if (ajouter_page_arene(arene, arene->taille_page) &&
+                arene->taille_page < ARENE_PAGE_MAXIMUM) {
+                arene->taille_page = arene->taille_page * 2;
+            }
+        }
+        if (arene->courant != arene->fin) {
+            noeud = arene->courant;
+            arene->courant = arene->courant + arene->taille_noeud;
+        }
+    }
+    if (noeud) {
+        memset(noeud, 0, arene->taille_noeud);
+    }
+    return noeud;
+}
+
+/**
+ *  \brief Remet un noeud dans la liste des noeuds libres de l'arène.
+ *
+ *  \param arene : L'arène qui contient le noeud.
+ *  \param noeud : Le noeud à libérer.
+ */
+void liberer_arene(struct arbre_binaire_arene* arene, void* noeud)
+{
+    *(void**)noeud = arene->libres;
+    arene->libres = noeud;
+}
+
+/**
+ *  \brief S'assure que les prochaines allocations de "nombre" noeuds se
+ *         feront dans une seule page contiguë.
+ *
+ *  \param arene  : L'arène à préparer.
+ *  \param nombre : Le nombre de noeuds qui seront alloués.
+ *
+ *  \return Vrai si l'espace a pu être réservé.
+ */
+bool reserver_arene(struct arbre_binaire_arene* arene, size_t nombre)
+{
+    bool reussi = true;
+    size_t disponible;
+
+    disponible = (arene->fin - arene->courant) / arene->taille_noeud;
+    if (disponible < nombre) {
+        reussi = ajouter_page_arene(arene, nombre);
+    }
+    return reussi;
+}
+
+/**
+ *  \brief Libère toutes les pages de l'arène.
+ *
+ *  \param arene : L'arène à vider.
+ */
+void vider_arene(struct arbre_binaire_arene* arene)
+{
+    struct arbre_binaire_page* page;
+    struct arbre_binaire_page* suivante;
+
+    page = arene->pages;
+    while (page) {
+        suivante = page->suivante;
+        free(page);
+        page = suivante;
+    }
+    initialiser_arene(arene, arene->taille_noeud);
+}
+
+/**
+ *  \brief Indique où se terminent les noeuds utilisés d'une page.
+ *
+ *  \param arene : L'arène qui contient la page.
+ *  \param page  : La page.
+ *
+ *  \return L'adresse qui suit le dernier noeud utilisé de la page.
+ */
+char* fin_page_arene(const struct arbre_binaire_arene* arene,
+                     const struct arbre_binaire_page* page)
+{
+    char* fin = page->fin;
+
+    if (page == arene->pages) {
+        fin = arene->courant;
+    }
+    return fin;
+}
+
+/**
+ *  \brief Compare deux pages copiées selon leur adresse (pour qsort).
+ */
+static int comparer_pages(const void* a, const void* b)
+{
+    const struct arbre_binaire_page_copiee* premiere = a;
+    const struct arbre_binaire_page_copiee* seconde = b;
+
+    return (premiere->debut > seconde->debut) -
+           (premiere->debut < seconde->debut);
+}
+
+/**
+ *  \brief Copie les pages d'une arène dans une arène vide. Seuls les noeuds
+ *         utilisés sont copiés, chaque page d'un seul bloc; la page
+ *         courante garde sa place libre pour les prochaines allocations.
+ *         Les noeuds sont copiés tels quels: leurs liens doivent ensuite
+ *         être déplacés à l'aide de deplacer_arene. La liste des noeuds
+ *         libres est déjà déplacée.
+ *
+ *  \param copie       : L'arène vide (de même taille de noeud).
+ *  \param source      : L'arène à copier.
+ *  \param deplacement : Reçoit la correspondance entre les pages, à
+ *                       libérer par liberer_deplacement_arene.
+ *
+ *  \return Faux s'il n'y a plus de mémoire (l'arène copie reste vide).
+ */
+bool copier_arene(struct arbre_binaire_arene* copie,
+                  const struct arbre_binaire_arene* source,
+                  struct arbre_binaire_deplacement* deplacement)
+{
+    struct arbre_binaire_page* page;
+    struct arbre_binaire_page* nouvelle;
+    struct arbre_binaire_page** derniere = &copie->pages;
+    struct arbre_binaire_page_copiee* copiee;
+    size_t nombre = 0;
+    size_t utilises;
+    void** libre;
+    bool reussi;
+
+    for (page = source->pages; page; page = page->suivante) {
+        nombre = nombre + 1;
+    }
+    deplacement->pages = malloc(nombre * sizeof(*deplacement->pages));
+    deplacement->nombre = 0;
+    deplacement->dernier = 0;
+    reussi = deplacement->pages != NULL || nombre == 0;
+    for (page = source->pages; page && reussi; page = page->suivante) {
+        utilises = fin_page_arene(source, page) - page->debut;
+        if (page == source->pages) {
+            nombre = page->nombre_noeuds;
+        } else {
+            nombre = utilises / source->taille_noeud;
+        }
+        nouvelle = malloc(ARENE_TAILLE_ENTETE + nombre * source->taille_noeud);
+        reussi = nouvelle != NULL;
+        if (reussi) {
+            nouvelle->nombre_noeuds = nombre;
+            nouvelle->debut = (char*)nouvelle + ARENE_TAILLE_ENTETE;
+            nouvelle->fin = nouvelle->debut + (page->fin - page->debut);
+            nouvelle->suivante = NULL;
+            memcpy(nouvelle->debut, page->debut, utilises);
+            *derniere = nouvelle;
+            derniere = &nouvelle->suivante;
+            copiee = &deplacement->pages[deplacement->nombre];
+            copiee->debut = page->debut;
+            copiee->fin = page->debut + utilises;
+            copiee->copie = nouvelle->debut;
+            deplacement->nombre = deplacement->nombre + 1;
+        }
+    }
+    if (reussi && copie->pages) {
+        qsort(deplacement->pages, deplacement->nombre,
+              sizeof(*deplacement->pages), comparer_pages);
+        copie->taille_page = source->taille_page;
+        copie->courant = copie->pages->debut +
+                         (source->courant - source->pages->debut);
+        copie->fin = copie->pages->debut +
+                     (source->fin - source->pages->debut);
+        copie->libres = deplacer_arene(deplacement, source->libres);
+        for (libre = copie->libres; libre; libre = *libre) {
+            *libre = deplacer_arene(deplacement, *libre);
+        }
+    } else if (reussi == false) {
+        vider_arene(copie);
+        liberer_deplacement_arene(deplacement);
+    }
+    return reussi;
+}
+
+/**
+ *  \brief Donne l'adresse, dans la copie, d'une adresse de l'arène copiée.
+ *         La page de l'adresse précédente est essayée en premier: les
+ *         enfants d'un noeud sont souvent dans la même page que lui.
+ *
+ *  \param deplacement : La correspondance donnée par copier_arene.
+ *  \param adresse     : Une adresse de l'arène copiée, ou NULL.
+ *
+ *  \return L'adresse correspondante dans la copie, ou NULL.
+ */
+void* deplacer_arene(struct arbre_binaire_deplacement* deplacement,
+                     const void* adresse)
+{
+    const char* octet = adresse;
+    struct arbre_binaire_page_copiee* page;
+    void* resultat = NULL;
+    size_t bas;
+    size_t haut;
+    size_t milieu;
+
+    if (octet) {
+        page = &deplacement->pages[deplacement->dernier];
+        if (octet < page->debut || octet >= page->fin) {
+            bas = 0;
+            haut = deplacement->nombre;
+            while (haut - bas > 1) {
+                milieu = (bas + haut) / 2;
+                if (octet < deplacement->pages[milieu].debut) {
+                    haut = milieu;
+                } else {
+                    bas = milieu;
+                }
+            }
+            deplacement->dernier = bas;
+            page = &deplacement->pages[bas];
+        }
+        resultat = page->copie + (octet - page->debut);
+    }
+    return resultat;
+}
+
+/**
+ *  \brief Libère la correspondance donnée par copier_arene.
+ *
+ *  \param deplacement : La correspondance.
+ */
+void liberer_deplacement_arene(struct arbre_binaire_deplacement* deplacement)
+{
+    free(deplacement->pages);
+    deplacement->pages = NULL;
+    deplacement->nombre = 0;
+}
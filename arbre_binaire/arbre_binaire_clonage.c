@@ -0,0 +1,256 @@
+/*
+
+    Copyright (c) 2015 Nicolas Bisson
+
+    L'autorisation est accordée, gracieusement, à toute personne acquérant une
+    copie de cette bibliothèque et des fichiers de documentation associés
+    (la "Bibliothèque"), de commercialiser la Bibliothèque sans restriction,
+    notamment les droits d'utiliser, de copier, de modifier, de fusionner, de
+    publier, de distribuer, de sous-licencier et / ou de vendre des copies de
+    la Bibliothèque, ainsi que d'autoriser les personnes auxquelles la
+    Bibliothèque est fournie à le faire, sous réserve des conditions suivantes:
+
+    La déclaration de copyright ci-dessus et la présente autorisation doivent
+    être incluses dans toutes copies ou parties substantielles de la
+    Bibliothèque.
+
+    LA BIBLIOTHÈQUE EST FOURNIE "TELLE QUELLE", SANS GARANTIE D'AUCUNE SORTE,
+    EXPLICITE OU IMPLICITE, NOTAMMENT SANS GARANTIE DE QUALITÉ MARCHANDE,
+    D’ADÉQUATION À UN USAGE PARTICULIER ET D'ABSENCE DE CONTREFAÇON. EN AUCUN
+    CAS, LES AUTEURS OU TITULAIRES DU DROIT D'AUTEUR NE SERONT RESPONSABLES DE
+    TOUT DOMMAGE, RÉCLAMATION OU AUTRE RESPONSABILITÉ, QUE CE SOIT DANS LE
+    CADRE D'UN CONTRAT, D'UN DÉLIT OU AUTRE, EN PROVENANCE DE, CONSÉCUTIF À OU
+    EN RELATION AVEC LA BIBLIOTHÈQUE OU SON UTILISATION, OU AVEC D'AUTRES
+    ÉLÉMENTS DE LA BIBLIOTHÈQUE.
+
+*/
+
+/**
+ *  \file arbre_binaire_clonage.c
+ *
+ *  Copie d'un arbre ou d'un sous-arbre. Un arbre complet qui utilise une
+ *  arène est copié page par page: chaque page est copiée d'un seul bloc,
+ *  puis les liens de chaque noeud sont déplacés vers les pages copiées en
+ *  parcourant les pages dans l'ordre de la mémoire. Les autres copies sont
+ *  faites noeud par noeud, sans récursion: les noeuds copiés pointent
+ *  d'abord vers les enfants d'origine, qui sont copiés à leur tour.
+ *
+ */
+
+#include <stdlib.h>
+#include "arbre_binaire.h"
+#include "arbre_binaire_interne.h"
+
+/**
+ *  \brief Remplit une copie à partir d'un noeud d'origine. Les liens vers
+ *         les enfants pointent encore vers les enfants d'origine.
+ *
+ *  \param copie  : Le noeud copié.
+ *  \param source : Le noeud d'origine.
+ */
+static void remplir_copie(arbre_binaire* copie, arbre_binaire* source)
+{
+    copie->valeur = LIRE_VALEUR(source);
+    copie->premier_fils = LIRE_FILS(source, premier_fils);
+    copie->second_fils = LIRE_FILS(source, second_fils);
+    if (copie->contexte->options & source->contexte->options &
+        ARBRE_BINAIRE_OPTION_AUGMENTE) {
+        NOEUD_ETENDU(copie)->taille = NOEUD_ETENDU(source)->taille;
+        NOEUD_ETENDU(copie)->feuilles = NOEUD_ETENDU(source)->feuilles;
+        NOEUD_ETENDU(copie)->hauteur = NOEUD_ETENDU(source)->hauteur;
+    }
+}
+
+/**
+ *  \brief Copie un enfant d'origine sous un noeud copié.
+ *
+ *  \param pile    : Les noeuds copiés dont les enfants restent à copier.
+ *  \param parent  : Le noeud copié.
+ *  \param source  : L'enfant d'origine (peut être NULL).
+ *  \param memoire : Devient faux s'il n'y a plus de mémoire; les enfants
+ *                   ne sont alors plus copiés.
+ *
+ *  \return L'enfant copié, ou NULL.
+ */
+static arbre_binaire* copier_enfant(struct arbre_binaire_pile* pile,
+                                    arbre_binaire* parent,
+                                    arbre_binaire* source, bool* memoire)
+{
+    arbre_binaire* enfant = NULL;
+
+    if (source && *memoire) {
+        enfant = allouer_noeud_arbre_binaire(parent->contexte, 0);
+        *memoire = enfant != NULL;
+    }
+    if (enfant) {
+        remplir_copie(enfant, source);
+        if (parent->contexte->options & ARBRE_BINAIRE_OPTION_PARENT) {
+            NOEUD_PARENT(enfant)->parent = parent;
+        }
+        *memoire = empiler_pile(pile, enfant, 0, 0);
+        if (*memoire == false) {
+            enfant->premier_fils = NULL;
+            enfant->second_fils = NULL;
+        }
+    }
+    return enfant;
+}
+
+/**
+ *  \brief Copie un sous-arbre, noeud par noeud, sous un noeud déjà alloué
+ *         (qui peut appartenir à un autre arbre). Les parents et les
+ *         informations étendues du noeud et de ses copies sont remplis
+ *         selon les options de son arbre.
+ *
+ *  \param copie  : Le noeud qui reçoit la copie de la racine du sous-arbre.
+ *  \param source : Le sous-arbre à copier.
+ *
+ *  \return Faux s'il n'y a plus de mémoire. La copie est alors incomplète,
+ *          mais ses liens sont valides: elle peut être libérée.
+ */
+bool copier_sous_arbre_binaire(arbre_binaire* copie, arbre_binaire* source)
+{
+    struct arbre_binaire_pile pile;
+    struct arbre_binaire_element_pile element;
+    arbre_binaire_contexte* contexte = source->contexte;
+    arbre_binaire* racine = copie;
+    bool memoire;
+    int jeton;
+
+    jeton = entrer_lecture_contexte_arbre_binaire(contexte);
+    initialiser_pile(&pile);
+    remplir_copie(copie, source);
+    memoire = empiler_pile(&pile, copie, 0, 0);
+    while (depiler_pile(&pile, &element)) {
+        copie = element.noeud;
+        copie->premier_fils = copier_enfant(&pile, copie, copie->premier_fils,
+                                            &memoire);
+        copie->second_fils = copier_enfant(&pile, copie, copie->second_fils,
+                                           &memoire);
+    }
+    vider_pile(&pile);
+    sortir_lecture_contexte_arbre_binaire(contexte, jeton);
+    if (memoire && racine->contexte->options & ARBRE_BINAIRE_OPTION_AUGMENTE &&
+        (contexte->options & ARBRE_BINAIRE_OPTION_AUGMENTE) == 0) {
+        memoire = recalculer_sous_arbre_binaire(racine);
+    }
+    return memoire;
+}
+
+/**
+ *  \brief Fait pointer les liens d'un noeud copié avec son arène vers les
+ *         noeuds copiés.
+ *
+ *  \param noeud       : Le noeud copié.
+ *  \param contexte    : Le contexte de la copie.
+ *  \param deplacement : La correspondance entre les pages.
+ */
+static void deplacer_noeud(arbre_binaire* noeud,
+                           arbre_binaire_contexte* contexte,
+                           struct arbre_binaire_deplacement* deplacement)
+{
+    noeud->contexte = contexte;
+    noeud->premier_fils = deplacer_arene(deplacement, noeud->premier_fils);
+    noeud->second_fils = deplacer_arene(deplacement, noeud->second_fils);
+    if (contexte->options & ARBRE_BINAIRE_OPTION_PARENT) {
+        NOEUD_PARENT(noeud)->parent = deplacer_arene(deplacement,
+                                                NOEUD_PARENT(noeud)->parent);
+    }
+}
+
+/**
+ *  \brief Copie un arbre complet qui utilise une arène, page par page.
+ *
+ *  \param arbre : La racine de l'arbre.
+ *
+ *  \return La racine de la copie, ou NULL s'il n'y a plus de mémoire.
+ */
+static arbre_binaire* cloner_arene(arbre_binaire* arbre)
+{
+    struct arbre_binaire_deplacement deplacement;
+    struct arbre_binaire_page* page;
+    arbre_binaire_contexte* contexte;
+    arbre_binaire* clone = NULL;
+    arbre_binaire* noeud;
+    char* octet;
+    char* fin;
+    void** libre;
+
+    contexte = calloc(1, sizeof(arbre_binaire_contexte));
+    if (contexte) {
+        contexte->options = arbre->contexte->options;
+        contexte->taille_noeud = arbre->contexte->taille_noeud;
+        contexte->versions = 1;
+        initialiser_arene(&contexte->arene, contexte->taille_noeud);
+        if (copier_arene(&contexte->arene, &arbre->contexte->arene,
+                         &deplacement)) {
+            /* Les noeuds libres sont marqués pour être sautés. */
+            for (libre = contexte->arene.libres; libre; libre = *libre) {
+                ((arbre_binaire*)libre)->contexte = NULL;
+            }
+            for (page = contexte->arene.pages; page; page = page->suivante) {
+                fin = fin_page_arene(&contexte->arene, page);
+                for (octet = page->debut; octet < fin;
+                     octet = octet + contexte->arene.taille_noeud) {
+                    noeud = (arbre_binaire*)octet;
+                    if (noeud->contexte) {
+                        deplacer_noeud(noeud, contexte, &deplacement);
+                    }
+                }
+            }
+            clone = deplacer_arene(&deplacement, arbre);
+            contexte->racine = clone;
+            STATISTIQUE_AJOUTER(noeuds_alloues,
+                                compter_noeuds_arene(&contexte->arene));
+            liberer_deplacement_arene(&deplacement);
+        } else {
+            free(contexte);
+        }
+    }
+    return clone;
+}
+
+/**
+ *  \brief Copie un arbre (ou un sous-arbre) dans un nouvel arbre qui a les
+ *         mêmes options. Un arbre complet qui utilise une arène est copié
+ *         page par page, sans allouer chaque noeud.
+ *
+ *  \param arbre : L'arbre à copier.
+ *
+ *  \return La copie, à libérer par detruire_arbre_binaire, ou NULL en cas
+ *          d'erreur.
+ */
+arbre_binaire* cloner_arbre_binaire(arbre_binaire* arbre)
+{
+    arbre_binaire* clone = NULL;
+    unsigned int options;
+
+    retirer_erreur_arbre_binaire(arbre);
+    if (arbre == NULL) {
+        return NULL;
+    }
+    STATISTIQUE_DEBUT(ARBRE_BINAIRE_FONCTION_CLONER);
+    options = arbre->contexte->options;
+    if (options & ARBRE_BINAIRE_OPTION_ARENE &&
+        (options & (ARBRE_BINAIRE_OPTION_PERSISTANT |
+                    ARBRE_BINAIRE_OPTION_CONCURRENT)) == 0 &&
+        arbre == arbre->contexte->racine) {
+        clone = cloner_arene(arbre);
+    } else {
+        clone = creer_arbre_binaire_options(0, options);
+        if (clone && options & ARBRE_BINAIRE_OPTION_ARENE &&
+            options & ARBRE_BINAIRE_OPTION_AUGMENTE) {
+            reserver_arene(&clone->contexte->arene,
+                           NOEUD_ETENDU(arbre)->taille - 1);
+        }
+        if (clone && !copier_sous_arbre_binaire(clone, arbre)) {
+            detruire_arbre_binaire(clone);
+            clone = NULL;
+        }
+    }
+    if (clone == NULL) {
+        inscrire_erreur_arbre_binaire(arbre, "Il n'y a plus de memoire.");
+    }
+    STATISTIQUE_FIN();
+    return clone;
+}
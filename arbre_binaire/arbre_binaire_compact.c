@@ -0,0 +1,923 @@
+/*
+
+    Copyright (c) 2015 Nicolas Bisson
+
+    L'autorisation est accordée, gracieusement, à toute personne acquérant une
+    copie de cette bibliothèque et des fichiers de documentation associés
+    (la "Bibliothèque"), de commercialiser la Bibliothèque sans restriction,
+    notamment les droits d'utiliser, de copier, de modifier, de fusionner, de
+    publier, de distribuer, de sous-licencier et / ou de vendre des copies de
+    la Bibliothèque, ainsi que d'autoriser les personnes auxquelles la
+    Bibliothèque est fournie à le faire, sous réserve des conditions suivantes:
+
+    La déclaration de copyright ci-dessus et la présente autorisation doivent
+    être incluses dans toutes copies ou parties substantielles de la
+    Bibliothèque.
+
+    LA BIBLIOTHÈQUE EST FOURNIE "TELLE QUELLE", SANS GARANTIE D'AUCUNE SORTE,
+    EXPLICITE OU IMPLICITE, NOTAMMENT SANS GARANTIE DE QUALITÉ MARCHANDE,
+    D’ADÉQUATION À UN USAGE PARTICULIER ET D'ABSENCE DE CONTREFAÇON. EN AUCUN
+    CAS, LES AUTEURS OU TITULAIRES DU DROIT D'AUTEUR NE SERONT RESPONSABLES DE
+    TOUT DOMMAGE, RÉCLAMATION OU AUTRE RESPONSABILITÉ, QUE CE SOIT DANS LE
+    CADRE D'UN CONTRAT, D'UN DÉLIT OU AUTRE, EN PROVENANCE DE, CONSÉCUTIF À OU
+    EN RELATION AVEC LA BIBLIOTHÈQUE OU SON UTILISATION, OU AVEC D'AUTRES
+    ÉLÉMENTS DE LA BIBLIOTHÈQUE.
+
+*/
+
+
+/**
+ *  \file arbre_binaire_compact.c
+ *
+ *  Arbres compacts. Tous les noeuds sont rangés dans un même tableau et
+ *  désignent leurs enfants par leur indice (32 bits) plutôt que par un
+ *  pointeur: un noeud occupe 12 octets au lieu de 32 (la taille d'un
+ *  arbre_binaire sur une machine 64 bits) et les noeuds restent contigus en
+ *  mémoire. Les noeuds retirés forment une liste de noeuds
+ *  libres, réutilisés par les prochains noeuds créés.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "arbre_binaire.h"
+#include "arbre_binaire_interne.h"
+
+/**
+ *  \brief Nombre de noeuds initial du tableau d'un arbre compact.
+ */
+#define COMPACT_MINIMUM 64
+
+/**
+ *  \brief Nombre de noeuds maximal du tableau d'un arbre compact (le nombre
+ *         d'éléments doit pouvoir être retourné dans un int).
+ */
+#define COMPACT_MAXIMUM (UINT32_C(1) << 31)
+
+/**
+ *  \brief Nombre d'éléments initial de la pile d'un parcours en
+ *         profondeur.
+ */
+#define PILE_COMPACT_MINIMUM 64
+
+/**
+ *  \brief Message d'erreur des modifications d'un arbre compact ordonné.
+ */
+#define MESSAGE_COMPACT_ORDONNE "L'arbre compact est ordonne, il ne peut \
+pas etre modifie."
+
+/**
+ * \brief Un élément de la pile d'un parcours en profondeur.
+ */
+struct element_compact {
+    uint32_t indice;
+    int profondeur;
+    int etat;
+};
+
+/**
+ * \brief Pile d'un parcours en profondeur d'un arbre compact.
+ */
+struct pile_compact {
+    struct element_compact* elements;
+    size_t nombre;
+    size_t capacite;
+};
+
+/**
+ * \brief État de la copie d'un arbre pendant son parcours en largeur:
+ *        "indice" est le noeud copié et "suivant" le premier noeud qui
+ *        n'a pas encore été attribué à un enfant.
+ */
+struct compactage {
+    arbre_binaire_compact* compact;
+    uint32_t indice;
+    uint32_t suivant;
+};
+
+/**
+ * \brief État de la copie d'un arbre compact en noeuds ordinaires.
+ */
+struct decompactage {
+    arbre_binaire** noeuds;
+    arbre_binaire_contexte* contexte;
+};
+
+/**
+ *  \brief Place un message d'erreur dans un arbre compact.
+ *
+ *  \param compact : L'arbre compact.
+ *  \param erreur  : La description de l'erreur.
+ *
+ *  \return ARBRE_BINAIRE_ERREUR.
+ */
+static arbre_binaire_statut inscrire_erreur_compact(
+        arbre_binaire_compact* compact, const char* erreur)
+{
+    compact->erreur.a_erreur = true;
+    strncpy(compact->erreur.texte, erreur, ERREUR_TAILLE - 1);
+    compact->erreur.texte[ERREUR_TAILLE - 1] = '\0';
+    return ARBRE_BINAIRE_ERREUR;
+}
+
+/**
+ *  \brief Indique si un indice désigne un noeud utilisé d'un arbre compact.
+ *
+ *  \param compact : L'arbre compact.
+ *  \param noeud   : L'indice du noeud.
+ *
+ *  \return Vrai si le noeud existe.
+ */
+static inline bool noeud_valide_compact(const arbre_binaire_compact* compact,
+                                        arbre_binaire_noeud_compact noeud)
+{
+    return noeud != ARBRE_BINAIRE_COMPACT_AUCUN &&
+           noeud < compact->utilises &&
+           compact->noeuds[noeud].second != COMPACT_LIBRE;
+}
+
+/**
+ *  \brief Vérifie qu'un noeud existe. Si ce n'est pas le cas, ajoute une
+ *         erreur.
+ *
+ *  \return Vrai si le noeud existe.
+ */
+static bool verifier_noeud_compact(arbre_binaire_compact* compact,
+                                   arbre_binaire_noeud_compact noeud)
+{
+    bool valide = noeud_valide_compact(compact, noeud);
+
+    if (valide == false) {
+        inscrire_erreur_compact(compact, "Le noeud n'existe pas.");
+    }
+    return valide;
+}
+
+/**
+ *  \brief Change la taille du tableau des noeuds d'un arbre compact.
+ *
+ *  \return Faux s'il n'y a plus de mémoire.
+ */
+static bool redimensionner_compact(arbre_binaire_compact* compact,
+                                   uint32_t capacite)
+{
+    struct arbre_binaire_element_compact* noeuds;
+    bool reussi;
+
+    noeuds = realloc(compact->noeuds, capacite * sizeof(*noeuds));
+    reussi = noeuds != NULL;
+    if (reussi) {
+        compact->noeuds = noeuds;
+        compact->capacite = capacite;
+    }
+    return reussi;
+}
+
+/**
+ *  \brief Prend un noeud libre d'un arbre compact, ou en ajoute un à la
+ *         fin du tableau (qui est doublé au besoin). Le tableau peut être
+ *         déplacé: les adresses des noeuds doivent être relues ensuite.
+ *
+ *  \param compact : L'arbre compact.
+ *  \param valeur  : La valeur du noeud.
+ *
+ *  \return L'indice du noeud, ou ARBRE_BINAIRE_COMPACT_AUCUN s'il n'y a
+ *          plus de mémoire.
+ */
+static uint32_t allouer_noeud_compact(arbre_binaire_compact* compact,
+                                      int valeur)
+{
+    uint32_t noeud = compact->libres;
+    uint32_t capacite;
+
+    if (noeud != ARBRE_BINAIRE_COMPACT_AUCUN) {
+        compact->libres = compact->noeuds[noeud].premier;
+    } else {
+        if (compact->utilises == compact->capacite &&
+            compact->capacite < COMPACT_MAXIMUM) {
+            capacite = compact->capacite < COMPACT_MAXIMUM / 2 ?
+                       2 * compact->capacite : COMPACT_MAXIMUM;
+            redimensionner_compact(compact, capacite);
+        }
+        if (compact->utilises < compact->capacite) {
+            noeud = compact->utilises;
+            compact->utilises = compact->utilises + 1;
+        }
+    }
+    if (noeud != ARBRE_BINAIRE_COMPACT_AUCUN) {
+        compact->noeuds[noeud].valeur = valeur;
+        compact->noeuds[noeud].premier = ARBRE_BINAIRE_COMPACT_AUCUN;
+        compact->noeuds[noeud].second = ARBRE_BINAIRE_COMPACT_AUCUN;
+        compact->nombre = compact->nombre + 1;
+        STATISTIQUE_AJOUTER(noeuds_alloues, 1);
+    }
+    return noeud;
+}
+
+/**
+ *  \brief Remet un sous-arbre dans la liste des noeuds libres, sans pile:
+ *         tant que le noeud courant a un premier enfant, une rotation
+ *         fait de cet enfant le noeud courant; sinon le noeud est libéré
+ *         et son second enfant devient le noeud courant.
+ *
+ *  \param compact : L'arbre compact.
+ *  \param noeud   : La racine du sous-arbre (peut être
+ *                   ARBRE_BINAIRE_COMPACT_AUCUN).
+ */
+static void liberer_sous_arbre_compact(arbre_binaire_compact* compact,
+                                       uint32_t noeud)
+{
+    struct arbre_binaire_element_compact* noeuds = compact->noeuds;
+    uint32_t suivant;
+
+    while (noeud != ARBRE_BINAIRE_COMPACT_AUCUN) {
+        suivant = noeuds[noeud].premier;
+        if (suivant != ARBRE_BINAIRE_COMPACT_AUCUN) {
+            noeuds[noeud].premier = noeuds[suivant].second;
+            noeuds[suivant].second = noeud;
+        } else {
+            suivant = noeuds[noeud].second;
+            noeuds[noeud].premier = compact->libres;
+            noeuds[noeud].second = COMPACT_LIBRE;
+            compact->libres = noeud;
+            compact->nombre = compact->nombre - 1;
+            STATISTIQUE_AJOUTER(noeuds_liberes, 1);
+        }
+        noeud = suivant;
+    }
+}
+
+/**
+ *  \brief Ajoute un élément sur le dessus de la pile d'un parcours en
+ *         profondeur.
+ *
+ *  \return Faux s'il n'y a plus de mémoire.
+ */
+static bool empiler_compact(struct pile_compact* pile, uint32_t indice,
+                            int profondeur)
+{
+    struct element_compact* elements = pile->elements;
+    bool reussi = true;
+
+    if (pile->nombre == pile->capacite) {
+        elements = realloc(pile->elements,
+                           2 * pile->capacite * sizeof(*elements));
+        reussi = elements != NULL;
+        if (reussi) {
+            pile->elements = elements;
+            pile->capacite = 2 * pile->capacite;
+        }
+    }
+    if (reussi) {
+        elements[pile->nombre].indice = indice;
+        elements[pile->nombre].profondeur = profondeur;
+        elements[pile->nombre].etat = 0;
+        pile->nombre = pile->nombre + 1;
+    }
+    return reussi;
+}
+
+/**
+ *  \brief Parcours préfixe, infixe ou postfixe. L'état de chaque élément
+ *         indique quels enfants ont déjà été parcourus; le noeud est
+ *         visité à l'état qui correspond à l'ordre demandé. Le tableau
+ *         des noeuds est relu à chaque étape, puisque le visiteur peut
+ *         modifier l'arbre.
+ */
+static bool parcourir_profondeur(arbre_binaire_compact* compact, int moment,
+                                 arbre_binaire_visiteur_compact visiteur,
+                                 void* donnees, bool* memoire)
+{
+    struct pile_compact pile;
+    struct element_compact element;
+    uint32_t enfant;
+    bool continuer = true;
+
+    pile.nombre = 0;
+    pile.capacite = PILE_COMPACT_MINIMUM;
+    pile.elements = malloc(pile.capacite * sizeof(struct element_compact));
+    *memoire = pile.elements != NULL &&
+               empiler_compact(&pile, ARBRE_BINAIRE_COMPACT_RACINE, 1);
+    while (continuer && *memoire && pile.nombre > 0) {
+        element = pile.elements[pile.nombre - 1];
+        pile.elements[pile.nombre - 1].etat = element.etat + 1;
+        if (element.etat == moment) {
+            STATISTIQUE_VISITE();
+            continuer = visiteur(compact, element.indice, element.profondeur,
+                                 donnees);
+        }
+        if (element.etat < 2) {
+            enfant = element.etat == 0 ?
+                     compact->noeuds[element.indice].premier :
+                     compact->noeuds[element.indice].second;
+            if (enfant != ARBRE_BINAIRE_COMPACT_AUCUN && continuer) {
+                *memoire = empiler_compact(&pile, enfant,
+                                           element.profondeur + 1);
+                STATISTIQUE_MAXIMUM(pile_maximale, pile.nombre);
+            }
+        } else {
+            pile.nombre = pile.nombre - 1;
+        }
+    }
+    free(pile.elements);
+    return continuer;
+}
+
+/**
+ *  \brief Parcours en largeur. Chaque noeud n'entre qu'une fois dans la
+ *         file, qui ne dépasse donc jamais le nombre de noeuds.
+ */
+static bool parcourir_largeur(arbre_binaire_compact* compact,
+                              arbre_binaire_visiteur_compact visiteur,
+                              void* donnees, bool* memoire)
+{
+    struct element_compact* file;
+    struct element_compact element;
+    size_t debut = 0;
+    size_t fin = 0;
+    bool continuer = true;
+
+    file = malloc(compact->nombre * sizeof(struct element_compact));
+    *memoire = file != NULL;
+    if (file) {
+        file[0].indice = ARBRE_BINAIRE_COMPACT_RACINE;
+        file[0].profondeur = 1;
+        fin = 1;
+    }
+    while (continuer && debut < fin) {
+        element = file[debut];
+        debut = debut + 1;
+        STATISTIQUE_VISITE();
+        continuer = visiteur(compact, element.indice, element.profondeur,
+                             donnees);
+        if (compact->noeuds[element.indice].premier) {
+            file[fin].indice = compact->noeuds[element.indice].premier;
+            file[fin].profondeur = element.profondeur + 1;
+            fin = fin + 1;
+        }
+        if (compact->noeuds[element.indice].second) {
+            file[fin].indice = compact->noeuds[element.indice].second;
+            file[fin].profondeur = element.profondeur + 1;
+            fin = fin + 1;
+        }
+    }
+    free(file);
+    return continuer;
+}
+
+/**
+ *  \brief Crée un arbre compact qui ne contient que sa racine.
+ *
+ *  \param valeur : La valeur de la racine.
+ *
+ *  \return Le nouvel arbre, ou NULL s'il n'y a plus de mémoire.
+ */
+arbre_binaire_compact* creer_arbre_binaire_compact(int valeur)
+{
+    arbre_binaire_compact* compact;
+
+    compact = calloc(1, sizeof(arbre_binaire_compact));
+    if (compact) {
+        compact->utilises = ARBRE_BINAIRE_COMPACT_RACINE;
+        if (redimensionner_compact(compact, COMPACT_MINIMUM)) {
+            allouer_noeud_compact(compact, valeur);
+        } else {
+            free(compact);
+            compact = NULL;
+        }
+    }
+    return compact;
+}
+
+/**
+ *  \brief Visiteur (en largeur) qui copie un noeud dans l'arbre compact.
+ *         Les enfants sont visités dans l'ordre où leurs indices sont
+ *         attribués.
+ */
+static bool compacter_noeud(arbre_binaire* noeud, int profondeur,
+                            void* donnees)
+{
+    struct compactage* compactage = donnees;
+    struct arbre_binaire_element_compact* element;
+
+    element = &compactage->compact->noeuds[compactage->indice];
+    element->valeur = LIRE_VALEUR(noeud);
+    element->premier = ARBRE_BINAIRE_COMPACT_AUCUN;
+    element->second = ARBRE_BINAIRE_COMPACT_AUCUN;
+    if (noeud->premier_fils) {
+        element->premier = compactage->suivant;
+        compactage->suivant = compactage->suivant + 1;
+    }
+    if (noeud->second_fils) {
+        element->second = compactage->suivant;
+        compactage->suivant = compactage->suivant + 1;
+    }
+    compactage->indice = compactage->indice + 1;
+    return true;
+}
+
+/**
+ *  \brief Copie un arbre dans un arbre compact. Les noeuds sont rangés en
+ *         ordre de largeur, ce qui place les noeuds d'un même niveau côte
+ *         à côte.
+ *
+ *  \param arbre : L'arbre à copier (il n'est pas modifié).
+ *
+ *  \return La copie, ou NULL s'il n'y a plus de mémoire (une erreur est
+ *          alors inscrite dans l'arbre).
+ */
+arbre_binaire_compact* compacter_arbre_binaire(arbre_binaire* arbre)
+{
+    arbre_binaire_compact* compact = NULL;
+    struct compactage compactage;
+    size_t nombre;
+    bool valide = false;
+
+    if (arbre) {
+        compact = calloc(1, sizeof(arbre_binaire_compact));
+    }
+    if (compact) {
+        verrouiller_ecriture_arbre_binaire(arbre->contexte);
+        nombre = nombre_elements_arbre_binaire(arbre);
+        compact->options = arbre->contexte->options;
+        if (nombre < COMPACT_MAXIMUM &&
+            redimensionner_compact(compact, nombre + 1)) {
+            compactage.compact = compact;
+            compactage.indice = ARBRE_BINAIRE_COMPACT_RACINE;
+            compactage.suivant = ARBRE_BINAIRE_COMPACT_RACINE + 1;
+            valide = parcourir_arbre_binaire(arbre, ARBRE_BINAIRE_LARGEUR,
+                                             compacter_noeud, &compactage);
+        }
+        deverrouiller_ecriture_arbre_binaire(arbre->contexte);
+        if (valide) {
+            compact->utilises = nombre + 1;
+            compact->nombre = nombre;
+            STATISTIQUE_AJOUTER(noeuds_alloues, nombre);
+        } else {
+            free(compact->noeuds);
+            free(compact);
+            compact = NULL;
+        }
+    }
+    if (arbre && compact == NULL) {
+        inscrire_erreur_arbre_binaire(arbre, "Il n'y a plus de memoire.");
+    }
+    return compact;
+}
+
+/**
+ *  \brief Visiteur (préfixe) qui crée les enfants d'un noeud déjà copié.
+ */
+static bool decompacter_noeud(arbre_binaire_compact* compact,
+                              arbre_binaire_noeud_compact noeud,
+                              int profondeur, void* donnees)
+{
+    struct decompactage* decompactage = donnees;
+    arbre_binaire** noeuds = decompactage->noeuds;
+    uint32_t premier = compact->noeuds[noeud].premier;
+    uint32_t second = compact->noeuds[noeud].second;
+    bool valide = true;
+
+    if (premier) {
+        noeuds[premier] = allouer_noeud_arbre_binaire(decompactage->contexte,
+                                            compact->noeuds[premier].valeur);
+        noeuds[noeud]->premier_fils = noeuds[premier];
+        valide = noeuds[premier] != NULL;
+    }
+    if (valide && second) {
+        noeuds[second] = allouer_noeud_arbre_binaire(decompactage->contexte,
+                                            compact->noeuds[second].valeur);
+        noeuds[noeud]->second_fils = noeuds[second];
+        valide = noeuds[second] != NULL;
+    }
+    return valide;
+}
+
+/**
+ *  \brief Recrée un arbre de noeuds ordinaires à partir d'un arbre compact.
+ *         Les noeuds sont créés en ordre préfixe, ce qui place chaque
+ *         noeud près de son premier enfant dans une arène.
+ *
+ *  \param compact : L'arbre compact.
+ *
+ *  \return Le nouvel arbre, ou NULL s'il n'y a plus de mémoire.
+ */
+arbre_binaire* decompacter_arbre_binaire(arbre_binaire_compact* compact)
+{
+    struct decompactage decompactage;
+    arbre_binaire* arbre = NULL;
+    bool valide = false;
+    bool memoire = true;
+
+    decompactage.noeuds = calloc(compact->utilises, sizeof(arbre_binaire*));
+    if (decompactage.noeuds) {
+        arbre = creer_arbre_binaire_options(
+                compact->noeuds[ARBRE_BINAIRE_COMPACT_RACINE].valeur,
+                compact->options);
+    }
+    if (arbre) {
+        decompactage.contexte = arbre->contexte;
+        if (arbre->contexte->options & ARBRE_BINAIRE_OPTION_ARENE &&
+            compact->nombre > 1) {
+            reserver_arene(&arbre->contexte->arene, compact->nombre - 1);
+        }
+        decompactage.noeuds[ARBRE_BINAIRE_COMPACT_RACINE] = arbre;
+        valide = parcourir_profondeur(compact, 0, decompacter_noeud,
+                                      &decompactage, &memoire);
+        if (valide == false || memoire == false) {
+            detruire_arbre_binaire(arbre);
+            arbre = NULL;
+        } else if (arbre->contexte->options & ARBRE_BINAIRE_OPTION_PARENT) {
+            recalculer_sous_arbre_binaire(arbre);
+        }
+    }
+    free(decompactage.noeuds);
+    return arbre;
+}
+
+/**
+ *  \brief Libère la mémoire d'un arbre compact.
+ *
+ *  \param compact : L'arbre à détruire.
+ */
+void detruire_arbre_binaire_compact(arbre_binaire_compact* compact)
+{
+    if (compact) {
+        STATISTIQUE_AJOUTER(noeuds_liberes, compact->nombre);
+        free(compact->noeuds);
+        free(compact);
+    }
+}
+
+/**
+ *  \brief Indique la valeur d'un noeud d'un arbre compact.
+ *
+ *  \param compact : L'arbre compact.
+ *  \param noeud   : Le noeud.
+ *
+ *  \return La valeur du noeud (0 si le noeud n'existe pas).
+ */
+int element_arbre_binaire_compact(arbre_binaire_compact* compact,
+                                  arbre_binaire_noeud_compact noeud)
+{
+    int valeur = 0;
+
+    compact->erreur.a_erreur = false;
+    if (verifier_noeud_compact(compact, noeud)) {
+        valeur = compact->noeuds[noeud].valeur;
+    }
+    return valeur;
+}
+
+/**
+ *  \brief Modifie la valeur d'un noeud d'un arbre compact. Si le noeud
+ *         n'existe pas ou si l'arbre est ordonné, ajoute une erreur.
+ *
+ *  \param compact : L'arbre compact.
+ *  \param noeud   : Le noeud à modifier.
+ *  \param valeur  : La nouvelle valeur.
+ */
+void modifier_element_arbre_binaire_compact(arbre_binaire_compact* compact,
+                                            arbre_binaire_noeud_compact noeud,
+                                            int valeur)
+{
+    compact->erreur.a_erreur = false;
+    if (compact->options & ARBRE_BINAIRE_OPTION_ORDONNE) {
+        inscrire_erreur_compact(compact, MESSAGE_COMPACT_ORDONNE);
+    } else if (verifier_noeud_compact(compact, noeud)) {
+        compact->noeuds[noeud].valeur = valeur;
+    }
+}
+
+/**
+ *  \brief Donne le premier enfant d'un noeud d'un arbre compact.
+ *
+ *  \param compact : L'arbre compact.
+ *  \param noeud   : Le noeud.
+ *
+ *  \return Le premier enfant, ou ARBRE_BINAIRE_COMPACT_AUCUN.
+ */
+arbre_binaire_noeud_compact premier_enfant_arbre_binaire_compact(
+        arbre_binaire_compact* compact, arbre_binaire_noeud_compact noeud)
+{
+    arbre_binaire_noeud_compact enfant = ARBRE_BINAIRE_COMPACT_AUCUN;
+
+    compact->erreur.a_erreur = false;
+    if (verifier_noeud_compact(compact, noeud)) {
+        enfant = compact->noeuds[noeud].premier;
+    }
+    return enfant;
+}
+
+/**
+ *  \brief Donne le second enfant d'un noeud d'un arbre compact.
+ *
+ *  \param compact : L'arbre compact.
+ *  \param noeud   : Le noeud.
+ *
+ *  \return Le second enfant, ou ARBRE_BINAIRE_COMPACT_AUCUN.
+ */
+arbre_binaire_noeud_compact second_enfant_arbre_binaire_compact(
+        arbre_binaire_compact* compact, arbre_binaire_noeud_compact noeud)
+{
+    arbre_binaire_noeud_compact enfant = ARBRE_BINAIRE_COMPACT_AUCUN;
+
+    compact->erreur.a_erreur = false;
+    if (verifier_noeud_compact(compact, noeud)) {
+        enfant = compact->noeuds[noeud].second;
+    }
+    return enfant;
+}
+
+/**
+ *  \brief Ajoute un enfant à un noeud d'un arbre compact.
+ *
+ *  \param compact : L'arbre compact.
+ *  \param noeud   : Le noeud qui reçoit l'enfant.
+ *  \param valeur  : La valeur de l'enfant.
+ *  \param second  : Vrai pour le second enfant, Faux pour le premier.
+ *
+ *  \return ARBRE_BINAIRE_SUCCES si l'enfant a été créé.
+ */
+static arbre_binaire_statut creer_enfant_compact(
+        arbre_binaire_compact* compact, arbre_binaire_noeud_compact noeud,
+        int valeur, bool second)
+{
+    arbre_binaire_statut statut = ARBRE_BINAIRE_ERREUR;
+    uint32_t enfant;
+
+    compact->erreur.a_erreur = false;
+    if (compact->options & ARBRE_BINAIRE_OPTION_ORDONNE) {
+        inscrire_erreur_compact(compact, MESSAGE_COMPACT_ORDONNE);
+    } else if (verifier_noeud_compact(compact, noeud) == false) {
+    } else if (second == false && compact->noeuds[noeud].premier) {
+        inscrire_erreur_compact(compact, "Il y a deja un premier fils.");
+    } else if (second && compact->noeuds[noeud].second) {
+        inscrire_erreur_compact(compact, "Il y a deja un second fils.");
+    } else {
+        enfant = allouer_noeud_compact(compact, valeur);
+        if (enfant == ARBRE_BINAIRE_COMPACT_AUCUN) {
+            inscrire_erreur_compact(compact, "Il n'y a plus de memoire.");
+        } else if (second) {
+            compact->noeuds[noeud].second = enfant;
+            statut = ARBRE_BINAIRE_SUCCES;
+        } else {
+            compact->noeuds[noeud].premier = enfant;
+            statut = ARBRE_BINAIRE_SUCCES;
+        }
+    }
+    return statut;
+}
+
+/**
+ *  \brief Ajoute un premier enfant à un noeud d'un arbre compact. S'il y a
+ *         un premier enfant, ajoute une erreur.
+ *
+ *  \param compact : L'arbre compact.
+ *  \param noeud   : Le noeud qui reçoit l'enfant.
+ *  \param valeur  : La valeur de l'enfant.
+ *
+ *  \return ARBRE_BINAIRE_SUCCES si l'enfant a été créé.
+ */
+arbre_binaire_statut creer_premier_enfant_arbre_binaire_compact(
+        arbre_binaire_compact* compact, arbre_binaire_noeud_compact noeud,
+        int valeur)
+{
+    return creer_enfant_compact(compact, noeud, valeur, false);
+}
+
+/**
+ *  \brief Ajoute un second enfant à un noeud d'un arbre compact. S'il y a
+ *         un second enfant, ajoute une erreur.
+ *
+ *  \param compact : L'arbre compact.
+ *  \param noeud   : Le noeud qui reçoit l'enfant.
+ *  \param valeur  : La valeur de l'enfant.
+ *
+ *  \return ARBRE_BINAIRE_SUCCES si l'enfant a été créé.
+ */
+arbre_binaire_statut creer_second_enfant_arbre_binaire_compact(
+        arbre_binaire_compact* compact, arbre_binaire_noeud_compact noeud,
+        int valeur)
+{
+    return creer_enfant_compact(compact, noeud, valeur, true);
+}
+
+/**
+ *  \brief Supprime le premier enfant (et ses descendants) d'un noeud d'un
+ *         arbre compact. Leurs places sont réutilisées par les prochains
+ *         noeuds créés.
+ *
+ *  \param compact : L'arbre compact.
+ *  \param noeud   : Le noeud.
+ */
+void retirer_premier_enfant_arbre_binaire_compact(
+        arbre_binaire_compact* compact, arbre_binaire_noeud_compact noeud)
+{
+    compact->erreur.a_erreur = false;
+    if (compact->options & ARBRE_BINAIRE_OPTION_ORDONNE) {
+        inscrire_erreur_compact(compact, MESSAGE_COMPACT_ORDONNE);
+    } else if (verifier_noeud_compact(compact, noeud)) {
+        liberer_sous_arbre_compact(compact, compact->noeuds[noeud].premier);
+        compact->noeuds[noeud].premier = ARBRE_BINAIRE_COMPACT_AUCUN;
+    }
+}
+
+/**
+ *  \brief Supprime le second enfant (et ses descendants) d'un noeud d'un
+ *         arbre compact. Leurs places sont réutilisées par les prochains
+ *         noeuds créés.
+ *
+ *  \param compact : L'arbre compact.
+ *  \param noeud   : Le noeud.
+ */
+void retirer_second_enfant_arbre_binaire_compact(
+        arbre_binaire_compact* compact, arbre_binaire_noeud_compact noeud)
+{
+    compact->erreur.a_erreur = false;
+    if (compact->options & ARBRE_BINAIRE_OPTION_ORDONNE) {
+        inscrire_erreur_compact(compact, MESSAGE_COMPACT_ORDONNE);
+    } else if (verifier_noeud_compact(compact, noeud)) {
+        liberer_sous_arbre_compact(compact, compact->noeuds[noeud].second);
+        compact->noeuds[noeud].second = ARBRE_BINAIRE_COMPACT_AUCUN;
+    }
+}
+
+/**
+ *  \brief Indique le nombre d'éléments d'un arbre compact.
+ *
+ *  \param compact : L'arbre compact.
+ *
+ *  \return Le nombre d'éléments.
+ */
+int nombre_elements_arbre_binaire_compact(arbre_binaire_compact* compact)
+{
+    return (int)compact->nombre;
+}
+
+/**
+ *  \brief Indique le nombre de feuilles d'un arbre compact. Le tableau des
+ *         noeuds est lu d'un bout à l'autre, sans parcourir l'arbre (les
+ *         noeuds libres n'ont pas de second enfant nul).
+ *
+ *  \param compact : L'arbre compact.
+ *
+ *  \return Le nombre de feuilles.
+ */
+int nombre_feuilles_arbre_binaire_compact(arbre_binaire_compact* compact)
+{
+    const struct arbre_binaire_element_compact* noeuds = compact->noeuds;
+    int feuilles = 0;
+    uint32_t i;
+
+    for (i = ARBRE_BINAIRE_COMPACT_RACINE; i < compact->utilises; i = i + 1) {
+        STATISTIQUE_VISITE();
+        if (noeuds[i].premier == ARBRE_BINAIRE_COMPACT_AUCUN &&
+            noeuds[i].second == ARBRE_BINAIRE_COMPACT_AUCUN) {
+            feuilles = feuilles + 1;
+        }
+    }
+    return feuilles;
+}
+
+/**
+ *  \brief Visiteur qui retient la plus grande profondeur.
+ */
+static bool mesurer_profondeur_compact(arbre_binaire_compact* compact,
+                                       arbre_binaire_noeud_compact noeud,
+                                       int profondeur, void* donnees)
+{
+    int* hauteur = donnees;
+
+    if (profondeur > *hauteur) {
+        *hauteur = profondeur;
+    }
+    return true;
+}
+
+/**
+ *  \brief Indique la hauteur d'un arbre compact.
+ *
+ *  \param compact : L'arbre compact.
+ *
+ *  \return La hauteur (0 s'il n'y a plus de mémoire pour le parcours; une
+ *          erreur est alors inscrite dans l'arbre).
+ */
+int hauteur_arbre_binaire_compact(arbre_binaire_compact* compact)
+{
+    int hauteur = 0;
+
+    compact->erreur.a_erreur = false;
+    if (parcourir_arbre_binaire_compact(compact, ARBRE_BINAIRE_POSTFIXE,
+                                        mesurer_profondeur_compact,
+                                        &hauteur) == false) {
+        hauteur = 0;
+    }
+    return hauteur;
+}
+
+/**
+ *  \brief Vérifie si une valeur est dans un arbre compact. Si l'arbre est
+ *         ordonné, la recherche descend l'arbre, sinon le tableau des
+ *         noeuds est lu d'un bout à l'autre.
+ *
+ *  \param compact : L'arbre compact.
+ *  \param valeur  : La valeur à chercher.
+ *
+ *  \return Vrai si la valeur est présente.
+ */
+bool contient_element_arbre_binaire_compact(arbre_binaire_compact* compact,
+                                            int valeur)
+{
+    const struct arbre_binaire_element_compact* noeuds = compact->noeuds;
+    uint32_t i = ARBRE_BINAIRE_COMPACT_RACINE;
+    bool trouve = false;
+
+    if (compact->options & ARBRE_BINAIRE_OPTION_ORDONNE) {
+        while (i != ARBRE_BINAIRE_COMPACT_AUCUN && trouve == false) {
+            STATISTIQUE_VISITE();
+            if (valeur == noeuds[i].valeur) {
+                trouve = true;
+            } else if (valeur < noeuds[i].valeur) {
+                i = noeuds[i].premier;
+            } else {
+                i = noeuds[i].second;
+            }
+        }
+    } else {
+        for (i = ARBRE_BINAIRE_COMPACT_RACINE;
+             i < compact->utilises && trouve == false; i = i + 1) {
+            STATISTIQUE_VISITE();
+            trouve = noeuds[i].valeur == valeur &&
+                     noeuds[i].second != COMPACT_LIBRE;
+        }
+    }
+    return trouve;
+}
+
+/**
+ *  \brief Visite tous les noeuds d'un arbre compact dans l'ordre demandé.
+ *
+ *  \param compact  : L'arbre compact.
+ *  \param ordre    : L'ordre du parcours.
+ *  \param visiteur : La fonction appelée pour chaque noeud.
+ *  \param donnees  : Données passées telles quelles au visiteur.
+ *
+ *  \return Vrai si tous les noeuds ont été visités, Faux si le visiteur a
+ *          arrêté le parcours ou s'il n'y a plus de mémoire (dans ce cas
+ *          une erreur est inscrite dans l'arbre).
+ */
+bool parcourir_arbre_binaire_compact(arbre_binaire_compact* compact,
+                                     arbre_binaire_ordre ordre,
+                                     arbre_binaire_visiteur_compact visiteur,
+                                     void* donnees)
+{
+    bool continuer = true;
+    bool memoire = true;
+
+    if (ordre == ARBRE_BINAIRE_PREFIXE ||
+        ordre == ARBRE_BINAIRE_PREFIXE_MORRIS) {
+        continuer = parcourir_profondeur(compact, 0, visiteur, donnees,
+                                         &memoire);
+    } else if (ordre == ARBRE_BINAIRE_INFIXE ||
+               ordre == ARBRE_BINAIRE_INFIXE_MORRIS) {
+        continuer = parcourir_profondeur(compact, 1, visiteur, donnees,
+                                         &memoire);
+    } else if (ordre == ARBRE_BINAIRE_POSTFIXE) {
+        continuer = parcourir_profondeur(compact, 2, visiteur, donnees,
+                                         &memoire);
+    } else {
+        continuer = parcourir_largeur(compact, visiteur, donnees, &memoire);
+    }
+    if (memoire == false) {
+        inscrire_erreur_compact(compact, "Il n'y a plus de memoire.");
+    }
+    return continuer && memoire;
+}
+
+/**
+ *  \brief Indique s'il y a une erreur dans un arbre compact.
+ *
+ *  \param compact : L'arbre compact.
+ *
+ *  \return Vrai s'il y a une erreur.
+ */
+bool a_erreur_arbre_binaire_compact(arbre_binaire_compact* compact)
+{
+    return compact->erreur.a_erreur;
+}
+
+/**
+ *  \brief Indique le texte de l'erreur d'un arbre compact.
+ *
+ *  \param compact : L'arbre compact.
+ *
+ *  \return Le texte de l'erreur (vide s'il n'y a pas d'erreur).
+ */
+char* erreur_arbre_binaire_compact(arbre_binaire_compact* compact)
+{
+    if (compact->erreur.a_erreur == false) {
+        compact->erreur.texte[0] = '\0';
+    }
+    return compact->erreur.texte;
+}
@@ -0,0 +1,344 @@
+/*
+
+    Copyright (c) 2015 Nicolas Bisson
+
+    L'autorisation est accordée, gracieusement, à toute personne acquérant une
+    copie de cette bibliothèque et des fichiers de documentation associés
+    (la "Bibliothèque"), de commercialiser la Bibliothèque sans restriction,
+    notamment les droits d'utiliser, de copier, de modifier, de fusionner, de
+    publier, de distribuer, de sous-licencier et / ou de vendre des copies de
+    la Bibliothèque, ainsi que d'autoriser les personnes auxquelles la
+    Bibliothèque est fournie à le faire, sous réserve des conditions suivantes:
+
+    La déclaration de copyright ci-dessus et la présente autorisation doivent
+    être incluses dans toutes copies ou parties substantielles de la
+    Bibliothèque.
+
+    LA BIBLIOTHÈQUE EST FOURNIE "TELLE QUELLE", SANS GARANTIE D'AUCUNE SORTE,
+    EXPLICITE OU IMPLICITE, NOTAMMENT SANS GARANTIE DE QUALITÉ MARCHANDE,
+    D’ADÉQUATION À UN USAGE PARTICULIER ET D'ABSENCE DE CONTREFAÇON. EN AUCUN
+    CAS, LES AUTEURS OU TITULAIRES DU DROIT D'AUTEUR NE SERONT RESPONSABLES DE
+    TOUT DOMMAGE, RÉCLAMATION OU AUTRE RESPONSABILITÉ, QUE CE SOIT DANS LE
+    CADRE D'UN CONTRAT, D'UN DÉLIT OU AUTRE, EN PROVENANCE DE, CONSÉCUTIF À OU
+    EN RELATION AVEC LA BIBLIOTHÈQUE OU SON UTILISATION, OU AVEC D'AUTRES
+    ÉLÉMENTS DE LA BIBLIOTHÈQUE.
+
+*/
+
+/**
+ *  \file arbre_binaire_concurrent.c
+ *
+ *  Mode concurrent (ARBRE_BINAIRE_OPTION_CONCURRENT). Les lecteurs ne
+ *  prennent aucun verrou: ils s'inscrivent seulement dans un compteur de
+ *  l'époque courante (il y a deux époques, qui alternent). Les écritures
+ *  sont sérialisées par un verrou. Un sous-arbre retiré est d'abord mis de
+ *  côté; lorsqu'il y en a assez, l'écrivain change deux fois d'époque et
+ *  attend chaque fois que les lecteurs de l'ancienne époque aient terminé.
+ *  Les lectures qui auraient pu voir les sous-arbres retirés sont alors
+ *  toutes terminées et les sous-arbres sont libérés.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "arbre_binaire.h"
+#include "arbre_binaire_interne.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#define ceder_processeur() SwitchToThread()
+#else
+#include <pthread.h>
+#include <sched.h>
+#define ceder_processeur() sched_yield()
+#endif
+
+/**
+ *  \brief Nombre de compteurs de lecteurs. Les fils sont répartis entre
+ *         les compteurs pour qu'ils n'écrivent pas tous au même endroit.
+ */
+#define LECTURE_EMPLACEMENTS 64
+
+/**
+ *  \brief Nombre de sous-arbres retirés conservés avant d'attendre les
+ *         lecteurs pour les libérer.
+ */
+#define RETRAITS_MAXIMUM 64
+
+/**
+ *  \brief Compteurs de lecteurs de chaque époque, seuls sur leur ligne de
+ *         cache.
+ */
+struct emplacement_lecture {
+    atomic_long lecteurs[2];
+    char remplissage[64 - 2 * sizeof(atomic_long)];
+};
+
+/**
+ *  \brief État d'un arbre en mode concurrent.
+ */
+struct arbre_binaire_concurrence {
+    struct emplacement_lecture emplacements[LECTURE_EMPLACEMENTS];
+    atomic_uint epoque;
+#ifdef _WIN32
+    CRITICAL_SECTION ecriture;
+#else
+    pthread_mutex_t ecriture;
+#endif
+    arbre_binaire* retraits[RETRAITS_MAXIMUM];
+    size_t nombre_retraits;
+};
+
+/**
+ *  \brief Numéro du fil courant (0 tant qu'il n'a pas été attribué).
+ */
+static LOCAL_AU_FIL unsigned int numero_fil;
+
+/**
+ *  \brief Dernier numéro de fil attribué.
+ */
+static atomic_uint dernier_numero_fil;
+
+/**
+ *  \brief Erreur du fil courant pour les arbres en mode concurrent.
+ */
+static LOCAL_AU_FIL struct arbre_binaire_erreur erreur_fil;
+
+/**
+ *  \brief Donne l'emplacement de l'erreur d'un arbre: celui du contexte,
+ *         ou celui du fil courant en mode concurrent.
+ *
+ *  \param contexte : Le contexte de l'arbre.
+ *
+ *  \return L'emplacement de l'erreur.
+ */
+struct arbre_binaire_erreur* erreur_contexte_arbre_binaire(
+        arbre_binaire_contexte* contexte)
+{
+    struct arbre_binaire_erreur* erreur = &contexte->erreur;
+
+    if (contexte->concurrence) {
+        erreur = &erreur_fil;
+    }
+    return erreur;
+}
+
+/**
+ *  \brief Prépare un contexte pour le mode concurrent.
+ *
+ *  \param contexte : Le contexte de l'arbre.
+ *
+ *  \return Faux s'il n'y a plus de mémoire.
+ */
+bool initialiser_concurrence_arbre_binaire(arbre_binaire_contexte* contexte)
+{
+    struct arbre_binaire_concurrence* concurrence;
+    int i;
+
+    concurrence = calloc(1, sizeof(struct arbre_binaire_concurrence));
+    if (concurrence) {
+        for (i = 0; i < LECTURE_EMPLACEMENTS; i = i + 1) {
+            atomic_init(&concurrence->emplacements[i].lecteurs[0], 0);
+            atomic_init(&concurrence->emplacements[i].lecteurs[1], 0);
+        }
+        atomic_init(&concurrence->epoque, 0);
+#ifdef _WIN32
+        InitializeCriticalSection(&concurrence->ecriture);
+#else
+        pthread_mutex_init(&concurrence->ecriture, NULL);
+#endif
+    }
+    contexte->concurrence = concurrence;
+    return concurrence != NULL;
+}
+
+/**
+ *  \brief Attend que toutes les lectures en cours soient terminées. Les
+ *         nouvelles lectures ne sont pas attendues: elles ne peuvent plus
+ *         atteindre les sous-arbres déjà retirés.
+ *
+ *  \param concurrence : L'état de l'arbre (l'écriture doit être réservée).
+ */
+static void attendre_lecteurs(struct arbre_binaire_concurrence* concurrence)
+{
+    atomic_long* lecteurs;
+    unsigned int ancienne;
+    int passe;
+    int i;
+
+    for (passe = 0; passe < 2; passe = passe + 1) {
+        ancienne = atomic_fetch_add(&concurrence->epoque, 1) & 1;
+        for (i = 0; i < LECTURE_EMPLACEMENTS; i = i + 1) {
+            lecteurs = &concurrence->emplacements[i].lecteurs[ancienne];
+            while (atomic_load(lecteurs) != 0) {
+                ceder_processeur();
+            }
+        }
+    }
+}
+
+/**
+ *  \brief Libère les sous-arbres mis de côté.
+ *
+ *  \param concurrence : L'état de l'arbre.
+ */
+static void liberer_retraits(struct arbre_binaire_concurrence* concurrence)
+{
+    size_t i;
+
+    for (i = 0; i < concurrence->nombre_retraits; i = i + 1) {
+        detruire_arbre_binaire(concurrence->retraits[i]);
+    }
+    concurrence->nombre_retraits = 0;
+}
+
+/**
+ *  \brief Libère les sous-arbres en attente de libération et l'état du
+ *         mode concurrent. Aucun lecteur ne doit utiliser l'arbre.
+ *
+ *  \param contexte : Le contexte de l'arbre.
+ */
+void liberer_concurrence_arbre_binaire(arbre_binaire_contexte* contexte)
+{
+    struct arbre_binaire_concurrence* concurrence = contexte->concurrence;
+
+    if (concurrence) {
+        liberer_retraits(concurrence);
+#ifdef _WIN32
+        DeleteCriticalSection(&concurrence->ecriture);
+#else
+        pthread_mutex_destroy(&concurrence->ecriture);
+#endif
+        free(concurrence);
+        contexte->concurrence = NULL;
+    }
+}
+
+/**
+ *  \brief Réserve l'arbre pour une écriture (rien hors du mode concurrent).
+ *
+ *  \param contexte : Le contexte de l'arbre.
+ */
+void verrouiller_ecriture_arbre_binaire(arbre_binaire_contexte* contexte)
+{
+    if (contexte->concurrence) {
+#ifdef _WIN32
+        EnterCriticalSection(&contexte->concurrence->ecriture);
+#else
+        pthread_mutex_lock(&contexte->concurrence->ecriture);
+#endif
+    }
+}
+
+/**
+ *  \brief Termine une écriture commencée par
+ *         verrouiller_ecriture_arbre_binaire.
+ *
+ *  \param contexte : Le contexte de l'arbre.
+ */
+void deverrouiller_ecriture_arbre_binaire(arbre_binaire_contexte* contexte)
+{
+    if (contexte->concurrence) {
+#ifdef _WIN32
+        LeaveCriticalSection(&contexte->concurrence->ecriture);
+#else
+        pthread_mutex_unlock(&contexte->concurrence->ecriture);
+#endif
+    }
+}
+
+/**
+ *  \brief Libère un sous-arbre détaché de l'arbre lorsque plus aucun
+ *         lecteur ne peut le parcourir. L'écriture doit être réservée.
+ *
+ *  \param sous_arbre : Le sous-arbre détaché.
+ */
+void differer_liberation_arbre_binaire(arbre_binaire* sous_arbre)
+{
+    struct arbre_binaire_concurrence* concurrence;
+
+    concurrence = sous_arbre->contexte->concurrence;
+    if (concurrence->nombre_retraits == RETRAITS_MAXIMUM) {
+        attendre_lecteurs(concurrence);
+        liberer_retraits(concurrence);
+    }
+    concurrence->retraits[concurrence->nombre_retraits] = sous_arbre;
+    concurrence->nombre_retraits = concurrence->nombre_retraits + 1;
+}
+
+/**
+ *  \brief Commence une lecture à partir du contexte. Le fil est compté
+ *         parmi les lecteurs de l'époque courante.
+ *
+ *  \param contexte : Le contexte de l'arbre.
+ *
+ *  \return Le jeton à passer à sortir_lecture_contexte_arbre_binaire (-1
+ *          si l'arbre n'est pas en mode concurrent).
+ */
+int entrer_lecture_contexte_arbre_binaire(arbre_binaire_contexte* contexte)
+{
+    struct arbre_binaire_concurrence* concurrence = contexte->concurrence;
+    unsigned int emplacement;
+    unsigned int epoque;
+    int jeton = -1;
+
+    if (concurrence) {
+        if (numero_fil == 0) {
+            numero_fil = atomic_fetch_add(&dernier_numero_fil, 1) + 1;
+        }
+        emplacement = numero_fil % LECTURE_EMPLACEMENTS;
+        epoque = atomic_load(&concurrence->epoque) & 1;
+        atomic_fetch_add(&concurrence->emplacements[emplacement]
+                          .lecteurs[epoque], 1);
+        atomic_thread_fence(memory_order_seq_cst);
+        jeton = (int)(2 * emplacement + epoque);
+    }
+    return jeton;
+}
+
+/**
+ *  \brief Termine une lecture à partir du contexte.
+ *
+ *  \param contexte : Le contexte de l'arbre.
+ *  \param jeton    : Le jeton reçu au début de la lecture.
+ */
+void sortir_lecture_contexte_arbre_binaire(arbre_binaire_contexte* contexte,
+                                           int jeton)
+{
+    if (jeton >= 0) {
+        atomic_fetch_sub(&contexte->concurrence->emplacements[jeton / 2]
+                          .lecteurs[jeton % 2], 1);
+    }
+}
+
+/**
+ *  \brief Commence une lecture d'un arbre en mode concurrent.
+ *
+ *  \param arbre : L'arbre à lire.
+ *
+ *  \return Le jeton à passer à sortir_lecture_arbre_binaire (-1 si
+ *          l'arbre n'est pas en mode concurrent).
+ */
+int entrer_lecture_arbre_binaire(arbre_binaire* arbre)
+{
+    int jeton = -1;
+
+    if (arbre) {
+        jeton = entrer_lecture_contexte_arbre_binaire(arbre->contexte);
+    }
+    return jeton;
+}
+
+/**
+ *  \brief Termine une lecture commencée par entrer_lecture_arbre_binaire.
+ *
+ *  \param arbre : L'arbre lu.
+ *  \param jeton : Le jeton reçu au début de la lecture.
+ */
+void sortir_lecture_arbre_binaire(arbre_binaire* arbre, int jeton)
+{
+    if (arbre) {
+        sortir_lecture_contexte_arbre_binaire(arbre->contexte, jeton);
+    }
+}
@@ -0,0 +1,358 @@
+/*
+
+    Copyright (c) 2015 Nicolas Bisson
+
+    L'autorisation est accordée, gracieusement, à toute personne acquérant une
+    copie de cette bibliothèque et des fichiers de documentation associés
+    (la "Bibliothèque"), de commercialiser la Bibliothèque sans restriction,
+    notamment les droits d'utiliser, de copier, de modifier, de fusionner, de
+    publier, de distribuer, de sous-licencier et / ou de vendre des copies de
+    la Bibliothèque, ainsi que d'autoriser les personnes auxquelles la
+    Bibliothèque est fournie à le faire, sous réserve des conditions suivantes:
+
+    La déclaration de copyright ci-dessus et la présente autorisation doivent
+    être incluses dans toutes copies ou parties substantielles de la
+    Bibliothèque.
+
+    LA BIBLIOTHÈQUE EST FOURNIE "TELLE QUELLE", SANS GARANTIE D'AUCUNE SORTE,
+    EXPLICITE OU IMPLICITE, NOTAMMENT SANS GARANTIE DE QUALITÉ MARCHANDE,
+    D’ADÉQUATION À UN USAGE PARTICULIER ET D'ABSENCE DE CONTREFAÇON. EN AUCUN
+    CAS, LES AUTEURS OU TITULAIRES DU DROIT D'AUTEUR NE SERONT RESPONSABLES DE
+    TOUT DOMMAGE, RÉCLAMATION OU AUTRE RESPONSABILITÉ, QUE CE SOIT DANS LE
+    CADRE D'UN CONTRAT, D'UN DÉLIT OU AUTRE, EN PROVENANCE DE, CONSÉCUTIF À OU
+    EN RELATION AVEC LA BIBLIOTHÈQUE OU SON UTILISATION, OU AVEC D'AUTRES
+    ÉLÉMENTS DE LA BIBLIOTHÈQUE.
+
+*/
+
+/**
+ *  \file arbre_binaire_construction.c
+ *
+ *  Construction d'un arbre binaire complet à partir de tableaux, sans
+ *  passer par les fonctions de création d'enfants. Chaque noeud est alloué
+ *  une seule fois en lisant les tableaux du début à la fin; avec l'option
+ *  ARBRE_BINAIRE_OPTION_ARENE, tous les noeuds sont réservés d'avance dans
+ *  une seule page.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "arbre_binaire.h"
+#include "arbre_binaire_interne.h"
+
+/**
+ *  \brief Réserve d'avance, dans une seule page de l'arène, les noeuds qui
+ *         seront ajoutés à la racine (rien si l'arbre n'utilise pas
+ *         d'arène).
+ *
+ *  \param arbre  : La racine de l'arbre.
+ *  \param nombre : Le nombre total de noeuds, racine comprise.
+ */
+static void reserver_noeuds(arbre_binaire* arbre, size_t nombre)
+{
+    if (arbre->contexte->options & ARBRE_BINAIRE_OPTION_ARENE && nombre > 1) {
+        reserver_arene(&arbre->contexte->arene, nombre - 1);
+    }
+}
+
+/**
+ *  \brief Vérifie qu'un arbre ordonné construit à partir de sa forme
+ *         respecte ses options, s'il n'y a pas déjà une erreur. Sinon,
+ *         une erreur est inscrite dans l'arbre.
+ *
+ *  \param arbre : La racine de l'arbre construit.
+ */
+static void verifier_construction(arbre_binaire* arbre)
+{
+    const char* erreur = NULL;
+
+    if (!a_erreur_arbre_binaire(arbre)) {
+        erreur = verifier_ordre_arbre_binaire(arbre);
+    }
+    if (erreur) {
+        inscrire_erreur_arbre_binaire(arbre, erreur);
+    }
+}
+
+/**
+ *  \brief Place les valeurs triées dans un sous-arbre équilibré: la valeur
+ *         du milieu va dans le noeud, les autres dans ses deux enfants. La
+ *         profondeur de la récursion est logarithmique.
+ *
+ *  \param noeud   : Le noeud (déjà alloué) qui reçoit le sous-arbre.
+ *  \param valeurs : Les valeurs du sous-arbre.
+ *  \param nombre  : Le nombre de valeurs (au moins une).
+ *
+ *  \return Faux s'il n'y a plus de mémoire.
+ */
+static bool remplir_equilibre(arbre_binaire* noeud, const int* valeurs,
+                              size_t nombre)
+{
+    arbre_binaire_contexte* contexte = noeud->contexte;
+    size_t milieu = nombre / 2;
+    bool memoire = true;
+
+    noeud->valeur = valeurs[milieu];
+    if (milieu > 0) {
+        noeud->premier_fils = allouer_noeud_arbre_binaire(contexte, 0);
+        memoire = noeud->premier_fils != NULL &&
+                  remplir_equilibre(noeud->premier_fils, valeurs, milieu);
+    }
+    if (memoire && nombre - milieu > 1) {
+        noeud->second_fils = allouer_noeud_arbre_binaire(contexte, 0);
+        memoire = noeud->second_fils != NULL &&
+                  remplir_equilibre(noeud->second_fils, valeurs + milieu + 1,
+                                    nombre - milieu - 1);
+    }
+    if (contexte->options & ARBRE_BINAIRE_OPTION_PARENT) {
+        if (noeud->premier_fils) {
+            NOEUD_PARENT(noeud->premier_fils)->parent = noeud;
+        }
+        if (noeud->second_fils) {
+            NOEUD_PARENT(noeud->second_fils)->parent = noeud;
+        }
+    }
+    if (contexte->options & ARBRE_BINAIRE_OPTION_AUGMENTE) {
+        calculer_noeud_etendu_arbre_binaire(noeud);
+    }
+    return memoire;
+}
+
+/**
+ *  \brief Construit un arbre équilibré dont le parcours infixe donne les
+ *         valeurs dans l'ordre du tableau.
+ *
+ *  \param valeurs : Les valeurs, triées en ordre croissant.
+ *  \param nombre  : Le nombre de valeurs.
+ *  \param options : Combinaison des options ARBRE_BINAIRE_OPTION_*.
+ *
+ *  \return Le nouvel arbre, ou NULL s'il n'y a aucune valeur ou plus de
+ *          mémoire.
+ */
+arbre_binaire* construire_trie_arbre_binaire(const int* valeurs,
+                                             size_t nombre,
+                                             unsigned int options)
+{
+    arbre_binaire* arbre = NULL;
+    int* uniques = NULL;
+    size_t doublons = 0;
+    size_t i;
+    size_t j;
+    bool trie = true;
+
+    for (i = 1; i < nombre; i = i + 1) {
+        if (valeurs[i] < valeurs[i - 1]) {
+            trie = false;
+        } else if (valeurs[i] == valeurs[i - 1]) {
+            doublons = doublons + 1;
+        }
+    }
+    if (nombre > 0) {
+        arbre = creer_arbre_binaire_options(valeurs[0], options);
+    }
+    if (arbre && arbre->contexte->options & ARBRE_BINAIRE_OPTION_ORDONNE) {
+        if (trie == false) {
+            inscrire_erreur_arbre_binaire(arbre, "Les valeurs ne sont pas \
+triees.");
+            return arbre;
+        }
+        /* Un arbre ordonné ne contient chaque valeur qu'une fois. */
+        if (doublons > 0) {
+            uniques = malloc((nombre - doublons) * sizeof(int));
+            if (uniques == NULL) {
+                inscrire_erreur_arbre_binaire(arbre, "Il n'y a plus de \
+memoire.");
+                return arbre;
+            }
+            uniques[0] = valeurs[0];
+            for (i = 1, j = 1; i < nombre; i = i + 1) {
+                if (valeurs[i] != valeurs[i - 1]) {
+                    uniques[j] = valeurs[i];
+                    j = j + 1;
+                }
+            }
+            valeurs = uniques;
+            nombre = nombre - doublons;
+        }
+    }
+    if (arbre) {
+        reserver_noeuds(arbre, nombre);
+        if (!remplir_equilibre(arbre, valeurs, nombre)) {
+            inscrire_erreur_arbre_binaire(arbre, "Il n'y a plus de \
+memoire.");
+        }
+    }
+    free(uniques);
+    return arbre;
+}
+
+/**
+ *  \brief Construit un arbre à partir de ses noeuds en ordre préfixe,
+ *         comme ils sont enregistrés dans un fichier.
+ *
+ *  \param valeurs : Les valeurs des noeuds, en ordre préfixe.
+ *  \param masques : Les enfants de chaque noeud: 1 pour le premier, 2 pour
+ *                   le second, 3 pour les deux et 0 pour une feuille.
+ *  \param nombre  : Le nombre de noeuds.
+ *  \param options : Combinaison des options ARBRE_BINAIRE_OPTION_*.
+ *
+ *  \return Le nouvel arbre, ou NULL s'il n'y a aucun noeud ou plus de
+ *          mémoire. Si les masques ne correspondent pas au nombre de
+ *          noeuds, une erreur est inscrite dans l'arbre.
+ *
+ *  \note  Pour un arbre ordonné, des valeurs qui ne sont pas strictement
+ *         croissantes en ordre infixe (ou, avec l'option EQUILIBRE, un
+ *         arbre qui n'est pas équilibré) laissent une erreur dans l'arbre.
+ */
+arbre_binaire* construire_prefixe_arbre_binaire(const int* valeurs,
+                                                const unsigned char* masques,
+                                                size_t nombre,
+                                                unsigned int options)
+{
+    struct arbre_binaire_pile pile;
+    struct arbre_binaire_element_pile element;
+    arbre_binaire* arbre = NULL;
+    arbre_binaire* noeud;
+    arbre_binaire** suivant;
+    size_t i = 0;
+    bool memoire = true;
+    bool valide = true;
+
+    if (nombre > 0) {
+        arbre = creer_arbre_binaire_options(valeurs[0], options);
+    }
+    if (arbre == NULL) {
+        return NULL;
+    }
+    reserver_noeuds(arbre, nombre);
+    initialiser_pile(&pile);
+    noeud = arbre;
+    while (noeud && memoire && valide) {
+        noeud->valeur = valeurs[i];
+        suivant = NULL;
+        if (masques[i] == 3) {
+            memoire = empiler_pile(&pile, noeud, 0, 0);
+        }
+        if (masques[i] == 1 || masques[i] == 3) {
+            suivant = &noeud->premier_fils;
+        } else if (masques[i] == 2) {
+            suivant = &noeud->second_fils;
+        } else if (masques[i] > 3) {
+            valide = false;
+        } else if (depiler_pile(&pile, &element)) {
+            suivant = &element.noeud->second_fils;
+        }
+        i = i + 1;
+        noeud = NULL;
+        if (suivant && i == nombre) {
+            valide = false;
+        } else if (suivant && memoire) {
+            *suivant = allouer_noeud_arbre_binaire(arbre->contexte, 0);
+            noeud = *suivant;
+            memoire = noeud != NULL;
+        }
+    }
+    vider_pile(&pile);
+    if (memoire == false) {
+        inscrire_erreur_arbre_binaire(arbre, "Il n'y a plus de memoire.");
+    } else if (valide == false || i != nombre) {
+        inscrire_erreur_arbre_binaire(arbre, "Les masques ne correspondent \
+pas aux valeurs.");
+    }
+    if (arbre->contexte->options & ARBRE_BINAIRE_OPTION_PARENT) {
+        recalculer_sous_arbre_binaire(arbre);
+    }
+    verifier_construction(arbre);
+    return arbre;
+}
+
+/**
+ *  \brief Indique si une position est occupée.
+ */
+static inline bool position_presente(const unsigned char* presences,
+                                     size_t position)
+{
+    return presences[position / 8] >> (position % 8) & 1;
+}
+
+/**
+ *  \brief Construit un arbre à partir de ses positions en ordre de
+ *         largeur: les enfants de la position i sont aux positions 2i + 1
+ *         et 2i + 2.
+ *
+ *  \param valeurs   : La valeur de chaque position.
+ *  \param presences : Un bit par position (le bit i % 8 de l'octet i / 8),
+ *                     à 1 si la position contient un noeud.
+ *  \param nombre    : Le nombre de positions.
+ *  \param options   : Combinaison des options ARBRE_BINAIRE_OPTION_*.
+ *
+ *  \return Le nouvel arbre, ou NULL si la racine est absente ou s'il n'y a
+ *          plus de mémoire. Si un noeud présent n'a pas de parent, une
+ *          erreur est inscrite dans l'arbre.
+ *
+ *  \note  Pour un arbre ordonné, des valeurs qui ne sont pas strictement
+ *         croissantes en ordre infixe (ou, avec l'option EQUILIBRE, un
+ *         arbre qui n'est pas équilibré) laissent une erreur dans l'arbre.
+ */
+arbre_binaire* construire_largeur_arbre_binaire(const int* valeurs,
+                                            const unsigned char* presences,
+                                            size_t nombre,
+                                            unsigned int options)
+{
+    arbre_binaire** parents;
+    arbre_binaire* arbre = NULL;
+    arbre_binaire* noeud = NULL;
+    arbre_binaire* parent;
+    size_t presents = 0;
+    size_t i;
+    bool memoire = true;
+    bool valide = true;
+
+    if (nombre == 0 || !position_presente(presences, 0)) {
+        return NULL;
+    }
+    for (i = 0; i < nombre; i = i + 1) {
+        presents = presents + position_presente(presences, i);
+    }
+    /* Seules les positions qui peuvent avoir des enfants sont conservées. */
+    parents = calloc(nombre / 2 + 1, sizeof(arbre_binaire*));
+    if (parents) {
+        arbre = creer_arbre_binaire_options(valeurs[0], options);
+    }
+    if (arbre) {
+        reserver_noeuds(arbre, presents);
+        parents[0] = arbre;
+        for (i = 1; i < nombre && memoire; i = i + 1) {
+            parent = parents[(i - 1) / 2];
+            noeud = NULL;
+            if (position_presente(presences, i) && parent == NULL) {
+                valide = false;
+            } else if (position_presente(presences, i)) {
+                noeud = allouer_noeud_arbre_binaire(arbre->contexte,
+                                                    valeurs[i]);
+                memoire = noeud != NULL;
+                if (i % 2 == 1) {
+                    parent->premier_fils = noeud;
+                } else {
+                    parent->second_fils = noeud;
+                }
+            }
+            if (i <= nombre / 2) {
+                parents[i] = noeud;
+            }
+        }
+        if (memoire == false) {
+            inscrire_erreur_arbre_binaire(arbre, "Il n'y a plus de memoire.");
+        } else if (valide == false) {
+            inscrire_erreur_arbre_binaire(arbre, "Un noeud present n'a pas de \
+parent.");
+        }
+        if (arbre->contexte->options & ARBRE_BINAIRE_OPTION_PARENT) {
+            recalculer_sous_arbre_binaire(arbre);
+        }
+        verifier_construction(arbre);
+    }
+    free(parents);
+    return arbre;
+}
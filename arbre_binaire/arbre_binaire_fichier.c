@@ -0,0 +1,1235 @@
+/*
+
+    Copyright (c) 2015 Nicolas Bisson
+
+    L'autorisation est accordée, gracieusement, à toute personne acquérant une
+    copie de cette bibliothèque et des fichiers de documentation associés
+    (la "Bibliothèque"), de commercialiser la Bibliothèque sans restriction,
+    notamment les droits d'utiliser, de copier, de modifier, de fusionner, de
+    publier, de distribuer, de sous-licencier et / ou de vendre des copies de
+    la Bibliothèque, ainsi que d'autoriser les personnes auxquelles la
+    Bibliothèque est fournie à le faire, sous réserve des conditions suivantes:
+
+    La déclaration de copyright ci-dessus et la présente autorisation doivent
+    être incluses dans toutes copies ou parties substantielles de la
+    Bibliothèque.
+
+    LA BIBLIOTHÈQUE EST FOURNIE "TELLE QUELLE", SANS GARANTIE D'AUCUNE SORTE,
+    EXPLICITE OU IMPLICITE, NOTAMMENT SANS GARANTIE DE QUALITÉ MARCHANDE,
+    D’ADÉQUATION À UN USAGE PARTICULIER ET D'ABSENCE DE CONTREFAÇON. EN AUCUN
+    CAS, LES AUTEURS OU TITULAIRES DU DROIT D'AUTEUR NE SERONT RESPONSABLES DE
+    TOUT DOMMAGE, RÉCLAMATION OU AUTRE RESPONSABILITÉ, QUE CE SOIT DANS LE
+    CADRE D'UN CONTRAT, D'UN DÉLIT OU AUTRE, EN PROVENANCE DE, CONSÉCUTIF À OU
+    EN RELATION AVEC LA BIBLIOTHÈQUE OU SON UTILISATION, OU AVEC D'AUTRES
+    ÉLÉMENTS DE LA BIBLIOTHÈQUE.
+
+*/
+
+/**
+ *  \file arbre_binaire_fichier.c
+ *
+ *  Lecture et écriture des fichiers d'arbre binaire. Au format 1, chaque
+ *  noeud est enregistré, en ordre préfixe, sous la forme de deux "int": sa
+ *  valeur et un masque indiquant ses enfants (1: premier, 2: second, 3: les
+ *  deux). Le format compact (version 2) est décrit à FORMAT_TAILLE_ENTETE.
+ *
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "arbre_binaire.h"
+#include "arbre_binaire_interne.h"
+
+#ifdef _WIN32
+#include <io.h>
+#define fsync _commit
+#else
+#include <sys/mman.h>
+#endif
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+
+/**
+ *  \brief Nombre d'octets accumulés en mémoire avant chaque écriture dans
+ *         le fichier (4 Mo).
+ */
+#define TAMPON_ECRITURE (1 << 22)
+
+/**
+ *  \brief Signature placée au début des fichiers au format compact.
+ */
+#define FORMAT_SIGNATURE "ABN2"
+
+/**
+ *  \brief Version du format compact.
+ */
+#define FORMAT_VERSION 2
+
+/**
+ *  \brief Taille de l'entête du format compact. L'entête contient, en
+ *         petit-boutiste: la signature (4 octets), la version (2 octets),
+ *         2 octets réservés, le nombre de noeuds (8 octets), la hauteur
+ *         (4 octets), 4 octets réservés et la taille des valeurs encodées
+ *         (8 octets). Viennent ensuite les masques (2 bits par noeud,
+ *         quatre par octet), les valeurs (différence avec la valeur
+ *         précédente, en zigzag et en entier de longueur variable) et la
+ *         somme de contrôle Adler-32 de tout ce qui précède.
+ */
+#define FORMAT_TAILLE_ENTETE 32
+
+/**
+ *  \brief Taille de la somme de contrôle à la fin du format compact.
+ */
+#define FORMAT_TAILLE_SOMME 4
+
+/**
+ *  \brief Plus grand nombre d'octets traités par la somme de contrôle
+ *         avant de devoir réduire ses deux accumulateurs.
+ */
+#define SOMME_BLOC 5552
+
+/**
+ *  \brief Modulo de la somme de contrôle Adler-32.
+ */
+#define SOMME_MODULO 65521
+
+/**
+ *  \brief Résultat de la lecture d'un enregistrement.
+ */
+enum lecture_enregistrement {
+    ENREGISTREMENT_LU,
+    ENREGISTREMENT_MANQUANT,
+    ENREGISTREMENT_CORROMPU
+};
+
+/**
+ *  \brief Position de lecture dans le contenu d'un fichier d'arbre
+ *         binaire, quel que soit son format.
+ */
+struct source_enregistrements {
+    int format;                    /**< 1 ou 2. */
+    const unsigned char* courant;  /**< Prochain enregistrement (format 1)
+                                        ou prochaine valeur (format 2). */
+    const unsigned char* fin;      /**< Fin des enregistrements ou des
+                                        valeurs. */
+    const unsigned char* masques;  /**< Masques du format 2. */
+    size_t indice;                 /**< Noeuds déjà lus. */
+    size_t nombre;                 /**< Noeuds annoncés par l'entête. */
+    int hauteur;                   /**< Hauteur annoncée par l'entête. */
+    long long precedente;          /**< Dernière valeur lue (format 2). */
+};
+
+/**
+ *  \brief Ajoute des octets à une somme de contrôle Adler-32.
+ *
+ *  \param somme  : La somme à mettre à jour (1 pour une somme vide).
+ *  \param octets : Les octets à ajouter.
+ *  \param taille : Le nombre d'octets.
+ *
+ *  \return La nouvelle somme.
+ */
+static uint32_t calculer_somme(uint32_t somme, const unsigned char* octets,
+                               size_t taille)
+{
+    uint32_t a = somme & 0xFFFF;
+    uint32_t b = somme >> 16;
+    size_t bloc;
+    size_t i;
+
+    while (taille > 0) {
+        bloc = taille < SOMME_BLOC ? taille : SOMME_BLOC;
+        for (i = 0; i < bloc; i = i + 1) {
+            a = a + octets[i];
+            b = b + a;
+        }
+        a = a % SOMME_MODULO;
+        b = b % SOMME_MODULO;
+        octets = octets + bloc;
+        taille = taille - bloc;
+    }
+    return (b << 16) | a;
+}
+
+/**
+ *  \brief Combine les sommes de contrôle de deux suites d'octets en celle
+ *         de leur concaténation.
+ *
+ *  \param premiere : La somme de la première suite.
+ *  \param seconde  : La somme de la seconde suite.
+ *  \param taille   : La taille de la seconde suite.
+ *
+ *  \return La somme de la concaténation.
+ */
+static uint32_t combiner_sommes(uint32_t premiere, uint32_t seconde,
+                                uint64_t taille)
+{
+    uint32_t reste = (uint32_t)(taille % SOMME_MODULO);
+    uint32_t a = premiere & 0xFFFF;
+    uint32_t b = (uint32_t)(((uint64_t)reste * a) % SOMME_MODULO);
+
+    a = a + (seconde & 0xFFFF) + SOMME_MODULO - 1;
+    b = b + (premiere >> 16) + (seconde >> 16) + SOMME_MODULO - reste;
+    while (a >= SOMME_MODULO) {
+        a = a - SOMME_MODULO;
+    }
+    while (b >= SOMME_MODULO) {
+        b = b - SOMME_MODULO;
+    }
+    return (b << 16) | a;
+}
+
+/**
+ *  \brief Lit un entier petit-boutiste non signé.
+ *
+ *  \param octets : Le premier octet de l'entier.
+ *  \param taille : Le nombre d'octets de l'entier.
+ *
+ *  \return La valeur de l'entier.
+ */
+static uint64_t lire_entier(const unsigned char* octets, int taille)
+{
+    uint64_t valeur = 0;
+
+    while (taille > 0) {
+        taille = taille - 1;
+        valeur = (valeur << 8) | octets[taille];
+    }
+    return valeur;
+}
+
+/**
+ *  \brief Écrit un entier petit-boutiste non signé.
+ *
+ *  \param octets : Reçoit l'entier.
+ *  \param valeur : La valeur à écrire.
+ *  \param taille : Le nombre d'octets de l'entier.
+ */
+static void placer_entier(unsigned char* octets, uint64_t valeur, int taille)
+{
+    int i;
+
+    for (i = 0; i < taille; i = i + 1) {
+        octets[i] = (unsigned char)(valeur >> (8 * i));
+    }
+}
+
+/**
+ *  \brief Prépare la lecture du contenu d'un fichier. Le format compact
+ *         est reconnu par sa signature; tout autre contenu est lu comme
+ *         une suite de paires de "int" (format 1).
+ *
+ *  \param source  : Reçoit la position de lecture.
+ *  \param donnees : Le contenu du fichier.
+ *  \param taille  : La taille du contenu.
+ *
+ *  \return Faux si le fichier est au format compact mais que son entête
+ *          ou sa somme de contrôle ne correspond pas à son contenu; la
+ *          position de lecture n'est alors pas remplie.
+ */
+static bool ouvrir_source(struct source_enregistrements* source,
+                          const unsigned char* donnees, size_t taille)
+{
+    uint64_t nombre;
+    uint64_t taille_valeurs;
+    uint64_t taille_masques;
+    uint64_t hauteur;
+    bool valide = true;
+
+    memset(source, 0, sizeof(*source));
+    if (taille >= FORMAT_TAILLE_ENTETE + FORMAT_TAILLE_SOMME &&
+        memcmp(donnees, FORMAT_SIGNATURE, 4) == 0 &&
+        lire_entier(donnees + 4, 2) == FORMAT_VERSION) {
+        source->format = 2;
+        nombre = lire_entier(donnees + 8, 8);
+        hauteur = lire_entier(donnees + 16, 4);
+        taille_valeurs = lire_entier(donnees + 24, 8);
+        taille_masques = nombre / 4 + (nombre % 4 != 0);
+        valide = nombre > 0 && hauteur <= nombre && hauteur <= INT_MAX &&
+                 nombre <= taille &&
+                 taille_valeurs <= taille &&
+                 FORMAT_TAILLE_ENTETE + taille_masques + taille_valeurs +
+                 FORMAT_TAILLE_SOMME == taille;
+        if (valide) {
+            valide = calculer_somme(1, donnees,
+                                    taille - FORMAT_TAILLE_SOMME) ==
+                     lire_entier(donnees + taille - FORMAT_TAILLE_SOMME, 4);
+        }
+        if (valide) {
+            /* Les tailles de l'entête ne désignent le contenu qu'une fois
+               vérifiées. */
+            source->masques = donnees + FORMAT_TAILLE_ENTETE;
+            source->courant = source->masques + taille_masques;
+            source->fin = source->courant + taille_valeurs;
+            source->nombre = nombre;
+            source->hauteur = (int)hauteur;
+        }
+    } else {
+        source->format = 1;
+        source->courant = donnees;
+        source->fin = donnees + taille - taille % (2 * sizeof(int));
+        source->nombre = taille / (2 * sizeof(int));
+    }
+    return valide;
+}
+
+/**
+ *  \brief Lit l'enregistrement (valeur et masque) du prochain noeud.
+ *
+ *  \param source : La position de lecture.
+ *  \param valeur : Reçoit la valeur du noeud.
+ *  \param masque : Reçoit le masque des enfants du noeud.
+ *
+ *  \return ENREGISTREMENT_LU, ou la raison pour laquelle rien n'a été lu.
+ */
+static inline enum lecture_enregistrement lire_enregistrement(
+        struct source_enregistrements* source, int* valeur, int* masque)
+{
+    enum lecture_enregistrement resultat = ENREGISTREMENT_LU;
+    uint64_t code = 0;
+    int decalage = 0;
+    long long nouvelle;
+    int enregistrement[2];
+
+    if (source->format == 1) {
+        if (source->courant == source->fin) {
+            resultat = ENREGISTREMENT_MANQUANT;
+        } else {
+            memcpy(enregistrement, source->courant, sizeof(enregistrement));
+            source->courant = source->courant + sizeof(enregistrement);
+            *valeur = enregistrement[0];
+            *masque = enregistrement[1];
+        }
+    } else if (source->indice == source->nombre) {
+        resultat = ENREGISTREMENT_CORROMPU;
+    } else {
+        *masque = (source->masques[source->indice / 4] >>
+                   (2 * (source->indice % 4))) & 3;
+        do {
+            if (source->courant == source->fin || decalage >= 35) {
+                resultat = ENREGISTREMENT_CORROMPU;
+            } else {
+                code = code | (uint64_t)(*source->courant & 0x7F) << decalage;
+                decalage = decalage + 7;
+                source->courant = source->courant + 1;
+            }
+        } while (resultat == ENREGISTREMENT_LU && source->courant[-1] & 0x80);
+        if (code & 1) {
+            nouvelle = source->precedente - (long long)(code >> 1) - 1;
+        } else {
+            nouvelle = source->precedente + (long long)(code >> 1);
+        }
+        if (nouvelle < INT_MIN || nouvelle > INT_MAX) {
+            resultat = ENREGISTREMENT_CORROMPU;
+        }
+        source->precedente = nouvelle;
+        source->indice = source->indice + 1;
+        *valeur = (int)nouvelle;
+    }
+    if (resultat == ENREGISTREMENT_LU && (*masque < 0 || *masque > 3)) {
+        resultat = ENREGISTREMENT_CORROMPU;
+    }
+    return resultat;
+}
+
+/**
+ *  \brief Lecture séquentielle d'un fichier. La pile conserve la
+ *         profondeur des seconds enfants qui restent à lire.
+ */
+struct arbre_binaire_flux_struct {
+    struct arbre_binaire_projection projection;
+    struct source_enregistrements source;
+    struct arbre_binaire_pile pile;
+    int profondeur;             /**< Profondeur du prochain noeud, 0 à la
+                                     fin du flux. */
+    bool entame;                /**< Au moins un noeud a été lu. */
+    bool a_erreur;
+    char erreur[ERREUR_TAILLE];
+};
+
+/**
+ *  \brief Construit l'arbre à partir des enregistrements du fichier. Les
+ *         noeuds sont enregistrés en ordre préfixe; la pile conserve les
+ *         noeuds dont le second enfant reste à lire.
+ *
+ *  \param arbre  : L'arbre (déjà alloué) qui reçoit la racine.
+ *  \param source : La position de lecture des enregistrements.
+ *
+ *  \note  L'arbre ne doit pas être NULL.
+ */
+static void lire_enregistrements(arbre_binaire* arbre,
+                                 struct source_enregistrements* source)
+{
+    struct arbre_binaire_pile pile;
+    struct arbre_binaire_element_pile element;
+    arbre_binaire_contexte* contexte = arbre->contexte;
+    arbre_binaire* noeud = arbre;
+    arbre_binaire** suivant;
+    enum lecture_enregistrement resultat = ENREGISTREMENT_LU;
+    int valeur;
+    int masque;
+    bool valide = true;
+
+    initialiser_pile(&pile);
+    while (noeud && valide) {
+        resultat = lire_enregistrement(source, &valeur, &masque);
+        valide = resultat == ENREGISTREMENT_LU;
+        suivant = NULL;
+        if (valide) {
+            noeud->valeur = valeur;
+            if (masque == 3) {
+                valide = empiler_pile(&pile, noeud, 0, 0);
+            }
+            if (masque == 1 || masque == 3) {
+                suivant = &noeud->premier_fils;
+            } else if (masque == 2) {
+                suivant = &noeud->second_fils;
+            } else if (depiler_pile(&pile, &element)) {
+                suivant = &element.noeud->second_fils;
+            }
+        }
+        noeud = NULL;
+        if (suivant && valide) {
+            *suivant = allouer_noeud_arbre_binaire(contexte, 0);
+            noeud = *suivant;
+            valide = noeud != NULL;
+        }
+    }
+    if (valide && source->format == 2 &&
+        (source->indice != source->nombre || source->courant != source->fin)) {
+        resultat = ENREGISTREMENT_CORROMPU;
+    }
+    if (resultat == ENREGISTREMENT_MANQUANT) {
+        inscrire_erreur_arbre_binaire(arbre, "Le fichier est incomplet.");
+    } else if (resultat == ENREGISTREMENT_CORROMPU) {
+        inscrire_erreur_arbre_binaire(arbre, "Le fichier est corrompu.");
+    } else if (valide == false) {
+        inscrire_erreur_arbre_binaire(arbre, "Il n'y a plus de memoire.");
+    }
+    vider_pile(&pile);
+    if (contexte->options & ARBRE_BINAIRE_OPTION_PARENT) {
+        recalculer_sous_arbre_binaire(arbre);
+    }
+}
+
+/**
+ *  \brief Rend le contenu complet d'un fichier accessible en mémoire. Le
+ *         fichier est projeté en mémoire (mmap) lorsque le système le
+ *         permet, sinon il est lu d'un seul bloc.
+ *
+ *  \param projection  : Reçoit l'adresse et la taille du contenu.
+ *  \param nom_fichier : Le nom du fichier à lire.
+ *
+ *  \return Faux si le fichier ne peut pas être lu.
+ */
+bool projeter_fichier(struct arbre_binaire_projection* projection,
+                      const char* nom_fichier)
+{
+    struct stat etat;
+    int descripteur;
+    bool reussi = false;
+    char* donnees;
+    ssize_t lu;
+    size_t total;
+
+    projection->donnees = NULL;
+    projection->taille = 0;
+    projection->projete = false;
+    descripteur = open(nom_fichier, O_RDONLY | O_BINARY);
+    if (descripteur >= 0 && fstat(descripteur, &etat) == 0) {
+        projection->taille = etat.st_size;
+        reussi = true;
+#ifndef _WIN32
+        if (projection->taille > 0) {
+            donnees = mmap(NULL, projection->taille, PROT_READ, MAP_PRIVATE,
+                           descripteur, 0);
+            if (donnees != MAP_FAILED) {
+                STATISTIQUE_AJOUTER(lectures, 1);
+                STATISTIQUE_AJOUTER(octets_lus, projection->taille);
+#ifdef MADV_SEQUENTIAL
+                madvise(donnees, projection->taille, MADV_SEQUENTIAL);
+#endif
+                projection->donnees = donnees;
+                projection->projete = true;
+            }
+        }
+#endif
+        if (projection->projete == false && projection->taille > 0) {
+            donnees = malloc(projection->taille);
+            total = 0;
+            while (donnees && total < projection->taille) {
+                lu = read(descripteur, donnees + total,
+                          projection->taille - total);
+                STATISTIQUE_AJOUTER(lectures, 1);
+                if (lu > 0) {
+                    STATISTIQUE_AJOUTER(octets_lus, lu);
+                    total = total + lu;
+                } else if (lu == 0 || errno != EINTR) {
+                    free(donnees);
+                    donnees = NULL;
+                }
+            }
+            projection->donnees = donnees;
+            reussi = donnees != NULL;
+        }
+    }
+    if (descripteur >= 0) {
+        close(descripteur);
+    }
+    return reussi;
+}
+
+/**
+ *  \brief Libère le contenu obtenu par projeter_fichier.
+ *
+ *  \param projection : Le contenu à libérer.
+ */
+void liberer_projection(struct arbre_binaire_projection* projection)
+{
+#ifndef _WIN32
+    if (projection->projete) {
+        munmap((void*)projection->donnees, projection->taille);
+    } else {
+        free((void*)projection->donnees);
+    }
+#else
+    free((void*)projection->donnees);
+#endif
+    projection->donnees = NULL;
+    projection->taille = 0;
+}
+
+/**
+ *  \brief Vérifie qu'un arbre ordonné chargé tel qu'il a été enregistré
+ *         respecte ses options, s'il n'y a pas déjà une erreur. Sinon, une
+ *         erreur est inscrite dans l'arbre.
+ *
+ *  \param arbre : La racine de l'arbre chargé.
+ */
+static void verifier_chargement(arbre_binaire* arbre)
+{
+    const char* erreur = NULL;
+
+    if (!a_erreur_arbre_binaire(arbre)) {
+        erreur = verifier_ordre_arbre_binaire(arbre);
+    }
+    if (erreur == NULL) {
+    } else if (arbre->contexte->options & ARBRE_BINAIRE_OPTION_EQUILIBRE) {
+        inscrire_erreur_arbre_binaire(arbre, "Le fichier ne contient pas un \
+arbre ordonne et equilibre.");
+    } else {
+        inscrire_erreur_arbre_binaire(arbre, "Le fichier ne contient pas un \
+arbre ordonne.");
+    }
+}
+
+/**
+ *  \brief Récupère les données d'un fichier pour créer un arbre binaire.
+ *
+ *  \param nom_fichier : Le nom du fichier qui contient les données.
+ *
+ *  \return Un nouvel arbre binaire créé à l'aide des données d'un fichier.
+ */
+arbre_binaire* charger_arbre_binaire(char *nom_fichier)
+{
+    return charger_arbre_binaire_options(nom_fichier, 0);
+}
+
+/**
+ *  \brief Récupère les données d'un fichier pour créer un arbre binaire
+ *         en précisant son mode de fonctionnement.
+ *
+ *  \param nom_fichier : Le nom du fichier qui contient les données.
+ *  \param options     : Combinaison des options ARBRE_BINAIRE_OPTION_*.
+ *
+ *  \return Un nouvel arbre binaire créé à l'aide des données d'un fichier.
+ *          Un arbre ordonné (ou équilibré) est vérifié après la lecture.
+ */
+arbre_binaire* charger_arbre_binaire_options(char *nom_fichier,
+                                             unsigned int options)
+{
+    struct arbre_binaire_projection projection;
+    struct source_enregistrements source;
+    arbre_binaire* arbre;
+
+    STATISTIQUE_DEBUT(ARBRE_BINAIRE_FONCTION_CHARGER);
+    arbre = creer_arbre_binaire_options(0, options);
+    if (arbre) {
+        if (projeter_fichier(&projection, nom_fichier)) {
+            if (ouvrir_source(&source,
+                              (const unsigned char*)projection.donnees,
+                              projection.taille)) {
+                if (options & ARBRE_BINAIRE_OPTION_ARENE && source.nombre > 1) {
+                    reserver_arene(&arbre->contexte->arene, source.nombre - 1);
+                }
+                lire_enregistrements(arbre, &source);
+                verifier_chargement(arbre);
+            } else {
+                inscrire_erreur_arbre_binaire(arbre, "Le fichier est \
+corrompu.");
+            }
+            liberer_projection(&projection);
+        } else {
+            inscrire_erreur_arbre_binaire(arbre, "Il est impossible de lire \
+ce fichier.");
+        }
+    }
+    STATISTIQUE_FIN();
+
+    return arbre;
+}
+
+/**
+ *  \brief Place un message d'erreur dans le flux et termine sa lecture.
+ *
+ *  \param flux   : Le flux en erreur.
+ *  \param erreur : Le message d'erreur.
+ */
+static void inscrire_erreur_flux(arbre_binaire_flux* flux, const char* erreur)
+{
+    flux->a_erreur = true;
+    strncpy(flux->erreur, erreur, ERREUR_TAILLE - 1);
+    flux->erreur[ERREUR_TAILLE - 1] = '\0';
+    flux->profondeur = 0;
+}
+
+/**
+ *  \brief Ouvre un fichier d'arbre binaire (format 1 ou compact) pour le
+ *         lire noeud par noeud. Le fichier est projeté en mémoire et seule
+ *         la profondeur des seconds enfants en attente est conservée.
+ *
+ *  \param nom_fichier : Le nom du fichier à lire.
+ *
+ *  \return Le flux (NULL s'il n'y a plus de mémoire). Si le fichier ne
+ *          peut pas être lu, le flux est vide et contient une erreur.
+ */
+arbre_binaire_flux* ouvrir_flux_arbre_binaire(char* nom_fichier)
+{
+    arbre_binaire_flux* flux;
+
+    flux = malloc(sizeof(arbre_binaire_flux));
+    if (flux) {
+        flux->a_erreur = false;
+        flux->erreur[0] = '\0';
+        flux->profondeur = 0;
+        flux->entame = false;
+        initialiser_pile(&flux->pile);
+        if (!projeter_fichier(&flux->projection, nom_fichier)) {
+            inscrire_erreur_flux(flux, "Il est impossible de lire ce \
+fichier.");
+        } else if (!ouvrir_source(&flux->source,
+                                  (const unsigned char*)flux->projection.donnees,
+                                  flux->projection.taille)) {
+            inscrire_erreur_flux(flux, "Le fichier est corrompu.");
+        } else {
+            flux->profondeur = 1;
+        }
+    }
+    return flux;
+}
+
+/**
+ *  \brief Lit le prochain noeud du flux, en ordre préfixe.
+ *
+ *  \param flux       : Le flux à lire.
+ *  \param valeur     : Reçoit la valeur du noeud.
+ *  \param profondeur : Reçoit la profondeur du noeud (1 pour la racine).
+ *  \param masque     : Reçoit les enfants du noeud (1: premier, 2: second,
+ *                      3: les deux).
+ *
+ *  \return Faux à la fin du flux ou en cas d'erreur.
+ */
+bool lire_flux_arbre_binaire(arbre_binaire_flux* flux, int* valeur,
+                             int* profondeur, int* masque)
+{
+    struct arbre_binaire_element_pile element;
+    enum lecture_enregistrement resultat = ENREGISTREMENT_LU;
+    struct source_enregistrements* source = &flux->source;
+    bool lu = false;
+
+    if (flux->profondeur > 0) {
+        flux->entame = true;
+        resultat = lire_enregistrement(source, valeur, masque);
+        if (resultat == ENREGISTREMENT_LU) {
+            lu = true;
+            *profondeur = flux->profondeur;
+            if (*masque == 3 && !empiler_pile(&flux->pile, NULL,
+                                              flux->profondeur + 1, 0)) {
+                inscrire_erreur_flux(flux, "Il n'y a plus de memoire.");
+                lu = false;
+            } else if (*masque != 0) {
+                flux->profondeur = flux->profondeur + 1;
+            } else if (depiler_pile(&flux->pile, &element)) {
+                flux->profondeur = element.profondeur;
+            } else {
+                flux->profondeur = 0;
+                if (source->format == 2 && (source->indice != source->nombre ||
+                                            source->courant != source->fin)) {
+                    resultat = ENREGISTREMENT_CORROMPU;
+                }
+            }
+        }
+        if (resultat == ENREGISTREMENT_MANQUANT) {
+            inscrire_erreur_flux(flux, "Le fichier est incomplet.");
+        } else if (resultat == ENREGISTREMENT_CORROMPU) {
+            inscrire_erreur_flux(flux, "Le fichier est corrompu.");
+        }
+    }
+    return lu;
+}
+
+/**
+ *  \brief Ferme le flux et libère sa mémoire.
+ *
+ *  \param flux : Le flux à fermer.
+ */
+void fermer_flux_arbre_binaire(arbre_binaire_flux* flux)
+{
+    if (flux) {
+        vider_pile(&flux->pile);
+        liberer_projection(&flux->projection);
+        free(flux);
+    }
+}
+
+/**
+ *  \brief Indique s'il y a une erreur dans le flux.
+ *
+ *  \param flux : Le flux à vérifier.
+ *
+ *  \return Vrai s'il y a erreur et Faux en cas inverse.
+ */
+bool a_erreur_flux_arbre_binaire(arbre_binaire_flux* flux)
+{
+    return flux->a_erreur;
+}
+
+/**
+ *  \brief Indique le texte de l'erreur qui est dans le flux.
+ *
+ *  \param flux : Le flux à vérifier.
+ *
+ *  \return Le texte de l'erreur (vide s'il n'y a pas d'erreur).
+ */
+char* erreur_flux_arbre_binaire(arbre_binaire_flux* flux)
+{
+    if (flux->a_erreur == false) {
+        flux->erreur[0] = '\0';
+    }
+    return flux->erreur;
+}
+
+/**
+ *  \brief Compte les noeuds qui restent dans le flux. Le flux est lu
+ *         jusqu'à la fin. Pour un fichier compact qui n'a pas été entamé,
+ *         le nombre de noeuds de l'entête est utilisé directement.
+ *
+ *  \param flux : Le flux à lire.
+ *
+ *  \return Le nombre de noeuds lus.
+ */
+int nombre_elements_flux_arbre_binaire(arbre_binaire_flux* flux)
+{
+    int nombre = 0;
+    int valeur, profondeur, masque;
+
+    if (flux->profondeur > 0 && flux->entame == false &&
+        flux->source.format == 2 && flux->source.nombre <= INT_MAX) {
+        nombre = (int)flux->source.nombre;
+        flux->profondeur = 0;
+    }
+    while (lire_flux_arbre_binaire(flux, &valeur, &profondeur, &masque)) {
+        nombre = nombre + 1;
+    }
+    return nombre;
+}
+
+/**
+ *  \brief Compte les feuilles qui restent dans le flux. Le flux est lu
+ *         jusqu'à la fin.
+ *
+ *  \param flux : Le flux à lire.
+ *
+ *  \return Le nombre de feuilles lues.
+ */
+int nombre_feuilles_flux_arbre_binaire(arbre_binaire_flux* flux)
+{
+    int nombre = 0;
+    int valeur, profondeur, masque;
+
+    while (lire_flux_arbre_binaire(flux, &valeur, &profondeur, &masque)) {
+        if (masque == 0) {
+            nombre = nombre + 1;
+        }
+    }
+    return nombre;
+}
+
+/**
+ *  \brief Trouve la plus grande profondeur des noeuds qui restent dans le
+ *         flux. Le flux est lu jusqu'à la fin. Pour un fichier compact qui
+ *         n'a pas été entamé, la hauteur de l'entête est utilisée
+ *         directement.
+ *
+ *  \param flux : Le flux à lire.
+ *
+ *  \return La hauteur de l'arbre lorsque le flux vient d'être ouvert.
+ */
+int hauteur_flux_arbre_binaire(arbre_binaire_flux* flux)
+{
+    int hauteur = 0;
+    int valeur, profondeur, masque;
+
+    if (flux->profondeur > 0 && flux->entame == false &&
+        flux->source.format == 2) {
+        hauteur = flux->source.hauteur;
+        flux->profondeur = 0;
+    }
+    while (lire_flux_arbre_binaire(flux, &valeur, &profondeur, &masque)) {
+        if (profondeur > hauteur) {
+            hauteur = profondeur;
+        }
+    }
+    return hauteur;
+}
+
+/**
+ *  \brief Cherche une valeur dans le flux. La lecture s'arrête au premier
+ *         noeud qui contient la valeur.
+ *
+ *  \param flux   : Le flux à lire.
+ *  \param valeur : La valeur à chercher.
+ *
+ *  \return Vrai si un noeud lu contient la valeur.
+ */
+bool contient_element_flux_arbre_binaire(arbre_binaire_flux* flux,
+                                         int valeur)
+{
+    bool trouve = false;
+    int lue, profondeur, masque;
+
+    while (trouve == false &&
+           lire_flux_arbre_binaire(flux, &lue, &profondeur, &masque)) {
+        trouve = lue == valeur;
+    }
+    return trouve;
+}
+
+/**
+ *  \brief Écrit tout le contenu d'un tampon dans un fichier.
+ *
+ *  \param descripteur : Le fichier dans lequel écrire.
+ *  \param tampon      : Les données à écrire.
+ *  \param taille      : Le nombre d'octets à écrire.
+ *
+ *  \return Faux si l'écriture a échoué.
+ */
+static bool ecrire_tampon(int descripteur, const char* tampon, size_t taille)
+{
+    ssize_t ecrit;
+    bool reussi = true;
+
+    while (reussi && taille > 0) {
+        ecrit = write(descripteur, tampon, taille);
+        STATISTIQUE_AJOUTER(ecritures, 1);
+        if (ecrit > 0) {
+            STATISTIQUE_AJOUTER(octets_ecrits, ecrit);
+            tampon = tampon + ecrit;
+            taille = taille - ecrit;
+        } else if (ecrit < 0 && errno != EINTR) {
+            reussi = false;
+        }
+    }
+    return reussi;
+}
+
+/**
+ *  \brief Tampon d'écriture d'un fichier.
+ */
+struct tampon_ecriture {
+    int descripteur;         /**< Le fichier dans lequel écrire. */
+    unsigned char* octets;   /**< Les octets en attente d'écriture. */
+    size_t nombre;           /**< Le nombre d'octets en attente. */
+    bool calculer;           /**< Les octets écrits entrent dans la somme. */
+    uint32_t somme;          /**< La somme de contrôle des octets écrits. */
+    bool reussi;             /**< Faux dès qu'une écriture échoue. */
+};
+
+/**
+ *  \brief Écrit dans le fichier les octets en attente dans le tampon.
+ *
+ *  \param tampon : Le tampon d'écriture.
+ */
+static void vider_tampon(struct tampon_ecriture* tampon)
+{
+    if (tampon->reussi && tampon->nombre > 0) {
+        if (tampon->calculer) {
+            tampon->somme = calculer_somme(tampon->somme, tampon->octets,
+                                           tampon->nombre);
+        }
+        tampon->reussi = ecrire_tampon(tampon->descripteur,
+                                       (const char*)tampon->octets,
+                                       tampon->nombre);
+    }
+    tampon->nombre = 0;
+}
+
+/**
+ *  \brief S'assure qu'il reste de la place dans le tampon.
+ *
+ *  \param tampon : Le tampon d'écriture.
+ *  \param taille : Le nombre d'octets qui seront ajoutés.
+ *
+ *  \return L'endroit où placer les octets.
+ */
+static inline unsigned char* reserver_tampon(struct tampon_ecriture* tampon,
+                                             size_t taille)
+{
+    if (tampon->nombre + taille > TAMPON_ECRITURE) {
+        vider_tampon(tampon);
+    }
+    return tampon->octets + tampon->nombre;
+}
+
+/**
+ * \brief Parcours préfixe de l'arbre à écrire: avec une pile des seconds
+ *        enfants qui restent à parcourir, ou sans pile (Morris) si l'arbre
+ *        a été créé avec ARBRE_BINAIRE_OPTION_MORRIS.
+ */
+struct parcours_ecriture {
+    struct arbre_binaire_pile pile;
+    struct arbre_binaire_morris morris;
+    bool sans_pile;
+};
+
+/**
+ *  \brief Commence le parcours préfixe de l'arbre à écrire.
+ *
+ *  \param parcours   : Le parcours.
+ *  \param arbre      : L'arbre à écrire.
+ *  \param profondeur : Reçoit la profondeur de la racine.
+ *
+ *  \return La racine.
+ */
+static arbre_binaire* commencer_ecriture(struct parcours_ecriture* parcours,
+                                         arbre_binaire* arbre,
+                                         int* profondeur)
+{
+    initialiser_pile(&parcours->pile);
+    parcours->sans_pile = ordre_lecture_arbre_binaire(arbre) ==
+                          ARBRE_BINAIRE_PREFIXE_MORRIS;
+    *profondeur = 1;
+    if (parcours->sans_pile) {
+        commencer_morris_arbre_binaire(&parcours->morris, arbre, false);
+        arbre = suivant_morris_arbre_binaire(&parcours->morris, profondeur);
+    }
+    return arbre;
+}
+
+/**
+ *  \brief Termine le parcours de l'arbre à écrire, même inachevé.
+ *
+ *  \param parcours : Le parcours.
+ */
+static void terminer_ecriture(struct parcours_ecriture* parcours)
+{
+    if (parcours->sans_pile) {
+        terminer_morris_arbre_binaire(&parcours->morris);
+    }
+    vider_pile(&parcours->pile);
+}
+
+/**
+ *  \brief Passe au noeud suivant en ordre préfixe.
+ *
+ *  \param parcours   : Le parcours.
+ *  \param noeud      : Le noeud courant.
+ *  \param profondeur : La profondeur du noeud courant, puis du suivant.
+ *  \param memoire    : Devient faux si la pile ne peut pas grandir.
+ *
+ *  \return Le noeud suivant, ou NULL à la fin du parcours.
+ */
+static inline arbre_binaire* noeud_suivant(struct parcours_ecriture* parcours,
+                                           arbre_binaire* noeud,
+                                           int* profondeur, bool* memoire)
+{
+    struct arbre_binaire_pile* pile = &parcours->pile;
+    struct arbre_binaire_element_pile element;
+    arbre_binaire* suivant = NULL;
+
+    if (parcours->sans_pile) {
+        suivant = suivant_morris_arbre_binaire(&parcours->morris, profondeur);
+    } else if (noeud->premier_fils) {
+        if (noeud->second_fils &&
+            !empiler_pile(pile, noeud->second_fils, *profondeur + 1, 0)) {
+            *memoire = false;
+        }
+        suivant = noeud->premier_fils;
+        *profondeur = *profondeur + 1;
+    } else if (noeud->second_fils) {
+        suivant = noeud->second_fils;
+        *profondeur = *profondeur + 1;
+    } else if (depiler_pile(pile, &element)) {
+        suivant = element.noeud;
+        *profondeur = element.profondeur;
+    }
+    return suivant;
+}
+
+/**
+ *  \brief Indique quels enfants possède un noeud.
+ *
+ *  \param noeud : Le noeud.
+ *
+ *  \return 1 pour le premier, 2 pour le second, 3 pour les deux.
+ */
+static inline int masque_noeud(arbre_binaire* noeud)
+{
+    return (noeud->premier_fils ? 1 : 0) | (noeud->second_fils ? 2 : 0);
+}
+
+/**
+ *  \brief Écrit les noeuds au format 1: une paire de "int" (valeur et
+ *         masque) par noeud, en ordre préfixe.
+ *
+ *  \param arbre  : L'arbre à enregistrer.
+ *  \param tampon : Le tampon d'écriture.
+ *
+ *  \return Faux s'il n'y a plus de mémoire.
+ */
+static bool ecrire_format_1(arbre_binaire* arbre,
+                            struct tampon_ecriture* tampon)
+{
+    struct parcours_ecriture parcours;
+    arbre_binaire* noeud;
+    int enregistrement[2];
+    int profondeur;
+    bool memoire = true;
+
+    noeud = commencer_ecriture(&parcours, arbre, &profondeur);
+    while (noeud && memoire && tampon->reussi) {
+        enregistrement[0] = LIRE_VALEUR(noeud);
+        enregistrement[1] = masque_noeud(noeud);
+        memcpy(reserver_tampon(tampon, sizeof(enregistrement)),
+               enregistrement, sizeof(enregistrement));
+        tampon->nombre = tampon->nombre + sizeof(enregistrement);
+        noeud = noeud_suivant(&parcours, noeud, &profondeur, &memoire);
+    }
+    terminer_ecriture(&parcours);
+    return memoire;
+}
+
+/**
+ *  \brief Écrit les noeuds au format compact. L'espace de l'entête est
+ *         d'abord sauté; les masques puis les valeurs sont écrits en deux
+ *         parcours préfixes et l'entête est écrit en dernier, lorsque le
+ *         nombre de noeuds et la hauteur sont connus.
+ *
+ *  \param arbre  : L'arbre à enregistrer.
+ *  \param tampon : Le tampon d'écriture.
+ *
+ *  \return Faux s'il n'y a plus de mémoire.
+ */
+static bool ecrire_format_2(arbre_binaire* arbre,
+                            struct tampon_ecriture* tampon)
+{
+    struct parcours_ecriture parcours;
+    unsigned char entete[FORMAT_TAILLE_ENTETE] = {0};
+    unsigned char* octets;
+    arbre_binaire* noeud;
+    uint64_t nombre = 0;
+    uint64_t taille_valeurs = 0;
+    uint64_t code;
+    long long precedente = 0;
+    long long valeur;
+    int profondeur;
+    int hauteur = 0;
+    int paquet = 0;
+    bool memoire = true;
+
+    if (lseek(tampon->descripteur, FORMAT_TAILLE_ENTETE, SEEK_SET) < 0) {
+        tampon->reussi = false;
+    }
+    tampon->calculer = true;
+    tampon->somme = 1;
+    noeud = commencer_ecriture(&parcours, arbre, &profondeur);
+    while (noeud && memoire && tampon->reussi) {
+        paquet = paquet | masque_noeud(noeud) << (2 * (nombre % 4));
+        nombre = nombre + 1;
+        if (nombre % 4 == 0) {
+            *reserver_tampon(tampon, 1) = (unsigned char)paquet;
+            tampon->nombre = tampon->nombre + 1;
+            paquet = 0;
+        }
+        if (profondeur > hauteur) {
+            hauteur = profondeur;
+        }
+        noeud = noeud_suivant(&parcours, noeud, &profondeur, &memoire);
+    }
+    terminer_ecriture(&parcours);
+    if (nombre % 4 != 0) {
+        *reserver_tampon(tampon, 1) = (unsigned char)paquet;
+        tampon->nombre = tampon->nombre + 1;
+    }
+    noeud = commencer_ecriture(&parcours, arbre, &profondeur);
+    while (noeud && memoire && tampon->reussi) {
+        valeur = LIRE_VALEUR(noeud);
+        if (valeur < precedente) {
+            code = ((uint64_t)(precedente - valeur) << 1) - 1;
+        } else {
+            code = (uint64_t)(valeur - precedente) << 1;
+        }
+        precedente = valeur;
+        octets = reserver_tampon(tampon, 5);
+        while (code >= 0x80) {
+            *octets = (unsigned char)(code | 0x80);
+            octets = octets + 1;
+            code = code >> 7;
+        }
+        *octets = (unsigned char)code;
+        octets = octets + 1;
+        taille_valeurs = taille_valeurs +
+                         (octets - (tampon->octets + tampon->nombre));
+        tampon->nombre = octets - tampon->octets;
+        noeud = noeud_suivant(&parcours, noeud, &profondeur, &memoire);
+    }
+    terminer_ecriture(&parcours);
+    vider_tampon(tampon);
+    tampon->calculer = false;
+
+    memcpy(entete, FORMAT_SIGNATURE, 4);
+    placer_entier(entete + 4, FORMAT_VERSION, 2);
+    placer_entier(entete + 8, nombre, 8);
+    placer_entier(entete + 16, hauteur, 4);
+    placer_entier(entete + 24, taille_valeurs, 8);
+    placer_entier(reserver_tampon(tampon, FORMAT_TAILLE_SOMME),
+                  combiner_sommes(calculer_somme(1, entete,
+                                                 FORMAT_TAILLE_ENTETE),
+                                  tampon->somme,
+                                  nombre / 4 + (nombre % 4 != 0) +
+                                  taille_valeurs),
+                  FORMAT_TAILLE_SOMME);
+    tampon->nombre = tampon->nombre + FORMAT_TAILLE_SOMME;
+    vider_tampon(tampon);
+    if (memoire && tampon->reussi &&
+        (lseek(tampon->descripteur, 0, SEEK_SET) != 0 ||
+         !ecrire_tampon(tampon->descripteur, (const char*)entete,
+                        FORMAT_TAILLE_ENTETE))) {
+        tampon->reussi = false;
+    }
+    return memoire;
+}
+
+/**
+ *  \brief Écrit les données de l'arbre dans le fichier. Les noeuds sont
+ *         placés en ordre préfixe dans un grand tampon qui est écrit dans
+ *         le fichier chaque fois qu'il est plein.
+ *
+ *  \param arbre        : L'arbre à enregistrer dans le fichier.
+ *  \param descripteur  : Le fichier dans lequel écrire les données.
+ *  \param options      : Combinaison des options ARBRE_BINAIRE_SAUVEGARDE_*.
+ *
+ *  \return ARBRE_BINAIRE_SUCCES si tout l'arbre a été écrit.
+ *
+ *  \note  L'arbre ne doit pas être NULL.
+ */
+static arbre_binaire_statut ecrire_fichier(arbre_binaire* arbre,
+                                           int descripteur,
+                                           unsigned int options)
+{
+    struct tampon_ecriture tampon;
+    arbre_binaire_statut statut = ARBRE_BINAIRE_SUCCES;
+    bool memoire;
+
+    memset(&tampon, 0, sizeof(tampon));
+    tampon.descripteur = descripteur;
+    tampon.reussi = true;
+    tampon.octets = malloc(TAMPON_ECRITURE);
+    memoire = tampon.octets != NULL;
+    if (memoire) {
+        verrouiller_ecriture_arbre_binaire(arbre->contexte);
+        if (options & ARBRE_BINAIRE_SAUVEGARDE_COMPACT) {
+            memoire = ecrire_format_2(arbre, &tampon);
+        } else {
+            memoire = ecrire_format_1(arbre, &tampon);
+        }
+        deverrouiller_ecriture_arbre_binaire(arbre->contexte);
+        vider_tampon(&tampon);
+    }
+    if (memoire == false) {
+        statut = inscrire_erreur_arbre_binaire(arbre, "Il n'y a plus de \
+memoire.");
+    } else if (tampon.reussi == false) {
+        statut = inscrire_erreur_arbre_binaire(arbre, "Il est impossible \
+d'ecrire dans ce fichier.");
+    }
+    free(tampon.octets);
+    return statut;
+}
+
+/**
+ *  \brief Sauvegarde les données d'un arbre binaire dans un fichier.
+ *
+ *  \param arbre        : L'arbre à enregistrer dans le fichier.
+ *  \param nom_fichier  : Le fichier dans lequel sauvergarder les données.
+ *
+ *  \return ARBRE_BINAIRE_SUCCES si le fichier a pu être écrit.
+ *
+ *  \note  L'arbre ne doit pas être NULL.
+ */
+arbre_binaire_statut sauvegarder_arbre_binaire(arbre_binaire* arbre,
+                                               char * nom_fichier)
+{
+    return sauvegarder_arbre_binaire_options(arbre, nom_fichier, 0);
+}
+
+/**
+ *  \brief Sauvegarde les données d'un arbre binaire dans un fichier en
+ *         précisant la manière de l'écrire.
+ *
+ *  \param arbre        : L'arbre à enregistrer dans le fichier.
+ *  \param nom_fichier  : Le fichier dans lequel sauvergarder les données.
+ *  \param options      : Combinaison des options ARBRE_BINAIRE_SAUVEGARDE_*.
+ *
+ *  \return ARBRE_BINAIRE_SUCCES si le fichier a pu être écrit.
+ *
+ *  \note  L'arbre ne doit pas être NULL.
+ */
+arbre_binaire_statut sauvegarder_arbre_binaire_options(arbre_binaire* arbre,
+                                                       char * nom_fichier,
+                                                       unsigned int options)
+{
+    arbre_binaire_statut statut;
+    int descripteur;
+
+    retirer_erreur_arbre_binaire(arbre);
+    STATISTIQUE_DEBUT(ARBRE_BINAIRE_FONCTION_SAUVEGARDER);
+    descripteur = open(nom_fichier, O_WRONLY | O_CREAT | O_TRUNC | O_BINARY,
+                       0666);
+    if (descripteur >= 0) {
+        statut = ecrire_fichier(arbre, descripteur, options);
+        if (statut == ARBRE_BINAIRE_SUCCES &&
+            options & ARBRE_BINAIRE_SAUVEGARDE_SYNCHRONISER &&
+            fsync(descripteur) != 0) {
+            statut = inscrire_erreur_arbre_binaire(arbre, "Il est impossible \
+de synchroniser ce fichier.");
+        }
+        if (close(descripteur) != 0 && statut == ARBRE_BINAIRE_SUCCES) {
+            statut = inscrire_erreur_arbre_binaire(arbre, "Il est impossible \
+d'ecrire dans ce fichier.");
+        }
+    } else {
+        statut = inscrire_erreur_arbre_binaire(arbre, "Il est impossible \
+d'ecrire dans ce fichier.");
+    }
+    STATISTIQUE_FIN();
+    return statut;
+}
@@ -0,0 +1,521 @@
+/*
+
+    Copyright (c) 2015 Nicolas Bisson
+
+    L'autorisation est accordée, gracieusement, à toute personne acquérant une
+    copie de cette bibliothèque et des fichiers de documentation associés
+    (la "Bibliothèque"), de commercialiser la Bibliothèque sans restriction,
+    notamment les droits d'utiliser, de copier, de modifier, de fusionner, de
+    publier, de distribuer, de sous-licencier et / ou de vendre des copies de
+    la Bibliothèque, ainsi que d'autoriser les personnes auxquelles la
+    Bibliothèque est fournie à le faire, sous réserve des conditions suivantes:
+
+    La déclaration de copyright ci-dessus et la présente autorisation doivent
+    être incluses dans toutes copies ou parties substantielles de la
+    Bibliothèque.
+
+    LA BIBLIOTHÈQUE EST FOURNIE "TELLE QUELLE", SANS GARANTIE D'AUCUNE SORTE,
+    EXPLICITE OU IMPLICITE, NOTAMMENT SANS GARANTIE DE QUALITÉ MARCHANDE,
+    D’ADÉQUATION À UN USAGE PARTICULIER ET D'ABSENCE DE CONTREFAÇON. EN AUCUN
+    CAS, LES AUTEURS OU TITULAIRES DU DROIT D'AUTEUR NE SERONT RESPONSABLES DE
+    TOUT DOMMAGE, RÉCLAMATION OU AUTRE RESPONSABILITÉ, QUE CE SOIT DANS LE
+    CADRE D'UN CONTRAT, D'UN DÉLIT OU AUTRE, EN PROVENANCE DE, CONSÉCUTIF À OU
+    EN RELATION AVEC LA BIBLIOTHÈQUE OU SON UTILISATION, OU AVEC D'AUTRES
+    ÉLÉMENTS DE LA BIBLIOTHÈQUE.
+
+*/
+
+/**
+ *  \file arbre_binaire_fige.c
+ *
+ *  Copies figées d'un arbre binaire. Les valeurs sont rangées en ordre de
+ *  largeur dans un tableau et la présence des enfants est conservée dans un
+ *  tableau de bits (deux bits par noeud). La position d'un enfant se déduit
+ *  du nombre de bits à 1 qui précèdent le sien, ce qui évite de conserver
+ *  des pointeurs et garde les données contiguës en mémoire.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "arbre_binaire.h"
+#include "arbre_binaire_interne.h"
+
+/**
+ *  \brief Nombre d'éléments initial de la pile d'un parcours en
+ *         profondeur.
+ */
+#define PILE_FIGE_MINIMUM 64
+
+/**
+ * \brief Un élément de la pile d'un parcours en profondeur.
+ */
+struct element_fige {
+    size_t indice;
+    int profondeur;
+    int etat;
+};
+
+/**
+ * \brief Pile d'un parcours en profondeur d'un arbre figé.
+ */
+struct pile_fige {
+    struct element_fige* elements;
+    size_t nombre;
+    size_t capacite;
+};
+
+/**
+ * \brief État de la copie d'un arbre pendant son parcours en largeur.
+ */
+struct figeage {
+    arbre_binaire_fige* fige;
+    size_t indice;
+};
+
+/**
+ *  \brief Compte les bits à 1 d'un mot.
+ *
+ *  \param mot : Le mot.
+ *
+ *  \return Le nombre de bits à 1.
+ */
+static inline size_t compter_bits(uint64_t mot)
+{
+#ifdef __GNUC__
+    return __builtin_popcountll(mot);
+#else
+    mot = mot - ((mot >> 1) & 0x5555555555555555ULL);
+    mot = (mot & 0x3333333333333333ULL) + ((mot >> 2) & 0x3333333333333333ULL);
+    mot = (mot + (mot >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (mot * 0x0101010101010101ULL) >> 56;
+#endif
+}
+
+/**
+ *  \brief Compte les bits à 1 qui précèdent un bit du tableau des enfants.
+ *
+ *  \param fige : La copie figée.
+ *  \param bit  : La position du bit.
+ *
+ *  \return Le nombre de bits à 1 avant "bit".
+ */
+static inline size_t rang_fige(const arbre_binaire_fige* fige, size_t bit)
+{
+    return fige->rangs[bit / 64] +
+           compter_bits(fige->enfants[bit / 64] &
+                        ((UINT64_C(1) << (bit % 64)) - 1));
+}
+
+/**
+ *  \brief Indique si un noeud figé a un enfant.
+ *
+ *  \param fige : La copie figée.
+ *  \param bit  : 2i pour le premier enfant du noeud i, 2i+1 pour le second.
+ *
+ *  \return Vrai si l'enfant existe.
+ */
+static inline bool a_enfant_fige(const arbre_binaire_fige* fige, size_t bit)
+{
+    return fige->enfants[bit / 64] >> (bit % 64) & 1;
+}
+
+/**
+ *  \brief Trouve un enfant d'un noeud figé.
+ *
+ *  \param fige : La copie figée.
+ *  \param bit  : 2i pour le premier enfant du noeud i, 2i+1 pour le second.
+ *
+ *  \return L'indice de l'enfant, ou 0 s'il n'existe pas (la racine n'est
+ *          l'enfant d'aucun noeud).
+ */
+static inline size_t enfant_fige(const arbre_binaire_fige* fige, size_t bit)
+{
+    size_t enfant = 0;
+
+    if (a_enfant_fige(fige, bit)) {
+        enfant = 1 + rang_fige(fige, bit);
+    }
+    return enfant;
+}
+
+/**
+ *  \brief Visiteur (en largeur) qui copie un noeud dans l'arbre figé.
+ */
+static bool figer_noeud(arbre_binaire* noeud, int profondeur, void* donnees)
+{
+    struct figeage* figeage = donnees;
+    arbre_binaire_fige* fige = figeage->fige;
+    size_t bit = 2 * figeage->indice;
+
+    fige->valeurs[figeage->indice] = LIRE_VALEUR(noeud);
+    if (noeud->premier_fils) {
+        fige->enfants[bit / 64] |= UINT64_C(1) << (bit % 64);
+    }
+    if (noeud->second_fils) {
+        fige->enfants[bit / 64] |= UINT64_C(1) << (bit % 64 + 1);
+    }
+    if (noeud->premier_fils == NULL && noeud->second_fils == NULL) {
+        fige->feuilles = fige->feuilles + 1;
+    }
+    if (profondeur > fige->hauteur) {
+        fige->hauteur = profondeur;
+    }
+    figeage->indice = figeage->indice + 1;
+    return true;
+}
+
+/**
+ *  \brief Crée une copie immuable de l'arbre: les valeurs sont rangées en
+ *         ordre de largeur dans un tableau contigu et la présence des
+ *         enfants dans un tableau de bits. Les requêtes sur la copie ne
+ *         suivent aucun pointeur.
+ *
+ *  \param arbre : L'arbre à figer (il n'est pas modifié).
+ *
+ *  \return La copie, ou NULL s'il n'y a plus de mémoire (une erreur est
+ *          alors inscrite dans l'arbre).
+ */
+arbre_binaire_fige* figer_arbre_binaire(arbre_binaire* arbre)
+{
+    arbre_binaire_fige* fige = NULL;
+    struct figeage figeage;
+    size_t mots;
+    size_t i;
+    bool valide = false;
+
+    if (arbre) {
+        fige = calloc(1, sizeof(arbre_binaire_fige));
+    }
+    if (fige) {
+        verrouiller_ecriture_arbre_binaire(arbre->contexte);
+        fige->nombre = nombre_elements_arbre_binaire(arbre);
+        fige->options = arbre->contexte->options;
+        mots = (2 * fige->nombre + 63) / 64;
+        fige->valeurs = malloc(fige->nombre * sizeof(int));
+        fige->enfants = calloc(mots, sizeof(uint64_t));
+        fige->rangs = malloc(mots * sizeof(size_t));
+        if (fige->valeurs && fige->enfants && fige->rangs) {
+            figeage.fige = fige;
+            figeage.indice = 0;
+            valide = parcourir_arbre_binaire(arbre, ARBRE_BINAIRE_LARGEUR,
+                                             figer_noeud, &figeage);
+        }
+        deverrouiller_ecriture_arbre_binaire(arbre->contexte);
+        if (valide) {
+            fige->rangs[0] = 0;
+            for (i = 1; i < mots; i = i + 1) {
+                fige->rangs[i] = fige->rangs[i - 1] +
+                                 compter_bits(fige->enfants[i - 1]);
+            }
+        } else {
+            detruire_arbre_binaire_fige(fige);
+            fige = NULL;
+        }
+    }
+    if (arbre && fige == NULL) {
+        inscrire_erreur_arbre_binaire(arbre, "Il n'y a plus de memoire.");
+    }
+    return fige;
+}
+
+/**
+ *  \brief Recrée un arbre modifiable à partir d'une copie figée. Les
+ *         noeuds sont créés en ordre de largeur, ce qui place les noeuds
+ *         d'un même niveau côte à côte dans une arène.
+ *
+ *  \param fige : La copie figée.
+ *
+ *  \return Le nouvel arbre, ou NULL s'il n'y a plus de mémoire.
+ */
+arbre_binaire* degeler_arbre_binaire(arbre_binaire_fige* fige)
+{
+    arbre_binaire** noeuds;
+    arbre_binaire* arbre = NULL;
+    arbre_binaire_contexte* contexte;
+    size_t suivant = 1;
+    size_t i;
+    bool valide = true;
+
+    noeuds = malloc(fige->nombre * sizeof(arbre_binaire*));
+    if (noeuds) {
+        arbre = creer_arbre_binaire_options(fige->valeurs[0], fige->options);
+    }
+    if (arbre) {
+        contexte = arbre->contexte;
+        if (contexte->options & ARBRE_BINAIRE_OPTION_ARENE && fige->nombre > 1) {
+            reserver_arene(&contexte->arene, fige->nombre - 1);
+        }
+        noeuds[0] = arbre;
+        for (i = 0; valide && i < fige->nombre; i = i + 1) {
+            if (a_enfant_fige(fige, 2 * i)) {
+                noeuds[suivant] = allouer_noeud_arbre_binaire(contexte,
+                                                    fige->valeurs[suivant]);
+                noeuds[i]->premier_fils = noeuds[suivant];
+                valide = noeuds[suivant] != NULL;
+                suivant = suivant + 1;
+            }
+            if (valide && a_enfant_fige(fige, 2 * i + 1)) {
+                noeuds[suivant] = allouer_noeud_arbre_binaire(contexte,
+                                                    fige->valeurs[suivant]);
+                noeuds[i]->second_fils = noeuds[suivant];
+                valide = noeuds[suivant] != NULL;
+                suivant = suivant + 1;
+            }
+        }
+        if (valide == false) {
+            detruire_arbre_binaire(arbre);
+            arbre = NULL;
+        } else if (contexte->options & ARBRE_BINAIRE_OPTION_PARENT) {
+            recalculer_sous_arbre_binaire(arbre);
+        }
+    }
+    free(noeuds);
+    return arbre;
+}
+
+/**
+ *  \brief Libère la mémoire d'une copie figée.
+ *
+ *  \param fige : La copie à détruire.
+ */
+void detruire_arbre_binaire_fige(arbre_binaire_fige* fige)
+{
+    if (fige) {
+        free(fige->valeurs);
+        free(fige->enfants);
+        free(fige->rangs);
+        free(fige);
+    }
+}
+
+/**
+ *  \brief Indique le nombre d'éléments d'une copie figée.
+ *
+ *  \param fige : La copie figée.
+ *
+ *  \return Le nombre d'éléments.
+ */
+int nombre_elements_arbre_binaire_fige(arbre_binaire_fige* fige)
+{
+    return (int)fige->nombre;
+}
+
+/**
+ *  \brief Indique le nombre de feuilles d'une copie figée.
+ *
+ *  \param fige : La copie figée.
+ *
+ *  \return Le nombre de feuilles.
+ */
+int nombre_feuilles_arbre_binaire_fige(arbre_binaire_fige* fige)
+{
+    return fige->feuilles;
+}
+
+/**
+ *  \brief Indique la hauteur d'une copie figée.
+ *
+ *  \param fige : La copie figée.
+ *
+ *  \return La hauteur.
+ */
+int hauteur_arbre_binaire_fige(arbre_binaire_fige* fige)
+{
+    return fige->hauteur;
+}
+
+/**
+ *  \brief Vérifie si une valeur est dans une copie figée. Si l'arbre figé
+ *         était ordonné, la recherche descend l'arbre, sinon le tableau
+ *         des valeurs est lu d'un bout à l'autre.
+ *
+ *  \param fige   : La copie figée.
+ *  \param valeur : La valeur à chercher.
+ *
+ *  \return Vrai si la valeur est présente.
+ */
+bool contient_element_arbre_binaire_fige(arbre_binaire_fige* fige,
+                                         int valeur)
+{
+    size_t i = 0;
+    bool trouve = false;
+    bool continuer = true;
+
+    if (fige->options & ARBRE_BINAIRE_OPTION_ORDONNE) {
+        while (continuer && trouve == false) {
+            if (valeur == fige->valeurs[i]) {
+                trouve = true;
+            } else {
+                i = enfant_fige(fige, 2 * i + (valeur > fige->valeurs[i]));
+                continuer = i != 0;
+            }
+        }
+    } else {
+        trouve = chercher_valeur_tableau(fige->valeurs, fige->nombre, valeur);
+    }
+    return trouve;
+}
+
+/**
+ *  \brief Vérifie quelles valeurs sont dans une copie figée. Si l'arbre
+ *         figé n'était pas ordonné, le tableau des valeurs n'est lu qu'une
+ *         seule fois pour toutes les valeurs.
+ *
+ *  \param fige      : La copie figée.
+ *  \param valeurs   : Les valeurs à chercher.
+ *  \param nombre    : Le nombre de valeurs à chercher.
+ *  \param resultats : Reçoit un bit par valeur (le bit i % 8 de l'octet
+ *                     i / 8), à 1 si valeurs[i] est présente.
+ *
+ *  \return Le nombre de valeurs présentes.
+ */
+int contient_elements_arbre_binaire_fige(arbre_binaire_fige* fige,
+                                         const int* valeurs, int nombre,
+                                         unsigned char* resultats)
+{
+    int trouvees = 0;
+    int i;
+
+    memset(resultats, 0, (nombre + 7) / 8);
+    if (fige->options & ARBRE_BINAIRE_OPTION_ORDONNE) {
+        for (i = 0; i < nombre; i = i + 1) {
+            if (contient_element_arbre_binaire_fige(fige, valeurs[i])) {
+                resultats[i / 8] = resultats[i / 8] | 1 << (i % 8);
+                trouvees = trouvees + 1;
+            }
+        }
+    } else if (nombre > 0) {
+        trouvees = (int)chercher_valeurs_tableau(fige->valeurs, fige->nombre,
+                                                 valeurs, nombre, resultats);
+    }
+    return trouvees;
+}
+
+/**
+ *  \brief Ajoute un élément sur le dessus de la pile d'un parcours en
+ *         profondeur.
+ *
+ *  \return Faux s'il n'y a plus de mémoire.
+ */
+static bool empiler_fige(struct pile_fige* pile, size_t indice,
+                         int profondeur)
+{
+    struct element_fige* elements = pile->elements;
+    bool reussi = true;
+
+    if (pile->nombre == pile->capacite) {
+        elements = realloc(pile->elements,
+                           2 * pile->capacite * sizeof(*elements));
+        reussi = elements != NULL;
+        if (reussi) {
+            pile->elements = elements;
+            pile->capacite = 2 * pile->capacite;
+        }
+    }
+    if (reussi) {
+        elements[pile->nombre].indice = indice;
+        elements[pile->nombre].profondeur = profondeur;
+        elements[pile->nombre].etat = 0;
+        pile->nombre = pile->nombre + 1;
+    }
+    return reussi;
+}
+
+/**
+ *  \brief Parcours préfixe, infixe ou postfixe. L'état de chaque élément
+ *         indique quels enfants ont déjà été parcourus; le noeud est
+ *         visité à l'état qui correspond à l'ordre demandé.
+ */
+static bool parcourir_profondeur(arbre_binaire_fige* fige, int moment,
+                                 arbre_binaire_visiteur_fige visiteur,
+                                 void* donnees, bool* memoire)
+{
+    struct pile_fige pile;
+    struct element_fige element;
+    size_t enfant;
+    bool continuer = true;
+
+    pile.nombre = 0;
+    pile.capacite = PILE_FIGE_MINIMUM;
+    pile.elements = malloc(pile.capacite * sizeof(struct element_fige));
+    *memoire = pile.elements != NULL && empiler_fige(&pile, 0, 1);
+    while (continuer && *memoire && pile.nombre > 0) {
+        element = pile.elements[pile.nombre - 1];
+        pile.elements[pile.nombre - 1].etat = element.etat + 1;
+        if (element.etat == moment) {
+            continuer = visiteur(fige->valeurs[element.indice],
+                                 element.profondeur, donnees);
+        }
+        if (element.etat < 2) {
+            enfant = enfant_fige(fige, 2 * element.indice + element.etat);
+            if (enfant && continuer) {
+                *memoire = empiler_fige(&pile, enfant, element.profondeur + 1);
+            }
+        } else {
+            pile.nombre = pile.nombre - 1;
+        }
+    }
+    free(pile.elements);
+    return continuer;
+}
+
+/**
+ *  \brief Parcours en largeur: le tableau des valeurs est déjà dans cet
+ *         ordre. "fin" est l'indice du premier noeud du niveau suivant.
+ */
+static bool parcourir_largeur(arbre_binaire_fige* fige,
+                              arbre_binaire_visiteur_fige visiteur,
+                              void* donnees)
+{
+    size_t fin = 1;
+    size_t i;
+    int profondeur = 1;
+    bool continuer = true;
+
+    for (i = 0; continuer && i < fige->nombre; i = i + 1) {
+        if (i == fin) {
+            profondeur = profondeur + 1;
+            fin = 1 + rang_fige(fige, 2 * fin);
+        }
+        continuer = visiteur(fige->valeurs[i], profondeur, donnees);
+    }
+    return continuer;
+}
+
+/**
+ *  \brief Visite toutes les valeurs d'une copie figée dans l'ordre
+ *         demandé.
+ *
+ *  \param fige     : La copie figée.
+ *  \param ordre    : L'ordre du parcours.
+ *  \param visiteur : La fonction appelée pour chaque noeud.
+ *  \param donnees  : Données passées telles quelles au visiteur.
+ *
+ *  \return Vrai si tous les noeuds ont été visités, Faux si le visiteur a
+ *          arrêté le parcours ou s'il n'y a plus de mémoire.
+ */
+bool parcourir_arbre_binaire_fige(arbre_binaire_fige* fige,
+                                  arbre_binaire_ordre ordre,
+                                  arbre_binaire_visiteur_fige visiteur,
+                                  void* donnees)
+{
+    bool continuer = true;
+    bool memoire = true;
+
+    if (ordre == ARBRE_BINAIRE_PREFIXE ||
+        ordre == ARBRE_BINAIRE_PREFIXE_MORRIS) {
+        continuer = parcourir_profondeur(fige, 0, visiteur, donnees,
+                                         &memoire);
+    } else if (ordre == ARBRE_BINAIRE_INFIXE ||
+               ordre == ARBRE_BINAIRE_INFIXE_MORRIS) {
+        continuer = parcourir_profondeur(fige, 1, visiteur, donnees,
+                                         &memoire);
+    } else if (ordre == ARBRE_BINAIRE_POSTFIXE) {
+        continuer = parcourir_profondeur(fige, 2, visiteur, donnees,
+                                         &memoire);
+    } else {
+        continuer = parcourir_largeur(fige, visiteur, donnees);
+    }
+    return continuer && memoire;
+}
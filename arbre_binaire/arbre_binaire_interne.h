@@ -0,0 +1,828 @@
+/*
+
+    Copyright (c) 2015 Nicolas Bisson
+
+    L'autorisation est accordée, gracieusement, à toute personne acquérant une
+    copie de cette bibliothèque et des fichiers de documentation associés
+    (la "Bibliothèque"), de commercialiser la Bibliothèque sans restriction,
+    notamment les droits d'utiliser, de copier, de modifier, de fusionner, de
+    publier, de distribuer, de sous-licencier et / ou de vendre des copies de
+    la Bibliothèque, ainsi que d'autoriser les personnes auxquelles la
+    Bibliothèque est fournie à le faire, sous réserve des conditions suivantes:
+
+    La déclaration de copyright ci-dessus et la présente autorisation doivent
+    être incluses dans toutes copies ou parties substantielles de la
+    Bibliothèque.
+
+    LA BIBLIOTHÈQUE EST FOURNIE "TELLE QUELLE", SANS GARANTIE D'AUCUNE SORTE,
+    EXPLICITE OU IMPLICITE, NOTAMMENT SANS GARANTIE DE QUALITÉ MARCHANDE,
+    D’ADÉQUATION À UN USAGE PARTICULIER ET D'ABSENCE DE CONTREFAÇON. EN AUCUN
+    CAS, LES AUTEURS OU TITULAIRES DU DROIT D'AUTEUR NE SERONT RESPONSABLES DE
+    TOUT DOMMAGE, RÉCLAMATION OU AUTRE RESPONSABILITÉ, QUE CE SOIT DANS LE
+    CADRE D'UN CONTRAT, D'UN DÉLIT OU AUTRE, EN PROVENANCE DE, CONSÉCUTIF À OU
+    EN RELATION AVEC LA BIBLIOTHÈQUE OU SON UTILISATION, OU AVEC D'AUTRES
+    ÉLÉMENTS DE LA BIBLIOTHÈQUE.
+
+*/
+
+/**
+ *  \file arbre_binaire_interne.h
+ *
+ *  Fichier d'entête interne à la librairie. Contient le contexte partagé
+ *  par tous les noeuds d'un même arbre binaire (options, racine et erreur
+ *  de l'arbre) ainsi que l'allocateur
+ *  par "pages" (arène) utilisé par les arbres créés avec l'option
+ *  ARBRE_BINAIRE_OPTION_ARENE.
+ *
+ *  \note  Ce fichier ne doit pas être inclus par les programmes qui
+ *         utilisent la librairie.
+ *
+ */
+
+
+#ifndef ARBRE_BINAIRE_INTERNE_H_INCLUDED
+#define ARBRE_BINAIRE_INTERNE_H_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "arbre_binaire.h"
+
+/**
+ *  \brief Variable propre à chaque fil d'exécution.
+ */
+#ifdef _MSC_VER
+#define LOCAL_AU_FIL __declspec(thread)
+#else
+#define LOCAL_AU_FIL _Thread_local
+#endif
+
+/**
+ *  \brief Nombre de noeuds de la première page d'une arène. Chaque
+ *         nouvelle page est deux fois plus grande que la précédente.
+ */
+#define ARENE_PAGE_MINIMUM 64
+
+/**
+ *  \brief Nombre maximal de noeuds d'une page allouée automatiquement.
+ */
+#define ARENE_PAGE_MAXIMUM 1048576
+
+/**
+ * \brief Une page de l'arène: un bloc contigu de noeuds.
+ */
+struct arbre_binaire_page {
+    struct arbre_binaire_page * suivante;
+    size_t nombre_noeuds;
+    char* debut;
+    char* fin;      /**< Fin des noeuds utilisés, sauf pour la page courante
+                         (voir fin_page_arene). */
+};
+
+/**
+ * \brief Une page d'une arène et l'endroit où elle a été copiée.
+ */
+struct arbre_binaire_page_copiee {
+    char* debut;
+    char* fin;
+    char* copie;
+};
+
+/**
+ * \brief Correspondance entre les pages d'une arène et celles de sa copie
+ *        (voir copier_arene), triées par adresse.
+ */
+struct arbre_binaire_deplacement {
+    struct arbre_binaire_page_copiee* pages;
+    size_t nombre;
+    size_t dernier;     /**< La page de la dernière adresse déplacée. */
+};
+
+/**
+ * \brief Allocateur de noeuds appartenant à un arbre binaire.
+ */
+struct arbre_binaire_arene {
+    size_t taille_noeud;
+    size_t taille_page;
+    struct arbre_binaire_page * pages;
+    char* courant;
+    char* fin;
+    void* libres;
+};
+
+/**
+ * \brief Noeud d'un arbre créé avec ARBRE_BINAIRE_OPTION_PARENT (sans
+ *        ARBRE_BINAIRE_OPTION_AUGMENTE). Le lien vers le parent est placé
+ *        au même endroit que dans le noeud étendu.
+ */
+struct arbre_binaire_noeud_parent {
+    struct arbre_binaire_struct noeud;
+    arbre_binaire* parent;
+};
+
+/**
+ *  \brief Accède au parent d'un noeud (étendu ou non) d'un arbre créé avec
+ *         ARBRE_BINAIRE_OPTION_PARENT.
+ */
+#define NOEUD_PARENT(arbre) ((struct arbre_binaire_noeud_parent*)(arbre))
+
+/**
+ * \brief Noeud d'un arbre créé avec ARBRE_BINAIRE_OPTION_AUGMENTE. Le
+ *        noeud de base est placé au début pour que les deux types puissent
+ *        être convertis l'un en l'autre.
+ */
+struct arbre_binaire_noeud_etendu {
+    struct arbre_binaire_struct noeud;
+    arbre_binaire* parent;
+    int taille;
+    int feuilles;
+    int hauteur;
+};
+
+/**
+ *  \brief Accède aux informations supplémentaires d'un noeud étendu.
+ */
+#define NOEUD_ETENDU(arbre) ((struct arbre_binaire_noeud_etendu*)(arbre))
+
+/**
+ * \brief Noeud d'un arbre créé avec ARBRE_BINAIRE_OPTION_PERSISTANT. Un
+ *        noeud peut appartenir à plusieurs versions de l'arbre: "references"
+ *        compte les noeuds (ou les instantanés) qui pointent vers lui.
+ *        "parent" est le parent du noeud dans la version courante.
+ */
+struct arbre_binaire_noeud_persistant {
+    struct arbre_binaire_noeud_etendu etendu;
+    unsigned int references;
+};
+
+/**
+ *  \brief Accède au compteur de références d'un noeud persistant.
+ */
+#define NOEUD_PERSISTANT(arbre) \
+    ((struct arbre_binaire_noeud_persistant*)(arbre))
+
+/**
+ * \brief Emplacement de la dernière erreur.
+ */
+struct arbre_binaire_erreur {
+    bool a_erreur;
+    char texte[ERREUR_TAILLE];
+};
+
+/**
+ * \brief État d'un arbre créé avec ARBRE_BINAIRE_OPTION_CONCURRENT (voir
+ *        arbre_binaire_concurrent.c).
+ */
+struct arbre_binaire_concurrence;
+
+/**
+ * \brief Informations partagées par tous les noeuds d'un arbre binaire.
+ */
+struct arbre_binaire_contexte_struct {
+    unsigned int options;
+    size_t taille_noeud;
+    arbre_binaire* racine;
+    struct arbre_binaire_arene arene;
+    struct arbre_binaire_erreur erreur;
+    struct arbre_binaire_concurrence* concurrence;
+    unsigned int versions;
+};
+
+/**
+ *  \brief Lit un enfant d'un noeud. En mode concurrent, l'enfant peut être
+ *         ajouté par un autre fil: la lecture garantit que le contenu du
+ *         nouvel enfant est visible.
+ */
+#ifdef __GNUC__
+#define LIRE_FILS(noeud, fils) \
+    __atomic_load_n(&(noeud)->fils, __ATOMIC_ACQUIRE)
+#else
+#define LIRE_FILS(noeud, fils) ((noeud)->fils)
+#endif
+
+/**
+ *  \brief Place un enfant dans un noeud de façon à ce que les lecteurs
+ *         concurrents voient le noeud complet (ou son absence).
+ */
+#ifdef __GNUC__
+#define PUBLIER_FILS(noeud, fils, enfant) \
+    __atomic_store_n(&(noeud)->fils, (enfant), __ATOMIC_SEQ_CST)
+#else
+#define PUBLIER_FILS(noeud, fils, enfant) ((noeud)->fils = (enfant))
+#endif
+
+/**
+ *  \brief Lit et modifie la valeur d'un noeud qu'un autre fil peut
+ *         modifier en même temps.
+ */
+#ifdef __GNUC__
+#define LIRE_VALEUR(noeud) __atomic_load_n(&(noeud)->valeur, __ATOMIC_RELAXED)
+#define ECRIRE_VALEUR(noeud, nouvelle) \
+    __atomic_store_n(&(noeud)->valeur, (nouvelle), __ATOMIC_RELAXED)
+#else
+#define LIRE_VALEUR(noeud) ((noeud)->valeur)
+#define ECRIRE_VALEUR(noeud, nouvelle) ((noeud)->valeur = (nouvelle))
+#endif
+
+/**
+ *  \brief Prépare une arène vide.
+ *
+ *  \param arene       : L'arène à initialiser.
+ *  \param taille_noeud : La taille en octets d'un noeud de l'arène.
+ */
+void initialiser_arene(struct arbre_binaire_arene* arene, size_t taille_noeud);
+
+/**
+ *  \brief Réserve un noeud (mis à zéro) dans l'arène.
+ *
+ *  \param arene : L'arène dans laquelle allouer le noeud.
+ *
+ *  \return Le noeud alloué ou NULL s'il n'y a plus de mémoire.
+ */
+void* allouer_arene(struct arbre_binaire_arene* arene);
+
+/**
+ *  \brief Remet un noeud dans la liste des noeuds libres de l'arène.
+ *
+ *  \param arene : L'arène qui contient le noeud.
+ *  \param noeud : Le noeud à libérer.
+ */
+void liberer_arene(struct arbre_binaire_arene* arene, void* noeud);
+
+/**
+ *  \brief S'assure que les prochaines allocations de "nombre" noeuds se
+ *         feront dans une seule page contiguë.
+ *
+ *  \param arene  : L'arène à préparer.
+ *  \param nombre : Le nombre de noeuds qui seront alloués.
+ *
+ *  \return Vrai si l'espace a pu être réservé.
+ */
+bool reserver_arene(struct arbre_binaire_arene* arene, size_t nombre);
+
+/**
+ *  \brief Libère toutes les pages de l'arène.
+ *
+ *  \param arene : L'arène à vider.
+ */
+void vider_arene(struct arbre_binaire_arene* arene);
+
+/**
+ *  \brief Indique où se terminent les noeuds utilisés d'une page.
+ *
+ *  \param arene : L'arène qui contient la page.
+ *  \param page  : La page.
+ *
+ *  \return L'adresse qui suit le dernier noeud utilisé de la page.
+ */
+char* fin_page_arene(const struct arbre_binaire_arene* arene,
+                     const struct arbre_binaire_page* page);
+
+/**
+ *  \brief Copie les pages d'une arène dans une arène vide. Les noeuds sont
+ *         copiés tels quels: leurs liens doivent ensuite être déplacés à
+ *         l'aide de deplacer_arene. La liste des noeuds libres est déjà
+ *         déplacée.
+ *
+ *  \param copie       : L'arène vide (de même taille de noeud).
+ *  \param source      : L'arène à copier.
+ *  \param deplacement : Reçoit la correspondance entre les pages, à
+ *                       libérer par liberer_deplacement_arene.
+ *
+ *  \return Faux s'il n'y a plus de mémoire (l'arène copie reste vide).
+ */
+bool copier_arene(struct arbre_binaire_arene* copie,
+                  const struct arbre_binaire_arene* source,
+                  struct arbre_binaire_deplacement* deplacement);
+
+/**
+ *  \brief Donne l'adresse, dans la copie, d'une adresse de l'arène copiée.
+ *
+ *  \param deplacement : La correspondance donnée par copier_arene.
+ *  \param adresse     : Une adresse de l'arène copiée, ou NULL.
+ *
+ *  \return L'adresse correspondante dans la copie, ou NULL.
+ */
+void* deplacer_arene(struct arbre_binaire_deplacement* deplacement,
+                     const void* adresse);
+
+/**
+ *  \brief Libère la correspondance donnée par copier_arene.
+ *
+ *  \param deplacement : La correspondance.
+ */
+void liberer_deplacement_arene(struct arbre_binaire_deplacement* deplacement);
+
+/**
+ *  \brief Alloue un noeud appartenant à l'arbre du contexte.
+ *
+ *  \param contexte : Le contexte de l'arbre qui contiendra le noeud.
+ *  \param valeur   : La valeur à placer dans le noeud.
+ *
+ *  \return Le nouveau noeud ou NULL s'il n'y a plus de mémoire.
+ */
+arbre_binaire* allouer_noeud_arbre_binaire(arbre_binaire_contexte* contexte,
+                                           int valeur);
+
+/**
+ *  \brief Libère un seul noeud (sans ses enfants) de l'arbre.
+ *
+ *  \param noeud : Le noeud à libérer.
+ */
+void liberer_noeud_arbre_binaire(arbre_binaire* noeud);
+
+/**
+ *  \brief Recalcule les informations d'un noeud étendu à partir de ses
+ *         enfants.
+ *
+ *  \param arbre : Le noeud à recalculer.
+ */
+void calculer_noeud_etendu_arbre_binaire(arbre_binaire* arbre);
+
+/**
+ *  \brief Recalcule les informations d'un noeud étendu et de tous ses
+ *         ancêtres à partir de leurs enfants.
+ *
+ *  \param arbre : Le premier noeud à recalculer.
+ */
+void mettre_a_jour_ancetres_arbre_binaire(arbre_binaire* arbre);
+
+/**
+ *  \brief Recalcule les liens vers les parents et les informations de tous
+ *         les noeuds étendus d'un sous-arbre (par exemple après un
+ *         chargement).
+ *
+ *  \param arbre : Le sous-arbre à recalculer.
+ *
+ *  \return Faux s'il n'y a plus de mémoire pour effectuer le parcours.
+ */
+bool recalculer_sous_arbre_binaire(arbre_binaire* arbre);
+
+/**
+ *  \brief Vérifie qu'un arbre ordonné construit tel quel respecte ses
+ *         options (valeurs strictement croissantes en ordre infixe et,
+ *         avec ARBRE_BINAIRE_OPTION_EQUILIBRE, arbre équilibré). Les
+ *         hauteurs doivent avoir été recalculées.
+ *
+ *  \param arbre : La racine de l'arbre.
+ *
+ *  \return NULL si l'arbre est valide, sinon le message d'erreur.
+ */
+const char* verifier_ordre_arbre_binaire(arbre_binaire* arbre);
+
+/**
+ * \brief Copie figée d'un arbre binaire. Le noeud d'indice "i" (en ordre
+ *        de largeur) a un premier enfant si le bit 2i de "enfants" est à 1
+ *        et un second enfant si le bit 2i+1 est à 1. L'indice d'un enfant
+ *        est 1 + le nombre de bits à 1 qui précèdent son bit; "rangs"
+ *        conserve ce nombre au début de chaque mot.
+ */
+struct arbre_binaire_fige_struct {
+    int* valeurs;
+    uint64_t* enfants;
+    size_t* rangs;
+    size_t nombre;
+    int hauteur;
+    int feuilles;
+    unsigned int options;
+};
+
+/**
+ * \brief Noeud d'un arbre compact: sa valeur et les indices de ses
+ *        enfants (0 s'il n'y en a pas). Le second indice d'un noeud libéré
+ *        vaut COMPACT_LIBRE et son premier indice désigne le prochain
+ *        noeud libre.
+ */
+struct arbre_binaire_element_compact {
+    int valeur;
+    uint32_t premier;
+    uint32_t second;
+};
+
+/**
+ *  \brief Le second indice des noeuds libérés d'un arbre compact.
+ */
+#define COMPACT_LIBRE UINT32_MAX
+
+/**
+ * \brief Arbre compact. Le noeud 0 n'est jamais utilisé, pour que l'indice
+ *        0 signifie l'absence d'enfant; la racine est le noeud 1. Les
+ *        noeuds d'indice inférieur à "utilises" sont utilisés ou libres.
+ */
+struct arbre_binaire_compact_struct {
+    struct arbre_binaire_element_compact* noeuds;
+    uint32_t capacite;
+    uint32_t utilises;
+    uint32_t libres;
+    uint32_t nombre;
+    unsigned int options;
+    struct arbre_binaire_erreur erreur;
+};
+
+/**
+ *  \brief Vérifie si une valeur est dans un tableau, à l'aide des
+ *         instructions vectorielles du processeur lorsqu'il y en a.
+ *
+ *  \param valeurs : Le tableau.
+ *  \param nombre  : Le nombre de valeurs du tableau.
+ *  \param valeur  : La valeur à chercher.
+ *
+ *  \return Vrai si la valeur est présente.
+ */
+bool chercher_valeur_tableau(const int* valeurs, size_t nombre, int valeur);
+
+/**
+ *  \brief Vérifie quelles valeurs sont dans un tableau en ne lisant le
+ *         tableau qu'une seule fois.
+ *
+ *  \param valeurs    : Le tableau.
+ *  \param nombre     : Le nombre de valeurs du tableau.
+ *  \param cherchees  : Les valeurs à chercher.
+ *  \param k          : Le nombre de valeurs à chercher.
+ *  \param resultats  : Le bit i est mis à 1 si cherchees[i] est présente.
+ *                      Les bits déjà à 1 ne sont pas cherchés.
+ *
+ *  \return Le nombre de valeurs trouvées.
+ */
+size_t chercher_valeurs_tableau(const int* valeurs, size_t nombre,
+                                const int* cherchees, size_t k,
+                                unsigned char* resultats);
+
+/**
+ *  \brief Prépare un contexte pour le mode concurrent.
+ *
+ *  \param contexte : Le contexte de l'arbre.
+ *
+ *  \return Faux s'il n'y a plus de mémoire.
+ */
+bool initialiser_concurrence_arbre_binaire(arbre_binaire_contexte* contexte);
+
+/**
+ *  \brief Libère les sous-arbres en attente de libération et l'état du
+ *         mode concurrent. Aucun lecteur ne doit utiliser l'arbre.
+ *
+ *  \param contexte : Le contexte de l'arbre.
+ */
+void liberer_concurrence_arbre_binaire(arbre_binaire_contexte* contexte);
+
+/**
+ *  \brief Réserve l'arbre pour une écriture (rien hors du mode concurrent).
+ *
+ *  \param contexte : Le contexte de l'arbre.
+ */
+void verrouiller_ecriture_arbre_binaire(arbre_binaire_contexte* contexte);
+
+/**
+ *  \brief Termine une écriture commencée par
+ *         verrouiller_ecriture_arbre_binaire.
+ *
+ *  \param contexte : Le contexte de l'arbre.
+ */
+void deverrouiller_ecriture_arbre_binaire(arbre_binaire_contexte* contexte);
+
+/**
+ *  \brief Libère un sous-arbre détaché de l'arbre lorsque plus aucun
+ *         lecteur ne peut le parcourir. L'écriture doit être réservée.
+ *
+ *  \param sous_arbre : Le sous-arbre détaché.
+ */
+void differer_liberation_arbre_binaire(arbre_binaire* sous_arbre);
+
+/**
+ *  \brief Donne l'emplacement de l'erreur d'un arbre: celui du contexte,
+ *         ou celui du fil courant en mode concurrent.
+ *
+ *  \param contexte : Le contexte de l'arbre.
+ *
+ *  \return L'emplacement de l'erreur.
+ */
+struct arbre_binaire_erreur* erreur_contexte_arbre_binaire(
+        arbre_binaire_contexte* contexte);
+
+/**
+ *  \brief Commence une lecture (voir entrer_lecture_arbre_binaire) à
+ *         partir du contexte.
+ *
+ *  \param contexte : Le contexte de l'arbre.
+ *
+ *  \return Le jeton à passer à sortir_lecture_contexte_arbre_binaire.
+ */
+int entrer_lecture_contexte_arbre_binaire(arbre_binaire_contexte* contexte);
+
+/**
+ *  \brief Termine une lecture à partir du contexte, qui reste valide même
+ *         si le noeud lu a été libéré pendant la lecture.
+ *
+ *  \param contexte : Le contexte de l'arbre.
+ *  \param jeton    : Le jeton reçu au début de la lecture.
+ */
+void sortir_lecture_contexte_arbre_binaire(arbre_binaire_contexte* contexte,
+                                           int jeton);
+
+/**
+ * \brief Contenu complet d'un fichier rendu accessible en mémoire.
+ */
+struct arbre_binaire_projection {
+    const char* donnees;
+    size_t taille;
+    bool projete;
+};
+
+/**
+ *  \brief Rend le contenu complet d'un fichier accessible en mémoire. Le
+ *         fichier est projeté en mémoire (mmap) lorsque le système le
+ *         permet, sinon il est lu d'un seul bloc.
+ *
+ *  \param projection  : Reçoit l'adresse et la taille du contenu.
+ *  \param nom_fichier : Le nom du fichier à lire.
+ *
+ *  \return Faux si le fichier ne peut pas être lu.
+ */
+bool projeter_fichier(struct arbre_binaire_projection* projection,
+                      const char* nom_fichier);
+
+/**
+ *  \brief Libère le contenu obtenu par projeter_fichier.
+ *
+ *  \param projection : Le contenu à libérer.
+ */
+void liberer_projection(struct arbre_binaire_projection* projection);
+
+#ifdef ARBRE_BINAIRE_STATISTIQUES
+
+/**
+ *  \brief Les statistiques du fil d'exécution (voir
+ *         arbre_binaire_statistiques.c).
+ */
+extern LOCAL_AU_FIL arbre_binaire_statistiques statistiques_arbre_binaire;
+
+/**
+ *  \brief La fonction appelée par le programme dans laquelle les noeuds
+ *         visités sont comptés.
+ */
+extern LOCAL_AU_FIL arbre_binaire_fonction fonction_arbre_binaire;
+
+/**
+ *  \brief Commence la mesure de la durée d'une fonction.
+ *
+ *  \param fonction : La fonction mesurée.
+ */
+void commencer_mesure_arbre_binaire(arbre_binaire_fonction fonction);
+
+/**
+ *  \brief Termine la dernière mesure commencée et l'ajoute à
+ *         l'histogramme de sa fonction.
+ */
+void terminer_mesure_arbre_binaire(void);
+
+/**
+ *  \brief Compte les noeuds utilisés d'une arène.
+ *
+ *  \param arene : L'arène.
+ *
+ *  \return Le nombre de noeuds alloués et non libérés.
+ */
+size_t compter_noeuds_arene(const struct arbre_binaire_arene* arene);
+
+#define STATISTIQUE_AJOUTER(champ, nombre) \
+    (statistiques_arbre_binaire.champ += (nombre))
+#define STATISTIQUE_MAXIMUM(champ, nombre) \
+    do { \
+        if ((nombre) > statistiques_arbre_binaire.champ) { \
+            statistiques_arbre_binaire.champ = (nombre); \
+        } \
+    } while (0)
+#define STATISTIQUE_VISITE() \
+    (statistiques_arbre_binaire.noeuds_visites[fonction_arbre_binaire] += 1)
+#define STATISTIQUE_DEBUT(fonction) commencer_mesure_arbre_binaire(fonction)
+#define STATISTIQUE_FIN() terminer_mesure_arbre_binaire()
+
+#else
+
+/**
+ *  \brief Sans ARBRE_BINAIRE_STATISTIQUES, les statistiques ne coûtent
+ *         rien: les macros ne produisent aucun code.
+ */
+#define STATISTIQUE_AJOUTER(champ, nombre) ((void)0)
+#define STATISTIQUE_MAXIMUM(champ, nombre) ((void)0)
+#define STATISTIQUE_VISITE() ((void)0)
+#define STATISTIQUE_DEBUT(fonction) ((void)0)
+#define STATISTIQUE_FIN() ((void)0)
+
+#endif
+
+/**
+ *  \brief Nombre d'éléments de la pile conservés directement dans la
+ *         structure (sans allocation).
+ */
+#define PILE_TAILLE_LOCALE 64
+
+/**
+ * \brief Un élément de la pile de parcours.
+ */
+struct arbre_binaire_element_pile {
+    arbre_binaire* noeud;
+    int profondeur;
+    int etat;
+};
+
+/**
+ * \brief Pile explicite utilisée pour parcourir un arbre sans récursion.
+ *        Les premiers éléments sont conservés dans la structure, la pile
+ *        n'est allouée que pour les arbres profonds.
+ */
+struct arbre_binaire_pile {
+    struct arbre_binaire_element_pile* elements;
+    size_t nombre;
+    size_t capacite;
+    struct arbre_binaire_element_pile locale[PILE_TAILLE_LOCALE];
+};
+
+/**
+ *  \brief Prépare une pile vide.
+ *
+ *  \param pile : La pile à initialiser.
+ */
+static inline void initialiser_pile(struct arbre_binaire_pile* pile)
+{
+    pile->elements = pile->locale;
+    pile->nombre = 0;
+    pile->capacite = PILE_TAILLE_LOCALE;
+}
+
+/**
+ *  \brief Agrandit la pile (voir arbre_binaire_parcours.c).
+ *
+ *  \param pile : La pile pleine.
+ *
+ *  \return Faux s'il n'y a plus de mémoire.
+ */
+bool agrandir_pile(struct arbre_binaire_pile* pile);
+
+/**
+ *  \brief Ajoute un élément sur le dessus de la pile.
+ *
+ *  \param pile       : La pile.
+ *  \param noeud      : Le noeud à ajouter.
+ *  \param profondeur : La profondeur du noeud.
+ *  \param etat       : L'étape du parcours rendue pour ce noeud.
+ *
+ *  \return Faux s'il n'y a plus de mémoire.
+ */
+static inline bool empiler_pile(struct arbre_binaire_pile* pile,
+                                arbre_binaire* noeud, int profondeur, int etat)
+{
+    bool reussi = true;
+
+    if (pile->nombre == pile->capacite) {
+        reussi = agrandir_pile(pile);
+    }
+    if (reussi) {
+        pile->elements[pile->nombre].noeud = noeud;
+        pile->elements[pile->nombre].profondeur = profondeur;
+        pile->elements[pile->nombre].etat = etat;
+        pile->nombre = pile->nombre + 1;
+        STATISTIQUE_MAXIMUM(pile_maximale, pile->nombre);
+    }
+    return reussi;
+}
+
+/**
+ *  \brief Retire l'élément du dessus de la pile.
+ *
+ *  \param pile    : La pile.
+ *  \param element : Reçoit l'élément retiré.
+ *
+ *  \return Faux si la pile était vide.
+ */
+static inline bool depiler_pile(struct arbre_binaire_pile* pile,
+                                struct arbre_binaire_element_pile* element)
+{
+    bool reussi = false;
+
+    if (pile->nombre > 0) {
+        pile->nombre = pile->nombre - 1;
+        *element = pile->elements[pile->nombre];
+        reussi = true;
+    }
+    return reussi;
+}
+
+/**
+ *  \brief Libère la mémoire allouée par la pile.
+ *
+ *  \param pile : La pile à libérer.
+ */
+static inline void vider_pile(struct arbre_binaire_pile* pile)
+{
+    if (pile->elements != pile->locale) {
+        free(pile->elements);
+    }
+    initialiser_pile(pile);
+}
+
+/**
+ * \brief État d'un parcours de Morris (voir arbre_binaire_parcours.c). Le
+ *        parcours n'utilise ni pile ni allocation: il relie temporairement
+ *        le dernier noeud de chaque premier sous-arbre à son ancêtre.
+ */
+struct arbre_binaire_morris {
+    arbre_binaire* courant;         /**< Le prochain noeud à examiner. */
+    arbre_binaire* visite;          /**< Le dernier noeud rendu. */
+    arbre_binaire* lien;            /**< Le lien retiré de "visite". */
+    arbre_binaire* predecesseur;    /**< Préfixe: lien à poser ensuite. */
+    int profondeur;
+    bool infixe;
+};
+
+/**
+ *  \brief Commence un parcours de Morris.
+ *
+ *  \param morris : L'état du parcours.
+ *  \param arbre  : L'arbre à parcourir.
+ *  \param infixe : Vrai pour l'ordre infixe, Faux pour l'ordre préfixe.
+ */
+void commencer_morris_arbre_binaire(struct arbre_binaire_morris* morris,
+                                    arbre_binaire* arbre, bool infixe);
+
+/**
+ *  \brief Passe au noeud suivant d'un parcours de Morris. Les enfants du
+ *         noeud rendu sont ses vrais enfants jusqu'à l'appel suivant; les
+ *         autres noeuds peuvent être reliés temporairement.
+ *
+ *  \param morris     : L'état du parcours.
+ *  \param profondeur : Reçoit la profondeur du noeud rendu.
+ *
+ *  \return Le noeud suivant, ou NULL à la fin du parcours.
+ */
+arbre_binaire* suivant_morris_arbre_binaire(struct arbre_binaire_morris* morris,
+                                           int* profondeur);
+
+/**
+ *  \brief Termine un parcours de Morris, même inachevé: les liens
+ *         temporaires qui restent sont retirés.
+ *
+ *  \param morris : L'état du parcours.
+ */
+void terminer_morris_arbre_binaire(struct arbre_binaire_morris* morris);
+
+/**
+ *  \brief Ordre des parcours qui lisent l'arbre sans le modifier (nombres
+ *         d'éléments, recherches): ARBRE_BINAIRE_PREFIXE_MORRIS si l'arbre
+ *         a été créé avec ARBRE_BINAIRE_OPTION_MORRIS, sinon
+ *         ARBRE_BINAIRE_PREFIXE.
+ *
+ *  \param arbre : L'arbre à parcourir (peut être NULL).
+ *
+ *  \return L'ordre à utiliser.
+ */
+arbre_binaire_ordre ordre_lecture_arbre_binaire(arbre_binaire* arbre);
+
+/**
+ *  \brief Prépare la modification d'un noeud d'un arbre persistant: les
+ *         noeuds partagés avec un instantané, de la racine jusqu'au noeud,
+ *         sont remplacés par des copies. Hors du mode persistant, le noeud
+ *         est rendu tel quel.
+ *
+ *  \param arbre : Le noeud à modifier.
+ *
+ *  \return Le noeud à modifier dans la version courante, ou NULL (avec une
+ *          erreur) s'il n'appartient pas à la version courante ou s'il n'y
+ *          a plus de mémoire.
+ */
+arbre_binaire* preparer_ecriture_arbre_binaire(arbre_binaire* arbre);
+
+/**
+ *  \brief Libère une référence vers un noeud persistant. Les noeuds qui
+ *         ne sont plus référencés sont libérés. Si le noeud est la racine
+ *         d'une version, le contexte est libéré avec la dernière version.
+ *
+ *  \param arbre : Le noeud à libérer.
+ */
+void detruire_persistant_arbre_binaire(arbre_binaire* arbre);
+
+/**
+ *  \brief Indique si un noeud d'un arbre persistant appartient à la
+ *         version courante (et non seulement à un instantané).
+ *
+ *  \param arbre : Le noeud.
+ *
+ *  \return Vrai si ses parents mènent à la racine de la version courante.
+ */
+bool version_courante_arbre_binaire(arbre_binaire* arbre);
+
+/**
+ *  \brief Copie un sous-arbre, noeud par noeud, sous un noeud déjà alloué
+ *         (qui peut appartenir à un autre arbre). Les parents et les
+ *         informations étendues du noeud et de ses copies sont remplis
+ *         selon les options de son arbre.
+ *
+ *  \param copie  : Le noeud qui reçoit la copie de la racine du sous-arbre.
+ *  \param source : Le sous-arbre à copier.
+ *
+ *  \return Faux s'il n'y a plus de mémoire. La copie est alors incomplète,
+ *          mais ses liens sont valides: elle peut être libérée.
+ */
+bool copier_sous_arbre_binaire(arbre_binaire* copie, arbre_binaire* source);
+
+#endif // ARBRE_BINAIRE_INTERNE_H_INCLUDED
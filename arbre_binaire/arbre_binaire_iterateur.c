@@ -0,0 +1,249 @@
+/*
+
+    Copyright (c) 2015 Nicolas Bisson
+
+    L'autorisation est accordée, gracieusement, à toute personne acquérant une
+    copie de cette bibliothèque et des fichiers de documentation associés
+    (la "Bibliothèque"), de commercialiser la Bibliothèque sans restriction,
+    notamment les droits d'utiliser, de copier, de modifier, de fusionner, de
+    publier, de distribuer, de sous-licencier et / ou de vendre des copies de
+    la Bibliothèque, ainsi que d'autoriser les personnes auxquelles la
+    Bibliothèque est fournie à le faire, sous réserve des conditions suivantes:
+
+    La déclaration de copyright ci-dessus et la présente autorisation doivent
+    être incluses dans toutes copies ou parties substantielles de la
+    Bibliothèque.
+
+    LA BIBLIOTHÈQUE EST FOURNIE "TELLE QUELLE", SANS GARANTIE D'AUCUNE SORTE,
+    EXPLICITE OU IMPLICITE, NOTAMMENT SANS GARANTIE DE QUALITÉ MARCHANDE,
+    D’ADÉQUATION À UN USAGE PARTICULIER ET D'ABSENCE DE CONTREFAÇON. EN AUCUN
+    CAS, LES AUTEURS OU TITULAIRES DU DROIT D'AUTEUR NE SERONT RESPONSABLES DE
+    TOUT DOMMAGE, RÉCLAMATION OU AUTRE RESPONSABILITÉ, QUE CE SOIT DANS LE
+    CADRE D'UN CONTRAT, D'UN DÉLIT OU AUTRE, EN PROVENANCE DE, CONSÉCUTIF À OU
+    EN RELATION AVEC LA BIBLIOTHÈQUE OU SON UTILISATION, OU AVEC D'AUTRES
+    ÉLÉMENTS DE LA BIBLIOTHÈQUE.
+
+*/
+
+/**
+ *  \file arbre_binaire_iterateur.c
+ *
+ *  Parcours infixe pas à pas d'un arbre créé avec
+ *  ARBRE_BINAIRE_OPTION_PARENT. L'itérateur ne conserve que le noeud
+ *  courant: pour passer au noeud suivant, il descend dans le second
+ *  sous-arbre ou remonte les parents jusqu'au premier ancêtre dont il vient
+ *  du premier sous-arbre. Chaque lien est ainsi suivi au plus deux fois
+ *  pendant un parcours complet, sans pile ni récursion.
+ *
+ */
+
+#include <stdlib.h>
+#include "arbre_binaire.h"
+#include "arbre_binaire_interne.h"
+
+/**
+ *  \brief Vérifie que l'arbre peut être parcouru par un itérateur et
+ *         inscrit une erreur sinon.
+ *
+ *  \param arbre : L'arbre à vérifier.
+ *
+ *  \return ARBRE_BINAIRE_SUCCES si l'arbre peut être parcouru.
+ */
+static arbre_binaire_statut verifier_parent(arbre_binaire* arbre)
+{
+    arbre_binaire_statut statut = ARBRE_BINAIRE_SUCCES;
+
+    retirer_erreur_arbre_binaire(arbre);
+    if (arbre == NULL) {
+        statut = ARBRE_BINAIRE_ERREUR_INEXISTANT;
+    } else if ((arbre->contexte->options & ARBRE_BINAIRE_OPTION_PARENT) == 0) {
+        statut = inscrire_erreur_arbre_binaire(arbre, "L'arbre n'a pas de \
+lien vers les parents.");
+    } else if (arbre->contexte->options & ARBRE_BINAIRE_OPTION_PERSISTANT &&
+               version_courante_arbre_binaire(arbre) == false) {
+        /* Les parents d'un noeud partagé sont ceux de la version courante:
+           ils ne permettent pas de parcourir un instantané. */
+        statut = inscrire_erreur_arbre_binaire(arbre, "Le noeud n'appartient \
+pas a la version courante de l'arbre.");
+    }
+    return statut;
+}
+
+/**
+ *  \brief Donne le premier ou le second enfant d'un noeud.
+ */
+static arbre_binaire* enfant(arbre_binaire* noeud, bool premier)
+{
+    arbre_binaire* resultat;
+
+    if (premier) {
+        resultat = noeud->premier_fils;
+    } else {
+        resultat = noeud->second_fils;
+    }
+    return resultat;
+}
+
+/**
+ *  \brief Descend toujours du même côté à partir d'un noeud.
+ *
+ *  \param noeud   : Le noeud de départ.
+ *  \param premier : Vrai pour le premier noeud du sous-arbre, Faux pour le
+ *                   dernier.
+ *
+ *  \return Le premier (ou le dernier) noeud du sous-arbre.
+ */
+static arbre_binaire* extremite(arbre_binaire* noeud, bool premier)
+{
+    while (enfant(noeud, premier)) {
+        noeud = enfant(noeud, premier);
+    }
+    return noeud;
+}
+
+/**
+ *  \brief Place un itérateur dans un sous-arbre, hors du parcours.
+ *
+ *  \param iterateur : L'itérateur à placer.
+ *  \param arbre     : Le sous-arbre, ou NULL si l'arbre ne peut pas être
+ *                     parcouru (l'itérateur ne donne alors que NULL).
+ */
+static void placer(arbre_binaire_iterateur* iterateur, arbre_binaire* arbre)
+{
+    iterateur->racine = arbre;
+    iterateur->courant = NULL;
+    iterateur->apres_fin = true;
+}
+
+/**
+ *  \brief Déplace un itérateur d'un noeud en ordre infixe.
+ *
+ *  \param iterateur : L'itérateur à déplacer.
+ *  \param avant     : Vrai pour le noeud suivant, Faux pour le précédent.
+ *
+ *  \return Le nouveau noeud courant, ou NULL hors du parcours.
+ */
+static arbre_binaire* avancer(arbre_binaire_iterateur* iterateur, bool avant)
+{
+    arbre_binaire* noeud = iterateur->courant;
+    arbre_binaire* parent;
+
+    if (iterateur->racine == NULL) {
+    } else if (noeud == NULL) {
+        if (iterateur->apres_fin != avant) {
+            iterateur->courant = extremite(iterateur->racine, avant);
+        }
+    } else if (enfant(noeud, !avant)) {
+        iterateur->courant = extremite(enfant(noeud, !avant), avant);
+    } else {
+        parent = NOEUD_PARENT(noeud)->parent;
+        while (noeud != iterateur->racine && enfant(parent, !avant) == noeud) {
+            noeud = parent;
+            parent = NOEUD_PARENT(noeud)->parent;
+        }
+        if (noeud == iterateur->racine) {
+            iterateur->courant = NULL;
+            iterateur->apres_fin = avant;
+        } else {
+            iterateur->courant = parent;
+        }
+    }
+    return iterateur->courant;
+}
+
+/**
+ *  \brief Place un itérateur sur le premier noeud (en ordre infixe) d'un
+ *         arbre créé avec ARBRE_BINAIRE_OPTION_PARENT.
+ *
+ *  \param iterateur : L'itérateur à placer.
+ *  \param arbre     : L'arbre (ou le sous-arbre) à parcourir.
+ *
+ *  \return Le premier noeud, ou NULL en cas d'erreur.
+ */
+arbre_binaire* commencer_iterateur_arbre_binaire(
+        arbre_binaire_iterateur* iterateur, arbre_binaire* arbre)
+{
+    if (verifier_parent(arbre) == ARBRE_BINAIRE_SUCCES) {
+        placer(iterateur, arbre);
+        iterateur->apres_fin = false;
+    } else {
+        placer(iterateur, NULL);
+    }
+    return avancer(iterateur, true);
+}
+
+/**
+ *  \brief Place un itérateur sur le dernier noeud (en ordre infixe) d'un
+ *         arbre créé avec ARBRE_BINAIRE_OPTION_PARENT.
+ *
+ *  \param iterateur : L'itérateur à placer.
+ *  \param arbre     : L'arbre (ou le sous-arbre) à parcourir.
+ *
+ *  \return Le dernier noeud, ou NULL en cas d'erreur.
+ */
+arbre_binaire* finir_iterateur_arbre_binaire(
+        arbre_binaire_iterateur* iterateur, arbre_binaire* arbre)
+{
+    if (verifier_parent(arbre) == ARBRE_BINAIRE_SUCCES) {
+        placer(iterateur, arbre);
+    } else {
+        placer(iterateur, NULL);
+    }
+    return avancer(iterateur, false);
+}
+
+/**
+ *  \brief Place un itérateur, dans un arbre ordonné créé avec
+ *         ARBRE_BINAIRE_OPTION_PARENT, sur le noeud ayant la plus petite
+ *         valeur qui est plus grande ou égale à "valeur".
+ *
+ *  \param iterateur : L'itérateur à placer.
+ *  \param arbre     : L'arbre (ou le sous-arbre) à parcourir.
+ *  \param valeur    : La valeur de référence.
+ *
+ *  \return Le noeud trouvé, ou NULL si toutes les valeurs sont plus petites
+ *          (l'itérateur est alors après le dernier noeud) ou en cas
+ *          d'erreur.
+ */
+arbre_binaire* chercher_iterateur_arbre_binaire(
+        arbre_binaire_iterateur* iterateur, arbre_binaire* arbre, int valeur)
+{
+    placer(iterateur, NULL);
+    if (verifier_parent(arbre) == ARBRE_BINAIRE_SUCCES) {
+        iterateur->courant = borne_inferieure_arbre_binaire(arbre, valeur);
+        if (a_erreur_arbre_binaire(arbre) == false) {
+            iterateur->racine = arbre;
+        }
+    }
+    return iterateur->courant;
+}
+
+/**
+ *  \brief Avance un itérateur au noeud suivant, en temps constant amorti.
+ *         Après le dernier noeud, l'itérateur ne donne plus que NULL;
+ *         avant le premier, il donne le premier noeud.
+ *
+ *  \param iterateur : L'itérateur à avancer.
+ *
+ *  \return Le noeud suivant, ou NULL à la fin du parcours.
+ */
+arbre_binaire* suivant_iterateur_arbre_binaire(
+        arbre_binaire_iterateur* iterateur)
+{
+    return avancer(iterateur, true);
+}
+
+/**
+ *  \brief Recule un itérateur au noeud précédent, en temps constant amorti.
+ *         Avant le premier noeud, l'itérateur ne donne plus que NULL;
+ *         après le dernier, il donne le dernier noeud.
+ *
+ *  \param iterateur : L'itérateur à reculer.
+ *
+ *  \return Le noeud précédent, ou NULL au début du parcours.
+ */
+arbre_binaire* precedent_iterateur_arbre_binaire(
+        arbre_binaire_iterateur* iterateur)
+{
+    return avancer(iterateur, false);
+}
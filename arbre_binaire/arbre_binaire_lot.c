@@ -0,0 +1,229 @@
+/*
+
+    Copyright (c) 2015 Nicolas Bisson
+
+    L'autorisation est accordée, gracieusement, à toute personne acquérant une
+    copie de cette bibliothèque et des fichiers de documentation associés
+    (la "Bibliothèque"), de commercialiser la Bibliothèque sans restriction,
+    notamment les droits d'utiliser, de copier, de modifier, de fusionner, de
+    publier, de distribuer, de sous-licencier et / ou de vendre des copies de
+    la Bibliothèque, ainsi que d'autoriser les personnes auxquelles la
+    Bibliothèque est fournie à le faire, sous réserve des conditions suivantes:
+
+    La déclaration de copyright ci-dessus et la présente autorisation doivent
+    être incluses dans toutes copies ou parties substantielles de la
+    Bibliothèque.
+
+    LA BIBLIOTHÈQUE EST FOURNIE "TELLE QUELLE", SANS GARANTIE D'AUCUNE SORTE,
+    EXPLICITE OU IMPLICITE, NOTAMMENT SANS GARANTIE DE QUALITÉ MARCHANDE,
+    D’ADÉQUATION À UN USAGE PARTICULIER ET D'ABSENCE DE CONTREFAÇON. EN AUCUN
+    CAS, LES AUTEURS OU TITULAIRES DU DROIT D'AUTEUR NE SERONT RESPONSABLES DE
+    TOUT DOMMAGE, RÉCLAMATION OU AUTRE RESPONSABILITÉ, QUE CE SOIT DANS LE
+    CADRE D'UN CONTRAT, D'UN DÉLIT OU AUTRE, EN PROVENANCE DE, CONSÉCUTIF À OU
+    EN RELATION AVEC LA BIBLIOTHÈQUE OU SON UTILISATION, OU AVEC D'AUTRES
+    ÉLÉMENTS DE LA BIBLIOTHÈQUE.
+
+*/
+
+/**
+ *  \file arbre_binaire_lot.c
+ *
+ *  Recherche de plusieurs valeurs à la fois. Dans un arbre ordonné, les
+ *  recherches sont entrelacées: chacune avance d'un niveau à tour de rôle
+ *  et le prochain noeud de chacune est préchargé, ce qui laisse plusieurs
+ *  lectures de la mémoire en cours en même temps au lieu d'attendre chaque
+ *  noeud l'un après l'autre. Dans un arbre qui n'est pas ordonné, l'arbre
+ *  n'est parcouru qu'une seule fois: les valeurs des noeuds sont copiées
+ *  par blocs et chaque bloc est comparé à toutes les valeurs cherchées.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "arbre_binaire.h"
+#include "arbre_binaire_interne.h"
+
+/**
+ *  \brief Nombre de recherches entrelacées dans un arbre ordonné.
+ */
+#define LOT_GROUPE 16
+
+/**
+ *  \brief Nombre de valeurs copiées avant d'être comparées aux valeurs
+ *         cherchées (8 Ko).
+ */
+#define LOT_BLOC 2048
+
+#ifdef __GNUC__
+#define PRECHARGER(adresse) __builtin_prefetch(adresse)
+#else
+#define PRECHARGER(adresse) ((void)(adresse))
+#endif
+
+/**
+ *  \brief Recherche en cours dans un arbre ordonné.
+ */
+struct recherche_lot {
+    arbre_binaire* noeud;   /**< Prochain noeud à comparer. */
+    int indice;             /**< Indice de la valeur cherchée. */
+};
+
+/**
+ *  \brief Valeurs des noeuds en attente d'être comparées.
+ */
+struct bloc_lot {
+    int valeurs[LOT_BLOC];
+    size_t nombre;
+    const int* cherchees;
+    int k;
+    unsigned char* resultats;
+    size_t trouvees;
+};
+
+/**
+ *  \brief Marque une valeur comme présente.
+ */
+static inline void marquer_resultat(unsigned char* resultats, int i)
+{
+    resultats[i / 8] = resultats[i / 8] | 1 << (i % 8);
+}
+
+/**
+ *  \brief Cherche les valeurs dans un arbre ordonné en entrelaçant
+ *         jusqu'à LOT_GROUPE recherches.
+ *
+ *  \return Le nombre de valeurs présentes.
+ */
+static int chercher_entrelace(arbre_binaire* arbre, const int* valeurs,
+                              int nombre, unsigned char* resultats)
+{
+    struct recherche_lot recherches[LOT_GROUPE];
+    arbre_binaire* noeud;
+    int actives = 0;
+    int suivante = 0;
+    int trouvees = 0;
+    int i = 0;
+
+    while (suivante < nombre && actives < LOT_GROUPE) {
+        recherches[actives].noeud = arbre;
+        recherches[actives].indice = suivante;
+        actives = actives + 1;
+        suivante = suivante + 1;
+    }
+    while (actives > 0) {
+        noeud = recherches[i].noeud;
+        STATISTIQUE_VISITE();
+        if (noeud->valeur == valeurs[recherches[i].indice]) {
+            marquer_resultat(resultats, recherches[i].indice);
+            trouvees = trouvees + 1;
+            noeud = NULL;
+        } else if (valeurs[recherches[i].indice] < noeud->valeur) {
+            noeud = noeud->premier_fils;
+        } else {
+            noeud = noeud->second_fils;
+        }
+        if (noeud) {
+            PRECHARGER(noeud);
+            recherches[i].noeud = noeud;
+            i = i + 1;
+        } else if (suivante < nombre) {
+            recherches[i].noeud = arbre;
+            recherches[i].indice = suivante;
+            suivante = suivante + 1;
+            i = i + 1;
+        } else {
+            /* La dernière recherche prend la place de celle terminée. */
+            actives = actives - 1;
+            recherches[i] = recherches[actives];
+        }
+        if (i >= actives) {
+            i = 0;
+        }
+    }
+    return trouvees;
+}
+
+/**
+ *  \brief Compare les valeurs du bloc aux valeurs qui n'ont pas encore été
+ *         trouvées, puis vide le bloc.
+ */
+static void comparer_bloc(struct bloc_lot* bloc)
+{
+    bloc->trouvees = chercher_valeurs_tableau(bloc->valeurs, bloc->nombre,
+                                              bloc->cherchees,
+                                              (size_t)bloc->k,
+                                              bloc->resultats);
+    bloc->nombre = 0;
+}
+
+/**
+ *  \brief Visiteur qui copie la valeur du noeud dans le bloc. Le parcours
+ *         s'arrête lorsque toutes les valeurs ont été trouvées.
+ */
+static bool copier_valeur(arbre_binaire* noeud, int profondeur,
+                          void* donnees)
+{
+    struct bloc_lot* bloc = donnees;
+
+    bloc->valeurs[bloc->nombre] = LIRE_VALEUR(noeud);
+    bloc->nombre = bloc->nombre + 1;
+    if (bloc->nombre == LOT_BLOC) {
+        comparer_bloc(bloc);
+    }
+    return bloc->trouvees < (size_t)bloc->k;
+}
+
+/**
+ *  \brief Vérifie quelles valeurs sont dans un arbre binaire. Un arbre qui
+ *         n'est pas ordonné n'est parcouru qu'une seule fois pour toutes
+ *         les valeurs.
+ *
+ *  \param arbre     : L'arbre dans lequel chercher.
+ *  \param valeurs   : Les valeurs à chercher.
+ *  \param nombre    : Le nombre de valeurs à chercher.
+ *  \param resultats : Reçoit un bit par valeur (le bit i % 8 de l'octet
+ *                     i / 8), à 1 si valeurs[i] est présente. Le tableau
+ *                     doit contenir (nombre + 7) / 8 octets.
+ *
+ *  \return Le nombre de valeurs présentes.
+ */
+int contient_elements_arbre_binaire(arbre_binaire* arbre, const int* valeurs,
+                                    int nombre, unsigned char* resultats)
+{
+    struct bloc_lot* bloc;
+    int trouvees = 0;
+
+    retirer_erreur_arbre_binaire(arbre);
+    if (nombre > 0) {
+        memset(resultats, 0, (nombre + 7) / 8);
+    }
+    if (arbre == NULL || nombre <= 0) {
+        return 0;
+    }
+    STATISTIQUE_DEBUT(ARBRE_BINAIRE_FONCTION_CONTIENT_LOT);
+    if (arbre->contexte->options & ARBRE_BINAIRE_OPTION_ORDONNE) {
+        trouvees = chercher_entrelace(arbre, valeurs, nombre, resultats);
+    } else {
+        bloc = malloc(sizeof(struct bloc_lot));
+        if (bloc) {
+            bloc->nombre = 0;
+            bloc->cherchees = valeurs;
+            bloc->k = nombre;
+            bloc->resultats = resultats;
+            bloc->trouvees = 0;
+            if (parcourir_arbre_binaire(arbre,
+                                        ordre_lecture_arbre_binaire(arbre),
+                                        copier_valeur, bloc) &&
+                bloc->nombre > 0) {
+                comparer_bloc(bloc);
+            }
+            trouvees = (int)bloc->trouvees;
+            free(bloc);
+        } else {
+            inscrire_erreur_arbre_binaire(arbre, "Il n'y a plus de \
+memoire.");
+        }
+    }
+    STATISTIQUE_FIN();
+    return trouvees;
+}
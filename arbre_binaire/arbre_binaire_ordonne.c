@@ -0,0 +1,469 @@
+/*
+
+    Copyright (c) 2015 Nicolas Bisson
+
+    L'autorisation est accordée, gracieusement, à toute personne acquérant une
+    copie de cette bibliothèque et des fichiers de documentation associés
+    (la "Bibliothèque"), de commercialiser la Bibliothèque sans restriction,
+    notamment les droits d'utiliser, de copier, de modifier, de fusionner, de
+    publier, de distribuer, de sous-licencier et / ou de vendre des copies de
+    la Bibliothèque, ainsi que d'autoriser les personnes auxquelles la
+    Bibliothèque est fournie à le faire, sous réserve des conditions suivantes:
+
+    La déclaration de copyright ci-dessus et la présente autorisation doivent
+    être incluses dans toutes copies ou parties substantielles de la
+    Bibliothèque.
+
+    LA BIBLIOTHÈQUE EST FOURNIE "TELLE QUELLE", SANS GARANTIE D'AUCUNE SORTE,
+    EXPLICITE OU IMPLICITE, NOTAMMENT SANS GARANTIE DE QUALITÉ MARCHANDE,
+    D’ADÉQUATION À UN USAGE PARTICULIER ET D'ABSENCE DE CONTREFAÇON. EN AUCUN
+    CAS, LES AUTEURS OU TITULAIRES DU DROIT D'AUTEUR NE SERONT RESPONSABLES DE
+    TOUT DOMMAGE, RÉCLAMATION OU AUTRE RESPONSABILITÉ, QUE CE SOIT DANS LE
+    CADRE D'UN CONTRAT, D'UN DÉLIT OU AUTRE, EN PROVENANCE DE, CONSÉCUTIF À OU
+    EN RELATION AVEC LA BIBLIOTHÈQUE OU SON UTILISATION, OU AVEC D'AUTRES
+    ÉLÉMENTS DE LA BIBLIOTHÈQUE.
+
+*/
+
+/**
+ *  \file arbre_binaire_ordonne.c
+ *
+ *  Fonctions des arbres créés avec ARBRE_BINAIRE_OPTION_ORDONNE (arbres
+ *  binaires de recherche). Les valeurs du premier sous-arbre d'un noeud
+ *  sont plus petites que la sienne et celles du second sont plus grandes.
+ *
+ *  La racine d'un arbre ordonné ne change jamais d'adresse: lorsqu'elle
+ *  doit être retirée, le contenu d'un autre noeud y est déplacé. Avec
+ *  ARBRE_BINAIRE_OPTION_EQUILIBRE, l'arbre est un arbre AVL dont les
+ *  rotations déplacent les valeurs plutôt que les noeuds.
+ *
+ */
+
+#include <stdlib.h>
+#include "arbre_binaire.h"
+#include "arbre_binaire_interne.h"
+
+/**
+ *  \brief Vérifie que l'arbre est ordonné et inscrit une erreur sinon.
+ *
+ *  \param arbre : L'arbre à vérifier.
+ *
+ *  \return ARBRE_BINAIRE_SUCCES si l'arbre peut être utilisé.
+ */
+static arbre_binaire_statut verifier_ordonne(arbre_binaire* arbre)
+{
+    arbre_binaire_statut statut = ARBRE_BINAIRE_SUCCES;
+
+    if (arbre == NULL) {
+        statut = ARBRE_BINAIRE_ERREUR_INEXISTANT;
+    } else if ((arbre->contexte->options & ARBRE_BINAIRE_OPTION_ORDONNE) == 0) {
+        statut = inscrire_erreur_arbre_binaire(arbre, "L'arbre n'est pas \
+ordonne.");
+    }
+    return statut;
+}
+
+/**
+ *  \brief Hauteur d'un sous-arbre étendu (0 s'il est vide).
+ */
+static int hauteur_noeud(arbre_binaire* arbre)
+{
+    int hauteur = 0;
+
+    if (arbre) {
+        hauteur = NOEUD_ETENDU(arbre)->hauteur;
+    }
+    return hauteur;
+}
+
+/**
+ *  \brief Indique à un enfant quel est son parent.
+ */
+static void changer_parent(arbre_binaire* enfant, arbre_binaire* parent)
+{
+    if (enfant) {
+        NOEUD_PARENT(enfant)->parent = parent;
+    }
+}
+
+/**
+ *  \brief Rotation qui monte le premier (ou le second) enfant d'un noeud.
+ *         Les valeurs sont échangées pour que le noeud du haut garde son
+ *         adresse: son parent (ou l'arbre, s'il est la racine) n'a donc
+ *         pas à être modifié.
+ *
+ *  \param noeud   : Le noeud qui descend.
+ *  \param premier : Vrai pour monter le premier enfant, Faux pour le second.
+ */
+static void tourner(arbre_binaire* noeud, bool premier)
+{
+    arbre_binaire* enfant;
+    int valeur;
+
+    if (premier) {
+        enfant = noeud->premier_fils;
+        noeud->premier_fils = enfant->premier_fils;
+        enfant->premier_fils = enfant->second_fils;
+        enfant->second_fils = noeud->second_fils;
+        noeud->second_fils = enfant;
+        changer_parent(noeud->premier_fils, noeud);
+    } else {
+        enfant = noeud->second_fils;
+        noeud->second_fils = enfant->second_fils;
+        enfant->second_fils = enfant->premier_fils;
+        enfant->premier_fils = noeud->premier_fils;
+        noeud->premier_fils = enfant;
+        changer_parent(noeud->second_fils, noeud);
+    }
+    changer_parent(enfant->premier_fils, enfant);
+    changer_parent(enfant->second_fils, enfant);
+    valeur = noeud->valeur;
+    noeud->valeur = enfant->valeur;
+    enfant->valeur = valeur;
+    calculer_noeud_etendu_arbre_binaire(enfant);
+    calculer_noeud_etendu_arbre_binaire(noeud);
+}
+
+/**
+ *  \brief Recalcule un noeud et tous ses ancêtres en rétablissant, dans un
+ *         arbre équilibré, l'écart d'au plus 1 entre les hauteurs des deux
+ *         sous-arbres de chaque noeud (arbre AVL).
+ *
+ *  \param noeud : Le premier noeud à vérifier.
+ */
+static void equilibrer(arbre_binaire* noeud)
+{
+    int ecart;
+
+    while (noeud) {
+        ecart = hauteur_noeud(noeud->premier_fils) -
+                hauteur_noeud(noeud->second_fils);
+        if (ecart > 1) {
+            if (hauteur_noeud(noeud->premier_fils->premier_fils) <
+                hauteur_noeud(noeud->premier_fils->second_fils)) {
+                tourner(noeud->premier_fils, false);
+            }
+            tourner(noeud, true);
+        } else if (ecart < -1) {
+            if (hauteur_noeud(noeud->second_fils->second_fils) <
+                hauteur_noeud(noeud->second_fils->premier_fils)) {
+                tourner(noeud->second_fils, true);
+            }
+            tourner(noeud, false);
+        } else {
+            calculer_noeud_etendu_arbre_binaire(noeud);
+        }
+        noeud = NOEUD_ETENDU(noeud)->parent;
+    }
+}
+
+/**
+ *  \brief Relie un enfant à son parent et met à jour les informations des
+ *         noeuds étendus (et rééquilibre l'arbre) après qu'un enfant de
+ *         "parent" ait été ajouté ou retiré.
+ *
+ *  \param parent : Le noeud dont un lien vers un enfant a changé.
+ *  \param enfant : Le nouvel enfant de ce noeud (peut être NULL).
+ */
+static void relier_parent(arbre_binaire* parent, arbre_binaire* enfant)
+{
+    unsigned int options = parent->contexte->options;
+
+    if (options & ARBRE_BINAIRE_OPTION_PARENT) {
+        changer_parent(enfant, parent);
+    }
+    if (options & ARBRE_BINAIRE_OPTION_AUGMENTE) {
+        if (options & ARBRE_BINAIRE_OPTION_EQUILIBRE) {
+            equilibrer(parent);
+        } else {
+            mettre_a_jour_ancetres_arbre_binaire(parent);
+        }
+    }
+}
+
+/**
+ *  \brief Ajoute une valeur dans un arbre ordonné. Si la valeur est déjà
+ *         présente, l'arbre n'est pas modifié.
+ *
+ *  \param arbre  : L'arbre ordonné dans lequel ajouter la valeur.
+ *  \param valeur : La valeur à ajouter.
+ *
+ *  \return ARBRE_BINAIRE_SUCCES si la valeur est dans l'arbre.
+ */
+arbre_binaire_statut inserer_element_arbre_binaire(arbre_binaire* arbre,
+                                                   int valeur)
+{
+    arbre_binaire_statut statut;
+    arbre_binaire* noeud = arbre;
+    arbre_binaire** lien = NULL;
+
+    retirer_erreur_arbre_binaire(arbre);
+    STATISTIQUE_DEBUT(ARBRE_BINAIRE_FONCTION_INSERER);
+    statut = verifier_ordonne(arbre);
+    while (statut == ARBRE_BINAIRE_SUCCES && noeud && noeud->valeur != valeur) {
+        STATISTIQUE_VISITE();
+        if (valeur < noeud->valeur) {
+            lien = &noeud->premier_fils;
+        } else {
+            lien = &noeud->second_fils;
+        }
+        if (*lien) {
+            noeud = *lien;
+        } else {
+            *lien = allouer_noeud_arbre_binaire(arbre->contexte, valeur);
+            if (*lien) {
+                relier_parent(noeud, *lien);
+            } else {
+                statut = inscrire_erreur_arbre_binaire(arbre, "Il n'y a plus \
+de memoire.");
+            }
+            noeud = NULL;
+        }
+    }
+    STATISTIQUE_FIN();
+    return statut;
+}
+
+/**
+ *  \brief Retire une valeur d'un arbre ordonné.
+ *
+ *  \param arbre  : L'arbre ordonné duquel retirer la valeur.
+ *  \param valeur : La valeur à retirer.
+ *
+ *  \return ARBRE_BINAIRE_SUCCES si la valeur a été retirée.
+ *
+ *  \note  La racine ne peut pas être retirée si elle est le seul élément
+ *         de l'arbre.
+ */
+arbre_binaire_statut supprimer_element_arbre_binaire(arbre_binaire* arbre,
+                                                     int valeur)
+{
+    arbre_binaire_statut statut;
+    arbre_binaire* parent = NULL;
+    arbre_binaire* noeud = arbre;
+    arbre_binaire* retire;
+    arbre_binaire* enfant;
+    arbre_binaire** lien = NULL;
+
+    retirer_erreur_arbre_binaire(arbre);
+    STATISTIQUE_DEBUT(ARBRE_BINAIRE_FONCTION_SUPPRIMER);
+    statut = verifier_ordonne(arbre);
+    while (statut == ARBRE_BINAIRE_SUCCES && noeud && noeud->valeur != valeur) {
+        STATISTIQUE_VISITE();
+        parent = noeud;
+        if (valeur < noeud->valeur) {
+            lien = &noeud->premier_fils;
+        } else {
+            lien = &noeud->second_fils;
+        }
+        noeud = *lien;
+    }
+    if (statut != ARBRE_BINAIRE_SUCCES) {
+    } else if (noeud == NULL) {
+        statut = inscrire_erreur_arbre_binaire(arbre, "La valeur n'est pas \
+dans l'arbre.");
+    } else if (noeud->premier_fils && noeud->second_fils) {
+        /* Le successeur (le plus petit du second sous-arbre) prend la place
+           de la valeur retirée. */
+        parent = noeud;
+        lien = &noeud->second_fils;
+        while ((*lien)->premier_fils) {
+            STATISTIQUE_VISITE();
+            parent = *lien;
+            lien = &(*lien)->premier_fils;
+        }
+        retire = *lien;
+        noeud->valeur = retire->valeur;
+        *lien = retire->second_fils;
+        liberer_noeud_arbre_binaire(retire);
+        relier_parent(parent, *lien);
+    } else {
+        enfant = noeud->premier_fils ? noeud->premier_fils : noeud->second_fils;
+        if (parent) {
+            *lien = enfant;
+            liberer_noeud_arbre_binaire(noeud);
+            relier_parent(parent, enfant);
+        } else if (enfant) {
+            /* La racine garde son adresse et reçoit le contenu de son seul
+               enfant. */
+            noeud->valeur = enfant->valeur;
+            noeud->premier_fils = enfant->premier_fils;
+            noeud->second_fils = enfant->second_fils;
+            liberer_noeud_arbre_binaire(enfant);
+            if (arbre->contexte->options & ARBRE_BINAIRE_OPTION_PARENT) {
+                changer_parent(noeud->premier_fils, noeud);
+            }
+            relier_parent(noeud, noeud->second_fils);
+        } else {
+            statut = inscrire_erreur_arbre_binaire(arbre, "Le dernier element \
+de l'arbre ne peut pas etre retire.");
+        }
+    }
+    STATISTIQUE_FIN();
+    return statut;
+}
+
+/**
+ *  \brief Cherche le noeud qui contient une valeur dans un arbre ordonné.
+ *
+ *  \param arbre  : L'arbre ordonné dans lequel chercher.
+ *  \param valeur : La valeur à chercher.
+ *
+ *  \return Le noeud contenant la valeur ou NULL si elle est absente.
+ */
+arbre_binaire* chercher_element_arbre_binaire(arbre_binaire* arbre,
+                                              int valeur)
+{
+    arbre_binaire* noeud = NULL;
+
+    retirer_erreur_arbre_binaire(arbre);
+    STATISTIQUE_DEBUT(ARBRE_BINAIRE_FONCTION_CHERCHER);
+    if (verifier_ordonne(arbre) == ARBRE_BINAIRE_SUCCES) {
+        noeud = arbre;
+        while (noeud && noeud->valeur != valeur) {
+            STATISTIQUE_VISITE();
+            if (valeur < noeud->valeur) {
+                noeud = noeud->premier_fils;
+            } else {
+                noeud = noeud->second_fils;
+            }
+        }
+    }
+    STATISTIQUE_FIN();
+    return noeud;
+}
+
+/**
+ *  \brief Cherche le noeud qui contient la plus petite valeur plus grande
+ *         ou égale (ou strictement plus grande) à une valeur.
+ *
+ *  \param arbre    : L'arbre ordonné dans lequel chercher.
+ *  \param valeur   : La valeur de référence.
+ *  \param egalite  : Vrai si une valeur égale est acceptée.
+ *
+ *  \return Le noeud trouvé ou NULL.
+ */
+static arbre_binaire* chercher_borne(arbre_binaire* arbre, int valeur,
+                                     bool egalite)
+{
+    arbre_binaire* borne = NULL;
+    arbre_binaire* noeud = NULL;
+
+    retirer_erreur_arbre_binaire(arbre);
+    if (verifier_ordonne(arbre) == ARBRE_BINAIRE_SUCCES) {
+        noeud = arbre;
+    }
+    while (noeud) {
+        STATISTIQUE_VISITE();
+        if (noeud->valeur > valeur || (egalite && noeud->valeur == valeur)) {
+            borne = noeud;
+            noeud = noeud->premier_fils;
+        } else {
+            noeud = noeud->second_fils;
+        }
+    }
+    return borne;
+}
+
+/**
+ *  \brief Cherche, dans un arbre ordonné, le noeud ayant la plus petite
+ *         valeur qui est plus grande ou égale à "valeur".
+ *
+ *  \param arbre  : L'arbre ordonné dans lequel chercher.
+ *  \param valeur : La valeur de référence.
+ *
+ *  \return Le noeud trouvé ou NULL si toutes les valeurs sont plus petites.
+ */
+arbre_binaire* borne_inferieure_arbre_binaire(arbre_binaire* arbre, int valeur)
+{
+    return chercher_borne(arbre, valeur, true);
+}
+
+/**
+ *  \brief Cherche, dans un arbre ordonné, le noeud ayant la plus petite
+ *         valeur qui est strictement plus grande que "valeur".
+ *
+ *  \param arbre  : L'arbre ordonné dans lequel chercher.
+ *  \param valeur : La valeur de référence.
+ *
+ *  \return Le noeud trouvé ou NULL si aucune valeur n'est plus grande.
+ */
+arbre_binaire* borne_superieure_arbre_binaire(arbre_binaire* arbre, int valeur)
+{
+    return chercher_borne(arbre, valeur, false);
+}
+
+/**
+ * \brief État de la vérification d'un arbre ordonné pendant son parcours
+ *        infixe.
+ */
+struct verification_ordre {
+    bool premier;
+    int precedente;
+    bool trie;
+    bool equilibre;
+};
+
+/**
+ *  \brief Visiteur (infixe) qui vérifie que les valeurs augmentent
+ *         strictement et, pour un arbre équilibré, que les hauteurs des
+ *         enfants diffèrent d'au plus 1.
+ */
+static bool verifier_noeud_ordre(arbre_binaire* noeud, int profondeur,
+                                 void* donnees)
+{
+    struct verification_ordre* verification = donnees;
+    int difference;
+
+    if (verification->premier == false &&
+        LIRE_VALEUR(noeud) <= verification->precedente) {
+        verification->trie = false;
+    }
+    verification->premier = false;
+    verification->precedente = LIRE_VALEUR(noeud);
+    if (noeud->contexte->options & ARBRE_BINAIRE_OPTION_EQUILIBRE) {
+        difference = hauteur_noeud(noeud->premier_fils) -
+                     hauteur_noeud(noeud->second_fils);
+        if (difference < -1 || difference > 1) {
+            verification->equilibre = false;
+        }
+    }
+    return verification->trie && verification->equilibre;
+}
+
+/**
+ *  \brief Vérifie qu'un arbre ordonné construit tel quel (chargement,
+ *         construction à partir de tableaux) respecte ses options: les
+ *         valeurs augmentent strictement en ordre infixe et, avec
+ *         ARBRE_BINAIRE_OPTION_EQUILIBRE, l'arbre est équilibré. Les
+ *         hauteurs doivent avoir été recalculées.
+ *
+ *  \param arbre : La racine de l'arbre.
+ *
+ *  \return NULL si l'arbre est valide (ou n'est pas ordonné), sinon le
+ *          message d'erreur qui décrit le problème.
+ */
+const char* verifier_ordre_arbre_binaire(arbre_binaire* arbre)
+{
+    struct verification_ordre verification;
+    const char* erreur = NULL;
+    bool complet = true;
+
+    verification.premier = true;
+    verification.precedente = 0;
+    verification.trie = true;
+    verification.equilibre = true;
+    if (arbre->contexte->options & ARBRE_BINAIRE_OPTION_ORDONNE) {
+        complet = parcourir_arbre_binaire(arbre, ARBRE_BINAIRE_INFIXE,
+                                          verifier_noeud_ordre,
+                                          &verification);
+    }
+    if (verification.trie == false) {
+        erreur = "Les valeurs ne sont pas triees.";
+    } else if (verification.equilibre == false) {
+        erreur = "L'arbre n'est pas equilibre.";
+    } else if (complet == false) {
+        erreur = "Il n'y a plus de memoire.";
+    }
+    return erreur;
+}
@@ -0,0 +1,606 @@
+/*
+
+    Copyright (c) 2015 Nicolas Bisson
+
+    L'autorisation est accordée, gracieusement, à toute personne acquérant une
+    copie de cette bibliothèque et des fichiers de documentation associés
+    (la "Bibliothèque"), de commercialiser la Bibliothèque sans restriction,
+    notamment les droits d'utiliser, de copier, de modifier, de fusionner, de
+    publier, de distribuer, de sous-licencier et / ou de vendre des copies de
+    la Bibliothèque, ainsi que d'autoriser les personnes auxquelles la
+    Bibliothèque est fournie à le faire, sous réserve des conditions suivantes:
+
+    La déclaration de copyright ci-dessus et la présente autorisation doivent
+    être incluses dans toutes copies ou parties substantielles de la
+    Bibliothèque.
+
+    LA BIBLIOTHÈQUE EST FOURNIE "TELLE QUELLE", SANS GARANTIE D'AUCUNE SORTE,
+    EXPLICITE OU IMPLICITE, NOTAMMENT SANS GARANTIE DE QUALITÉ MARCHANDE,
+    D’ADÉQUATION À UN USAGE PARTICULIER ET D'ABSENCE DE CONTREFAÇON. EN AUCUN
+    CAS, LES AUTEURS OU TITULAIRES DU DROIT D'AUTEUR NE SERONT RESPONSABLES DE
+    TOUT DOMMAGE, RÉCLAMATION OU AUTRE RESPONSABILITÉ, QUE CE SOIT DANS LE
+    CADRE D'UN CONTRAT, D'UN DÉLIT OU AUTRE, EN PROVENANCE DE, CONSÉCUTIF À OU
+    EN RELATION AVEC LA BIBLIOTHÈQUE OU SON UTILISATION, OU AVEC D'AUTRES
+    ÉLÉMENTS DE LA BIBLIOTHÈQUE.
+
+*/
+
+/**
+ *  \file arbre_binaire_parallele.c
+ *
+ *  Versions parallèles des requêtes qui parcourent tout l'arbre. Le fil
+ *  appelant commence seul le parcours; si l'arbre n'est pas terminé après
+ *  PARALLELE_SEQUENTIEL noeuds, les sous-arbres en attente sont répartis
+ *  entre plusieurs fils d'exécution. Chaque fil parcourt ses sous-arbres
+ *  avec sa propre pile et cède le plus ancien (le plus gros) de ses
+ *  sous-arbres en attente lorsqu'un autre fil n'a plus de travail. Les
+ *  fils sans travail volent les sous-arbres cédés par les autres.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "arbre_binaire.h"
+#include "arbre_binaire_interne.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#endif
+
+/**
+ *  \brief Nombre de noeuds parcourus par le fil appelant avant de
+ *         démarrer les autres fils. Les petits arbres sont ainsi parcourus
+ *         sans créer de fil.
+ */
+#define PARALLELE_SEQUENTIEL 65536
+
+/**
+ *  \brief Nombre de noeuds parcourus entre deux vérifications des fils
+ *         en attente de travail et de l'annulation. Un sous-arbre de moins
+ *         de noeuds n'est jamais partagé.
+ */
+#define PARALLELE_PARTAGE 1024
+
+/**
+ *  \brief Nombre maximal de fils d'exécution.
+ */
+#define PARALLELE_TRAVAILLEURS_MAXIMUM 256
+
+/**
+ *  \brief La requête calculée par un parcours parallèle.
+ */
+enum requete_parallele {
+    REQUETE_ELEMENTS,
+    REQUETE_FEUILLES,
+    REQUETE_HAUTEUR,
+    REQUETE_CONTIENT
+};
+
+/**
+ *  \brief Résultat partiel d'un parcours.
+ */
+struct resultat_parallele {
+    int elements;
+    int feuilles;
+    int hauteur;
+    bool trouve;
+};
+
+struct travailleur;
+
+#ifndef _WIN32
+
+/**
+ *  \brief Un sous-arbre à parcourir.
+ */
+struct tache_parallele {
+    arbre_binaire* noeud;
+    int profondeur;
+};
+
+/**
+ *  \brief Sous-arbres cédés par un fil. Le fil propriétaire reprend le
+ *         dernier sous-arbre cédé; les autres volent le premier, qui est
+ *         le plus proche de la racine.
+ */
+struct file_taches {
+    pthread_mutex_t verrou;
+    struct tache_parallele* taches;
+    size_t debut;
+    size_t fin;
+    size_t capacite;
+};
+
+struct travail_parallele;
+
+/**
+ *  \brief Un fil d'exécution d'un parcours parallèle.
+ */
+struct travailleur {
+    struct travail_parallele* travail;
+    struct file_taches file;
+    struct resultat_parallele resultat;
+    pthread_t fil;
+    unsigned int graine;
+};
+
+/**
+ *  \brief État partagé par tous les fils d'un parcours parallèle.
+ */
+struct travail_parallele {
+    enum requete_parallele requete;
+    int valeur;
+    int nombre_travailleurs;
+    struct travailleur* travailleurs;
+    atomic_size_t restantes;    /**< Sous-arbres cédés pas encore terminés. */
+    atomic_int affames;         /**< Fils qui cherchent du travail. */
+    atomic_bool arret;          /**< Le parcours doit s'arrêter. */
+    atomic_bool memoire;        /**< Faux s'il n'y a plus de mémoire. */
+};
+
+/**
+ *  \brief Ajoute un sous-arbre à la file d'un fil.
+ *
+ *  \return Faux s'il n'y a plus de mémoire.
+ */
+static bool ceder_tache(struct file_taches* file, arbre_binaire* noeud,
+                        int profondeur)
+{
+    struct tache_parallele* taches;
+    bool reussi = true;
+
+    pthread_mutex_lock(&file->verrou);
+    if (file->fin == file->capacite && file->debut > 0) {
+        memmove(file->taches, file->taches + file->debut,
+                (file->fin - file->debut) * sizeof(*taches));
+        file->fin = file->fin - file->debut;
+        file->debut = 0;
+    }
+    if (file->fin == file->capacite) {
+        taches = realloc(file->taches, (2 * file->capacite + 16) *
+                                       sizeof(*taches));
+        reussi = taches != NULL;
+        if (reussi) {
+            file->taches = taches;
+            file->capacite = 2 * file->capacite + 16;
+        }
+    }
+    if (reussi) {
+        file->taches[file->fin].noeud = noeud;
+        file->taches[file->fin].profondeur = profondeur;
+        file->fin = file->fin + 1;
+    }
+    pthread_mutex_unlock(&file->verrou);
+    return reussi;
+}
+
+/**
+ *  \brief Retire un sous-arbre de la file d'un fil.
+ *
+ *  \param file    : La file.
+ *  \param tache   : Reçoit le sous-arbre.
+ *  \param premier : Vrai pour voler le premier sous-arbre, Faux pour
+ *                   reprendre le dernier.
+ *
+ *  \return Faux si la file était vide.
+ */
+static bool prendre_tache(struct file_taches* file,
+                          struct tache_parallele* tache, bool premier)
+{
+    bool reussi = false;
+
+    pthread_mutex_lock(&file->verrou);
+    if (file->debut < file->fin) {
+        if (premier) {
+            *tache = file->taches[file->debut];
+            file->debut = file->debut + 1;
+        } else {
+            file->fin = file->fin - 1;
+            *tache = file->taches[file->fin];
+        }
+        if (file->debut == file->fin) {
+            file->debut = 0;
+            file->fin = 0;
+        }
+        reussi = true;
+    }
+    pthread_mutex_unlock(&file->verrou);
+    return reussi;
+}
+
+/**
+ *  \brief Trouve un sous-arbre à parcourir: d'abord dans la file du fil,
+ *         puis dans celle des autres fils en commençant au hasard.
+ *
+ *  \return Faux si aucune file ne contient de sous-arbre.
+ */
+static bool chercher_tache(struct travailleur* travailleur,
+                           struct tache_parallele* tache)
+{
+    struct travail_parallele* travail = travailleur->travail;
+    int nombre = travail->nombre_travailleurs;
+    int depart;
+    int i;
+    bool trouve;
+
+    trouve = prendre_tache(&travailleur->file, tache, false);
+    depart = rand_r(&travailleur->graine) % nombre;
+    for (i = 0; i < nombre && trouve == false; i = i + 1) {
+        trouve = prendre_tache(&travail->travailleurs[(depart + i) % nombre].file,
+                               tache, true);
+    }
+    return trouve;
+}
+
+/**
+ *  \brief Cède le plus ancien sous-arbre en attente dans la pile (le plus
+ *         proche de la racine) aux fils qui cherchent du travail.
+ */
+static void partager_pile(struct travailleur* travailleur,
+                          struct arbre_binaire_pile* pile)
+{
+    struct travail_parallele* travail = travailleur->travail;
+    struct arbre_binaire_element_pile element = pile->elements[0];
+
+    atomic_fetch_add(&travail->restantes, 1);
+    if (ceder_tache(&travailleur->file, element.noeud, element.profondeur)) {
+        pile->nombre = pile->nombre - 1;
+        memmove(pile->elements, pile->elements + 1,
+                pile->nombre * sizeof(element));
+    } else {
+        atomic_fetch_sub(&travail->restantes, 1);
+    }
+}
+
+#endif
+
+/**
+ *  \brief Parcourt les sous-arbres de la pile et accumule le résultat de
+ *         la requête.
+ *
+ *  \param travailleur : Le fil qui parcourt (NULL pour un parcours
+ *                       séquentiel).
+ *  \param requete     : La requête calculée.
+ *  \param valeur      : La valeur cherchée par REQUETE_CONTIENT.
+ *  \param pile        : Les sous-arbres à parcourir.
+ *  \param limite      : Nombre maximal de noeuds à parcourir (0: aucune).
+ *  \param resultat    : Le résultat à compléter.
+ *
+ *  \return Faux s'il n'y a plus de mémoire.
+ */
+static bool explorer(struct travailleur* travailleur,
+                     enum requete_parallele requete, int valeur,
+                     struct arbre_binaire_pile* pile, size_t limite,
+                     struct resultat_parallele* resultat)
+{
+    struct arbre_binaire_element_pile element;
+    arbre_binaire* noeud;
+    arbre_binaire* premier;
+    arbre_binaire* second;
+    size_t visites = 0;
+    bool memoire = true;
+    bool continuer = true;
+
+    while (continuer && memoire && (limite == 0 || visites < limite) &&
+           depiler_pile(pile, &element)) {
+        noeud = element.noeud;
+        premier = LIRE_FILS(noeud, premier_fils);
+        second = LIRE_FILS(noeud, second_fils);
+        visites = visites + 1;
+        if (requete == REQUETE_ELEMENTS) {
+            resultat->elements = resultat->elements + 1;
+        } else if (requete == REQUETE_FEUILLES) {
+            if (premier == NULL && second == NULL) {
+                resultat->feuilles = resultat->feuilles + 1;
+            }
+        } else if (requete == REQUETE_HAUTEUR) {
+            if (element.profondeur > resultat->hauteur) {
+                resultat->hauteur = element.profondeur;
+            }
+        } else if (LIRE_VALEUR(noeud) == valeur) {
+            resultat->trouve = true;
+            continuer = false;
+        }
+        if (second) {
+            memoire = empiler_pile(pile, second, element.profondeur + 1, 0);
+        }
+        if (premier && memoire) {
+            memoire = empiler_pile(pile, premier, element.profondeur + 1, 0);
+        }
+#ifndef _WIN32
+        if (travailleur && visites % PARALLELE_PARTAGE == 0) {
+            if (atomic_load_explicit(&travailleur->travail->arret,
+                                     memory_order_relaxed)) {
+                continuer = false;
+            } else if (memoire && pile->nombre > 1 &&
+                       atomic_load_explicit(&travailleur->travail->affames,
+                                            memory_order_relaxed) > 0) {
+                partager_pile(travailleur, pile);
+            }
+        }
+#endif
+    }
+    if (resultat->trouve || memoire == false) {
+        pile->nombre = 0;
+    }
+    return memoire;
+}
+
+#ifndef _WIN32
+
+/**
+ *  \brief Boucle d'un fil d'exécution: parcourt ses sous-arbres puis vole
+ *         ceux des autres fils jusqu'à ce que tous soient terminés.
+ */
+static void* travailler(void* donnees)
+{
+    struct travailleur* travailleur = donnees;
+    struct travail_parallele* travail = travailleur->travail;
+    struct tache_parallele tache;
+    struct arbre_binaire_pile pile;
+    bool affame = false;
+
+    initialiser_pile(&pile);
+    while (!atomic_load(&travail->arret) &&
+           atomic_load(&travail->restantes) > 0) {
+        if (chercher_tache(travailleur, &tache)) {
+            if (affame) {
+                atomic_fetch_sub(&travail->affames, 1);
+                affame = false;
+            }
+            empiler_pile(&pile, tache.noeud, tache.profondeur, 0);
+            if (!explorer(travailleur, travail->requete, travail->valeur,
+                          &pile, 0, &travailleur->resultat)) {
+                atomic_store(&travail->memoire, false);
+                atomic_store(&travail->arret, true);
+            }
+            if (travailleur->resultat.trouve) {
+                atomic_store(&travail->arret, true);
+            }
+            pile.nombre = 0;
+            atomic_fetch_sub(&travail->restantes, 1);
+        } else {
+            if (affame == false) {
+                atomic_fetch_add(&travail->affames, 1);
+                affame = true;
+            }
+            sched_yield();
+        }
+    }
+    if (affame) {
+        atomic_fetch_sub(&travail->affames, 1);
+    }
+    vider_pile(&pile);
+    return NULL;
+}
+
+/**
+ *  \brief Répartit les sous-arbres en attente entre plusieurs fils et
+ *         attend la fin du parcours.
+ *
+ *  \param travail : Le parcours (requête, valeur et nombre de fils).
+ *  \param pile    : Les sous-arbres qui restent à parcourir.
+ *  \param total   : Le résultat à compléter.
+ *
+ *  \return Faux s'il n'y a plus de mémoire.
+ */
+static bool parcourir_en_parallele(struct travail_parallele* travail,
+                                   struct arbre_binaire_pile* pile,
+                                   struct resultat_parallele* total)
+{
+    struct travailleur* travailleurs;
+    struct resultat_parallele* resultat;
+    int demarres = 1;
+    int i;
+    size_t j;
+
+    travailleurs = calloc(travail->nombre_travailleurs,
+                          sizeof(struct travailleur));
+    if (travailleurs == NULL) {
+        return explorer(NULL, travail->requete, travail->valeur, pile, 0,
+                        total);
+    }
+    travail->travailleurs = travailleurs;
+    atomic_init(&travail->restantes, pile->nombre);
+    atomic_init(&travail->affames, 0);
+    atomic_init(&travail->arret, false);
+    atomic_init(&travail->memoire, true);
+    for (i = 0; i < travail->nombre_travailleurs; i = i + 1) {
+        travailleurs[i].travail = travail;
+        travailleurs[i].graine = i + 1;
+        pthread_mutex_init(&travailleurs[i].file.verrou, NULL);
+    }
+    for (j = 0; j < pile->nombre; j = j + 1) {
+        if (!ceder_tache(&travailleurs[j % travail->nombre_travailleurs].file,
+                         pile->elements[j].noeud,
+                         pile->elements[j].profondeur)) {
+            atomic_store(&travail->memoire, false);
+            atomic_store(&travail->arret, true);
+        }
+    }
+    pile->nombre = 0;
+    for (i = 1; i < travail->nombre_travailleurs; i = i + 1) {
+        if (pthread_create(&travailleurs[i].fil, NULL, travailler,
+                           &travailleurs[i]) == 0) {
+            demarres = demarres + 1;
+        } else {
+            break;
+        }
+    }
+    travailler(&travailleurs[0]);
+    for (i = 1; i < demarres; i = i + 1) {
+        pthread_join(travailleurs[i].fil, NULL);
+    }
+    for (i = 0; i < travail->nombre_travailleurs; i = i + 1) {
+        resultat = &travailleurs[i].resultat;
+        total->elements = total->elements + resultat->elements;
+        total->feuilles = total->feuilles + resultat->feuilles;
+        if (resultat->hauteur > total->hauteur) {
+            total->hauteur = resultat->hauteur;
+        }
+        total->trouve = total->trouve || resultat->trouve;
+        pthread_mutex_destroy(&travailleurs[i].file.verrou);
+        free(travailleurs[i].file.taches);
+    }
+    free(travailleurs);
+    return atomic_load(&travail->memoire);
+}
+
+#endif
+
+/**
+ *  \brief Calcule une requête sur tout l'arbre à l'aide de plusieurs fils
+ *         d'exécution.
+ *
+ *  \param arbre        : L'arbre à parcourir.
+ *  \param requete      : La requête à calculer.
+ *  \param valeur       : La valeur cherchée par REQUETE_CONTIENT.
+ *  \param travailleurs : Le nombre de fils (0: un par processeur).
+ *
+ *  \return Le résultat de la requête.
+ */
+static struct resultat_parallele calculer_en_parallele(arbre_binaire* arbre,
+                                        enum requete_parallele requete,
+                                        int valeur, int travailleurs)
+{
+    struct resultat_parallele resultat = {0, 0, 0, false};
+    struct arbre_binaire_pile pile;
+    bool memoire;
+    int jeton;
+#ifndef _WIN32
+    struct travail_parallele travail;
+#endif
+
+    jeton = entrer_lecture_arbre_binaire(arbre);
+    initialiser_pile(&pile);
+    memoire = empiler_pile(&pile, arbre, 1, 0);
+    if (memoire) {
+        memoire = explorer(NULL, requete, valeur, &pile,
+                           PARALLELE_SEQUENTIEL, &resultat);
+    }
+#ifndef _WIN32
+    if (travailleurs <= 0) {
+        travailleurs = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (travailleurs > PARALLELE_TRAVAILLEURS_MAXIMUM) {
+        travailleurs = PARALLELE_TRAVAILLEURS_MAXIMUM;
+    }
+    if (memoire && pile.nombre > 0 && travailleurs > 1) {
+        memset(&travail, 0, sizeof(travail));
+        travail.requete = requete;
+        travail.valeur = valeur;
+        travail.nombre_travailleurs = travailleurs;
+        memoire = parcourir_en_parallele(&travail, &pile, &resultat);
+    }
+#endif
+    if (memoire && pile.nombre > 0) {
+        memoire = explorer(NULL, requete, valeur, &pile, 0, &resultat);
+    }
+    vider_pile(&pile);
+    sortir_lecture_arbre_binaire(arbre, jeton);
+    if (memoire == false) {
+        inscrire_erreur_arbre_binaire(arbre, "Il n'y a plus de memoire pour \
+parcourir l'arbre.");
+    }
+    return resultat;
+}
+
+/**
+ *  \brief Indique le nombre d'éléments de l'arbre en le parcourant avec
+ *         plusieurs fils d'exécution.
+ *
+ *  \param arbre        : L'arbre à trouver son nombre d'éléments.
+ *  \param travailleurs : Le nombre de fils (0: un par processeur).
+ *
+ *  \return Le nombre d'éléments.
+ */
+int nombre_elements_parallele_arbre_binaire(arbre_binaire* arbre,
+                                            int travailleurs)
+{
+    int nombre = 0;
+
+    retirer_erreur_arbre_binaire(arbre);
+    if (arbre && arbre->contexte->options & ARBRE_BINAIRE_OPTION_AUGMENTE) {
+        nombre = NOEUD_ETENDU(arbre)->taille;
+    } else if (arbre) {
+        nombre = calculer_en_parallele(arbre, REQUETE_ELEMENTS, 0,
+                                       travailleurs).elements;
+    }
+    return nombre;
+}
+
+/**
+ *  \brief Indique le nombre de feuilles de l'arbre en le parcourant avec
+ *         plusieurs fils d'exécution.
+ *
+ *  \param arbre        : L'arbre à trouver son nombre de feuilles.
+ *  \param travailleurs : Le nombre de fils (0: un par processeur).
+ *
+ *  \return Le nombre de feuilles.
+ */
+int nombre_feuilles_parallele_arbre_binaire(arbre_binaire* arbre,
+                                            int travailleurs)
+{
+    int feuilles = 0;
+
+    retirer_erreur_arbre_binaire(arbre);
+    if (arbre && arbre->contexte->options & ARBRE_BINAIRE_OPTION_AUGMENTE) {
+        feuilles = NOEUD_ETENDU(arbre)->feuilles;
+    } else if (arbre) {
+        feuilles = calculer_en_parallele(arbre, REQUETE_FEUILLES, 0,
+                                         travailleurs).feuilles;
+    }
+    return feuilles;
+}
+
+/**
+ *  \brief Indique la hauteur de l'arbre en le parcourant avec plusieurs
+ *         fils d'exécution.
+ *
+ *  \param arbre        : L'arbre à trouver sa hauteur.
+ *  \param travailleurs : Le nombre de fils (0: un par processeur).
+ *
+ *  \return La hauteur de l'arbre.
+ */
+int hauteur_parallele_arbre_binaire(arbre_binaire* arbre, int travailleurs)
+{
+    int hauteur = 0;
+
+    retirer_erreur_arbre_binaire(arbre);
+    if (arbre && arbre->contexte->options & ARBRE_BINAIRE_OPTION_AUGMENTE) {
+        hauteur = NOEUD_ETENDU(arbre)->hauteur;
+    } else if (arbre) {
+        hauteur = calculer_en_parallele(arbre, REQUETE_HAUTEUR, 0,
+                                        travailleurs).hauteur;
+    }
+    return hauteur;
+}
+
+/**
+ *  \brief Vérifie si un élément est dans l'arbre en le parcourant avec
+ *         plusieurs fils d'exécution. Les autres fils s'arrêtent dès qu'un
+ *         fil trouve l'élément.
+ *
+ *  \param arbre        : L'arbre dans lequel chercher.
+ *  \param valeur       : L'élément à chercher.
+ *  \param travailleurs : Le nombre de fils (0: un par processeur).
+ *
+ *  \return Vrai si l'élément est présent.
+ */
+bool contient_element_parallele_arbre_binaire(arbre_binaire* arbre,
+                                              int valeur, int travailleurs)
+{
+    bool presence = false;
+
+    retirer_erreur_arbre_binaire(arbre);
+    if (arbre && arbre->contexte->options & ARBRE_BINAIRE_OPTION_ORDONNE) {
+        presence = chercher_element_arbre_binaire(arbre, valeur) != NULL;
+    } else if (arbre) {
+        presence = calculer_en_parallele(arbre, REQUETE_CONTIENT, valeur,
+                                         travailleurs).trouve;
+    }
+    return presence;
+}
@@ -0,0 +1,508 @@
+/*
+
+    Copyright (c) 2015 Nicolas Bisson
+
+    L'autorisation est accordée, gracieusement, à toute personne acquérant une
+    copie de cette bibliothèque et des fichiers de documentation associés
+    (la "Bibliothèque"), de commercialiser la Bibliothèque sans restriction,
+    notamment les droits d'utiliser, de copier, de modifier, de fusionner, de
+    publier, de distribuer, de sous-licencier et / ou de vendre des copies de
+    la Bibliothèque, ainsi que d'autoriser les personnes auxquelles la
+    Bibliothèque est fournie à le faire, sous réserve des conditions suivantes:
+
+    La déclaration de copyright ci-dessus et la présente autorisation doivent
+    être incluses dans toutes copies ou parties substantielles de la
+    Bibliothèque.
+
+    LA BIBLIOTHÈQUE EST FOURNIE "TELLE QUELLE", SANS GARANTIE D'AUCUNE SORTE,
+    EXPLICITE OU IMPLICITE, NOTAMMENT SANS GARANTIE DE QUALITÉ MARCHANDE,
+    D’ADÉQUATION À UN USAGE PARTICULIER ET D'ABSENCE DE CONTREFAÇON. EN AUCUN
+    CAS, LES AUTEURS OU TITULAIRES DU DROIT D'AUTEUR NE SERONT RESPONSABLES DE
+    TOUT DOMMAGE, RÉCLAMATION OU AUTRE RESPONSABILITÉ, QUE CE SOIT DANS LE
+    CADRE D'UN CONTRAT, D'UN DÉLIT OU AUTRE, EN PROVENANCE DE, CONSÉCUTIF À OU
+    EN RELATION AVEC LA BIBLIOTHÈQUE OU SON UTILISATION, OU AVEC D'AUTRES
+    ÉLÉMENTS DE LA BIBLIOTHÈQUE.
+
+*/
+
+/**
+ *  \file arbre_binaire_parcours.c
+ *
+ *  Parcours non récursifs d'un arbre binaire. Les noeuds en attente sont
+ *  conservés dans une pile (ou une file pour le parcours en largeur)
+ *  explicite, ce qui permet de parcourir des arbres très profonds.
+ *
+ *  Les parcours de Morris n'ont même pas de pile: avant de descendre dans
+ *  le premier sous-arbre d'un noeud, le second lien (vide) du dernier noeud
+ *  de ce sous-arbre est relié au noeud, ce qui permet d'y remonter. Le lien
+ *  est retiré au retour, et un parcours interrompu retire ceux qui restent.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "arbre_binaire.h"
+#include "arbre_binaire_interne.h"
+
+/**
+ *  \brief Agrandit la pile (la capacité est doublée).
+ *
+ *  \param pile : La pile pleine.
+ *
+ *  \return Faux s'il n'y a plus de mémoire.
+ */
+bool agrandir_pile(struct arbre_binaire_pile* pile)
+{
+    struct arbre_binaire_element_pile* elements;
+    bool reussi = false;
+
+    if (pile->elements == pile->locale) {
+        elements = malloc(2 * pile->capacite * sizeof(*elements));
+        if (elements) {
+            memcpy(elements, pile->locale, pile->nombre * sizeof(*elements));
+        }
+    } else {
+        elements = realloc(pile->elements,
+                           2 * pile->capacite * sizeof(*elements));
+    }
+    if (elements) {
+        pile->elements = elements;
+        pile->capacite = 2 * pile->capacite;
+        reussi = true;
+    }
+    return reussi;
+}
+
+/**
+ *  \brief Parcours préfixe. Les enfants sont lus avant la visite du noeud
+ *         pour que le visiteur puisse libérer le noeud qu'il reçoit.
+ */
+static bool parcourir_prefixe(struct arbre_binaire_pile* pile,
+                              arbre_binaire* arbre,
+                              arbre_binaire_visiteur visiteur, void* donnees,
+                              bool* memoire)
+{
+    struct arbre_binaire_element_pile element;
+    arbre_binaire* premier;
+    arbre_binaire* second;
+    bool continuer = true;
+
+    *memoire = empiler_pile(pile, arbre, 1, 0);
+    while (continuer && *memoire && depiler_pile(pile, &element)) {
+        premier = LIRE_FILS(element.noeud, premier_fils);
+        second = LIRE_FILS(element.noeud, second_fils);
+        if (second) {
+            *memoire = empiler_pile(pile, second, element.profondeur + 1, 0);
+        }
+        if (premier && *memoire) {
+            *memoire = empiler_pile(pile, premier, element.profondeur + 1, 0);
+        }
+        if (*memoire) {
+            STATISTIQUE_VISITE();
+            continuer = visiteur(element.noeud, element.profondeur, donnees);
+        }
+    }
+    return continuer;
+}
+
+/**
+ *  \brief Parcours infixe.
+ */
+static bool parcourir_infixe(struct arbre_binaire_pile* pile,
+                             arbre_binaire* arbre,
+                             arbre_binaire_visiteur visiteur, void* donnees,
+                             bool* memoire)
+{
+    struct arbre_binaire_element_pile element;
+    arbre_binaire* courant = arbre;
+    int profondeur = 1;
+    bool continuer = true;
+
+    *memoire = true;
+    while (continuer && *memoire && (courant || pile->nombre > 0)) {
+        if (courant) {
+            *memoire = empiler_pile(pile, courant, profondeur, 0);
+            courant = LIRE_FILS(courant, premier_fils);
+            profondeur = profondeur + 1;
+        } else {
+            depiler_pile(pile, &element);
+            STATISTIQUE_VISITE();
+            continuer = visiteur(element.noeud, element.profondeur, donnees);
+            courant = LIRE_FILS(element.noeud, second_fils);
+            profondeur = element.profondeur + 1;
+        }
+    }
+    return continuer;
+}
+
+/**
+ *  \brief Parcours postfixe. L'état de chaque élément indique quels
+ *         enfants ont déjà été parcourus.
+ */
+static bool parcourir_postfixe(struct arbre_binaire_pile* pile,
+                               arbre_binaire* arbre,
+                               arbre_binaire_visiteur visiteur, void* donnees,
+                               bool* memoire)
+{
+    struct arbre_binaire_element_pile* element;
+    arbre_binaire* noeud;
+    arbre_binaire* enfant;
+    int profondeur;
+    bool continuer = true;
+
+    *memoire = empiler_pile(pile, arbre, 1, 0);
+    while (continuer && *memoire && pile->nombre > 0) {
+        element = &pile->elements[pile->nombre - 1];
+        noeud = element->noeud;
+        profondeur = element->profondeur;
+        if (element->etat == 0) {
+            element->etat = 1;
+            enfant = LIRE_FILS(noeud, premier_fils);
+            if (enfant) {
+                *memoire = empiler_pile(pile, enfant, profondeur + 1, 0);
+            }
+        } else if (element->etat == 1) {
+            element->etat = 2;
+            enfant = LIRE_FILS(noeud, second_fils);
+            if (enfant) {
+                *memoire = empiler_pile(pile, enfant, profondeur + 1, 0);
+            }
+        } else {
+            pile->nombre = pile->nombre - 1;
+            STATISTIQUE_VISITE();
+            continuer = visiteur(noeud, profondeur, donnees);
+        }
+    }
+    return continuer;
+}
+
+/**
+ *  \brief Parcours en largeur. La pile sert de file circulaire: "debut"
+ *         est l'indice du prochain noeud à visiter.
+ */
+static bool parcourir_largeur(struct arbre_binaire_pile* pile,
+                              arbre_binaire* arbre,
+                              arbre_binaire_visiteur visiteur, void* donnees,
+                              bool* memoire)
+{
+    struct arbre_binaire_element_pile element;
+    arbre_binaire* enfants[2];
+    size_t debut = 0;
+    size_t i;
+    bool continuer = true;
+
+    *memoire = empiler_pile(pile, arbre, 1, 0);
+    while (continuer && *memoire && debut < pile->nombre) {
+        element = pile->elements[debut];
+        debut = debut + 1;
+        enfants[0] = LIRE_FILS(element.noeud, premier_fils);
+        enfants[1] = LIRE_FILS(element.noeud, second_fils);
+        for (i = 0; i < 2 && *memoire; i++) {
+            if (enfants[i]) {
+                if (pile->nombre == pile->capacite && debut > 0) {
+                    memmove(pile->elements, pile->elements + debut,
+                            (pile->nombre - debut) * sizeof(element));
+                    pile->nombre = pile->nombre - debut;
+                    debut = 0;
+                }
+                *memoire = empiler_pile(pile, enfants[i],
+                                        element.profondeur + 1, 0);
+            }
+        }
+        if (*memoire) {
+            STATISTIQUE_VISITE();
+            continuer = visiteur(element.noeud, element.profondeur, donnees);
+        }
+    }
+    return continuer;
+}
+
+/**
+ *  \brief Indique si le second lien d'un noeud est un lien temporaire d'un
+ *         parcours de Morris, c'est-à-dire si le noeud est le dernier du
+ *         premier sous-arbre de la cible de ce lien.
+ *
+ *  \param noeud : Le noeud.
+ *  \param cible : Le noeud désigné par son second lien.
+ *
+ *  \return Vrai si le lien est temporaire.
+ */
+static bool est_lien_morris(arbre_binaire* noeud, arbre_binaire* cible)
+{
+    arbre_binaire* dernier = cible->premier_fils;
+
+    while (dernier && dernier != noeud && dernier->second_fils &&
+           dernier->second_fils != cible) {
+        dernier = dernier->second_fils;
+    }
+    return dernier == noeud;
+}
+
+/**
+ *  \brief Commence un parcours de Morris.
+ *
+ *  \param morris : L'état du parcours.
+ *  \param arbre  : L'arbre à parcourir.
+ *  \param infixe : Vrai pour l'ordre infixe, Faux pour l'ordre préfixe.
+ */
+void commencer_morris_arbre_binaire(struct arbre_binaire_morris* morris,
+                                    arbre_binaire* arbre, bool infixe)
+{
+    morris->courant = arbre;
+    morris->visite = NULL;
+    morris->lien = NULL;
+    morris->predecesseur = NULL;
+    morris->profondeur = 1;
+    morris->infixe = infixe;
+}
+
+/**
+ *  \brief Passe au noeud suivant d'un parcours de Morris. Les enfants du
+ *         noeud rendu sont ses vrais enfants jusqu'à l'appel suivant; les
+ *         autres noeuds peuvent être reliés temporairement.
+ *
+ *  \param morris     : L'état du parcours.
+ *  \param profondeur : Reçoit la profondeur du noeud rendu.
+ *
+ *  \return Le noeud suivant, ou NULL à la fin du parcours.
+ */
+arbre_binaire* suivant_morris_arbre_binaire(struct arbre_binaire_morris* morris,
+                                           int* profondeur)
+{
+    arbre_binaire* resultat = NULL;
+    arbre_binaire* noeud;
+    arbre_binaire* dernier;
+    int distance;
+
+    if (morris->lien) {
+        morris->visite->second_fils = morris->lien;
+        morris->lien = NULL;
+    }
+    if (morris->predecesseur) {
+        morris->predecesseur->second_fils = morris->courant;
+        morris->predecesseur = NULL;
+        morris->courant = morris->courant->premier_fils;
+        morris->profondeur = morris->profondeur + 1;
+    }
+    while (resultat == NULL && morris->courant) {
+        noeud = morris->courant;
+        dernier = noeud->premier_fils;
+        distance = 0;
+        while (dernier && dernier->second_fils &&
+               dernier->second_fils != noeud) {
+            dernier = dernier->second_fils;
+            distance = distance + 1;
+        }
+        if (dernier == NULL) {
+            resultat = noeud;
+            *profondeur = morris->profondeur;
+            morris->courant = noeud->second_fils;
+            morris->profondeur = morris->profondeur + 1;
+        } else if (dernier->second_fils == NULL) {
+            /* Première arrivée: le lien est posé avant de descendre. En
+               ordre préfixe, il ne l'est qu'après la visite, pour qu'un
+               parcours interrompu n'ait pas à le retirer. */
+            if (morris->infixe) {
+                dernier->second_fils = noeud;
+                morris->courant = noeud->premier_fils;
+                morris->profondeur = morris->profondeur + 1;
+            } else {
+                resultat = noeud;
+                *profondeur = morris->profondeur;
+                morris->predecesseur = dernier;
+            }
+        } else {
+            /* Retour par le lien: la profondeur du noeud est celle du
+               dernier noeud de son premier sous-arbre, moins sa distance. */
+            dernier->second_fils = NULL;
+            morris->profondeur = morris->profondeur - 2 - distance;
+            if (morris->infixe) {
+                resultat = noeud;
+                *profondeur = morris->profondeur;
+            }
+            morris->courant = noeud->second_fils;
+            morris->profondeur = morris->profondeur + 1;
+        }
+    }
+    if (resultat) {
+        morris->visite = resultat;
+        if (resultat->second_fils &&
+            est_lien_morris(resultat, resultat->second_fils)) {
+            morris->lien = resultat->second_fils;
+            resultat->second_fils = NULL;
+        }
+    }
+    return resultat;
+}
+
+/**
+ *  \brief Termine un parcours de Morris, même inachevé: les liens
+ *         temporaires qui restent sont retirés. Ils se trouvent tous sur
+ *         le chemin qui suit les seconds liens à partir du dernier noeud
+ *         rendu.
+ *
+ *  \param morris : L'état du parcours.
+ */
+void terminer_morris_arbre_binaire(struct arbre_binaire_morris* morris)
+{
+    arbre_binaire* noeud = morris->visite;
+    arbre_binaire* suivant;
+
+    if (morris->lien) {
+        morris->visite->second_fils = morris->lien;
+        morris->lien = NULL;
+    }
+    while (morris->courant && noeud) {
+        suivant = noeud->second_fils;
+        if (suivant && est_lien_morris(noeud, suivant)) {
+            noeud->second_fils = NULL;
+        }
+        noeud = suivant;
+    }
+    morris->courant = NULL;
+    morris->predecesseur = NULL;
+}
+
+/**
+ *  \brief Parcours de Morris (préfixe ou infixe), sans pile.
+ */
+static bool parcourir_morris(arbre_binaire* arbre, bool infixe,
+                             arbre_binaire_visiteur visiteur, void* donnees)
+{
+    struct arbre_binaire_morris morris;
+    arbre_binaire* noeud;
+    int profondeur;
+    bool continuer = true;
+
+    commencer_morris_arbre_binaire(&morris, arbre, infixe);
+    while (continuer &&
+           (noeud = suivant_morris_arbre_binaire(&morris, &profondeur))) {
+        STATISTIQUE_VISITE();
+        continuer = visiteur(noeud, profondeur, donnees);
+    }
+    terminer_morris_arbre_binaire(&morris);
+    return continuer;
+}
+
+/**
+ *  \brief Visite tous les noeuds de l'arbre binaire dans l'ordre demandé.
+ *         Le parcours utilise une pile (ou une file) explicite et ne
+ *         dépend donc pas de la taille de la pile d'exécution.
+ *
+ *  \param arbre    : L'arbre binaire à parcourir.
+ *  \param ordre    : L'ordre du parcours.
+ *  \param visiteur : La fonction appelée pour chaque noeud.
+ *  \param donnees  : Données passées telles quelles au visiteur.
+ *
+ *  \return Vrai si tous les noeuds ont été visités, Faux si le visiteur a
+ *          arrêté le parcours ou s'il n'y a plus de mémoire (dans ce cas
+ *          une erreur est inscrite dans l'arbre).
+ */
+bool parcourir_arbre_binaire(arbre_binaire* arbre, arbre_binaire_ordre ordre,
+                             arbre_binaire_visiteur visiteur, void* donnees)
+{
+    struct arbre_binaire_pile pile;
+    arbre_binaire_contexte* contexte;
+    struct arbre_binaire_erreur* erreur;
+    bool continuer = true;
+    bool memoire = true;
+    int jeton;
+
+    if (arbre) {
+        STATISTIQUE_DEBUT(ARBRE_BINAIRE_FONCTION_PARCOURIR);
+        contexte = arbre->contexte;
+        jeton = entrer_lecture_contexte_arbre_binaire(contexte);
+        initialiser_pile(&pile);
+        if (contexte->options & ARBRE_BINAIRE_OPTION_CONCURRENT) {
+            /* Les liens temporaires seraient vus par les autres fils. */
+            if (ordre == ARBRE_BINAIRE_PREFIXE_MORRIS) {
+                ordre = ARBRE_BINAIRE_PREFIXE;
+            } else if (ordre == ARBRE_BINAIRE_INFIXE_MORRIS) {
+                ordre = ARBRE_BINAIRE_INFIXE;
+            }
+        }
+        if (ordre == ARBRE_BINAIRE_PREFIXE_MORRIS ||
+            ordre == ARBRE_BINAIRE_INFIXE_MORRIS) {
+            continuer = parcourir_morris(arbre,
+                                         ordre == ARBRE_BINAIRE_INFIXE_MORRIS,
+                                         visiteur, donnees);
+        } else if (ordre == ARBRE_BINAIRE_PREFIXE) {
+            continuer = parcourir_prefixe(&pile, arbre, visiteur, donnees,
+                                          &memoire);
+        } else if (ordre == ARBRE_BINAIRE_INFIXE) {
+            continuer = parcourir_infixe(&pile, arbre, visiteur, donnees,
+                                         &memoire);
+        } else if (ordre == ARBRE_BINAIRE_POSTFIXE) {
+            continuer = parcourir_postfixe(&pile, arbre, visiteur, donnees,
+                                           &memoire);
+        } else {
+            continuer = parcourir_largeur(&pile, arbre, visiteur, donnees,
+                                          &memoire);
+        }
+        vider_pile(&pile);
+        sortir_lecture_contexte_arbre_binaire(contexte, jeton);
+        if (memoire == false) {
+            erreur = erreur_contexte_arbre_binaire(contexte);
+            erreur->a_erreur = true;
+            strncpy(erreur->texte, "Il n'y a plus de memoire pour \
+parcourir l'arbre.", ERREUR_TAILLE - 1);
+        }
+        STATISTIQUE_FIN();
+    }
+    return continuer && memoire;
+}
+
+/**
+ *  \brief Ordre des parcours qui lisent l'arbre sans le modifier (nombres
+ *         d'éléments, recherches): ARBRE_BINAIRE_PREFIXE_MORRIS si l'arbre
+ *         a été créé avec ARBRE_BINAIRE_OPTION_MORRIS, sinon
+ *         ARBRE_BINAIRE_PREFIXE.
+ *
+ *  \param arbre : L'arbre à parcourir (peut être NULL).
+ *
+ *  \return L'ordre à utiliser.
+ */
+arbre_binaire_ordre ordre_lecture_arbre_binaire(arbre_binaire* arbre)
+{
+    arbre_binaire_ordre ordre = ARBRE_BINAIRE_PREFIXE;
+
+    if (arbre && arbre->contexte->options & ARBRE_BINAIRE_OPTION_MORRIS) {
+        ordre = ARBRE_BINAIRE_PREFIXE_MORRIS;
+    }
+    return ordre;
+}
+
+/**
+ *  \brief Visiteur (postfixe) qui relie les enfants d'un noeud à leur
+ *         parent et recalcule un noeud étendu à partir de ses enfants,
+ *         déjà recalculés.
+ */
+static bool recalculer_noeud(arbre_binaire* noeud, int profondeur,
+                             void* donnees)
+{
+    if (noeud->premier_fils) {
+        NOEUD_PARENT(noeud->premier_fils)->parent = noeud;
+    }
+    if (noeud->second_fils) {
+        NOEUD_PARENT(noeud->second_fils)->parent = noeud;
+    }
+    if (noeud->contexte->options & ARBRE_BINAIRE_OPTION_AUGMENTE) {
+        calculer_noeud_etendu_arbre_binaire(noeud);
+    }
+    return true;
+}
+
+/**
+ *  \brief Recalcule les liens vers les parents et les informations de tous
+ *         les noeuds étendus d'un sous-arbre (par exemple après un
+ *         chargement).
+ *
+ *  \param arbre : Le sous-arbre à recalculer.
+ *
+ *  \return Faux s'il n'y a plus de mémoire pour effectuer le parcours.
+ */
+bool recalculer_sous_arbre_binaire(arbre_binaire* arbre)
+{
+    return parcourir_arbre_binaire(arbre, ARBRE_BINAIRE_POSTFIXE,
+                                   recalculer_noeud, NULL);
+}
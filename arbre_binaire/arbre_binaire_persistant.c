@@ -0,0 +1,281 @@
+/*
+
+    Copyright (c) 2015 Nicolas Bisson
+
+    L'autorisation est accordée, gracieusement, à toute personne acquérant une
+    copie de cette bibliothèque et des fichiers de documentation associés
+    (la "Bibliothèque"), de commercialiser la Bibliothèque sans restriction,
+    notamment les droits d'utiliser, de copier, de modifier, de fusionner, de
+    publier, de distribuer, de sous-licencier et / ou de vendre des copies de
+    la Bibliothèque, ainsi que d'autoriser les personnes auxquelles la
+    Bibliothèque est fournie à le faire, sous réserve des conditions suivantes:
+
+    La déclaration de copyright ci-dessus et la présente autorisation doivent
+    être incluses dans toutes copies ou parties substantielles de la
+    Bibliothèque.
+
+    LA BIBLIOTHÈQUE EST FOURNIE "TELLE QUELLE", SANS GARANTIE D'AUCUNE SORTE,
+    EXPLICITE OU IMPLICITE, NOTAMMENT SANS GARANTIE DE QUALITÉ MARCHANDE,
+    D’ADÉQUATION À UN USAGE PARTICULIER ET D'ABSENCE DE CONTREFAÇON. EN AUCUN
+    CAS, LES AUTEURS OU TITULAIRES DU DROIT D'AUTEUR NE SERONT RESPONSABLES DE
+    TOUT DOMMAGE, RÉCLAMATION OU AUTRE RESPONSABILITÉ, QUE CE SOIT DANS LE
+    CADRE D'UN CONTRAT, D'UN DÉLIT OU AUTRE, EN PROVENANCE DE, CONSÉCUTIF À OU
+    EN RELATION AVEC LA BIBLIOTHÈQUE OU SON UTILISATION, OU AVEC D'AUTRES
+    ÉLÉMENTS DE LA BIBLIOTHÈQUE.
+
+*/
+
+/**
+ *  \file arbre_binaire_persistant.c
+ *
+ *  Mode persistant (ARBRE_BINAIRE_OPTION_PERSISTANT). Chaque noeud compte
+ *  les pointeurs qui mènent à lui, ce qui permet à plusieurs versions de
+ *  l'arbre de partager leurs sous-arbres. Un instantané ne copie que la
+ *  racine. Avant une modification, les noeuds partagés du chemin qui mène
+ *  de la racine au noeud modifié sont copiés: la version courante reçoit
+ *  les copies et les instantanés gardent les originaux.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "arbre_binaire.h"
+#include "arbre_binaire_interne.h"
+
+/**
+ *  \brief Erreur inscrite lorsqu'un noeud d'un instantané est modifié.
+ */
+#define MESSAGE_INSTANTANE "Le noeud n'appartient pas a la version courante \
+de l'arbre."
+
+/**
+ *  \brief Ajoute une référence vers les enfants d'un noeud.
+ *
+ *  \param noeud : Le noeud dont les enfants sont référencés.
+ */
+static void referencer_enfants(arbre_binaire* noeud)
+{
+    if (noeud->premier_fils) {
+        NOEUD_PERSISTANT(noeud->premier_fils)->references =
+                NOEUD_PERSISTANT(noeud->premier_fils)->references + 1;
+    }
+    if (noeud->second_fils) {
+        NOEUD_PERSISTANT(noeud->second_fils)->references =
+                NOEUD_PERSISTANT(noeud->second_fils)->references + 1;
+    }
+}
+
+/**
+ *  \brief Copie un noeud; la copie partage les enfants de l'original.
+ *
+ *  \param noeud : Le noeud à copier.
+ *
+ *  \return La copie (sans parent), ou NULL s'il n'y a plus de mémoire.
+ */
+static arbre_binaire* copier_noeud(arbre_binaire* noeud)
+{
+    arbre_binaire* copie;
+
+    copie = allouer_noeud_arbre_binaire(noeud->contexte, noeud->valeur);
+    if (copie) {
+        memcpy(copie, noeud, sizeof(struct arbre_binaire_noeud_persistant));
+        NOEUD_ETENDU(copie)->parent = NULL;
+        NOEUD_PERSISTANT(copie)->references = 1;
+        referencer_enfants(copie);
+    }
+    return copie;
+}
+
+/**
+ *  \brief Prend un instantané d'un arbre créé avec
+ *         ARBRE_BINAIRE_OPTION_PERSISTANT, en temps constant.
+ *
+ *  \param arbre : L'arbre (ou le sous-arbre) à copier.
+ *
+ *  \return L'instantané, ou NULL en cas d'erreur.
+ */
+arbre_binaire* instantane_arbre_binaire(arbre_binaire* arbre)
+{
+    arbre_binaire* instantane = NULL;
+
+    retirer_erreur_arbre_binaire(arbre);
+    if (arbre && !(arbre->contexte->options &
+                   ARBRE_BINAIRE_OPTION_PERSISTANT)) {
+        inscrire_erreur_arbre_binaire(arbre, "L'arbre n'est pas persistant.");
+    } else if (arbre) {
+        instantane = copier_noeud(arbre);
+        if (instantane) {
+            arbre->contexte->versions = arbre->contexte->versions + 1;
+        } else {
+            inscrire_erreur_arbre_binaire(arbre, "Il n'y a plus de memoire.");
+        }
+    }
+    return instantane;
+}
+
+/**
+ *  \brief Remonte les parents d'un noeud pour vérifier qu'il appartient à
+ *         la version courante.
+ *
+ *  \param arbre   : Le noeud.
+ *  \param partage : Mis à Vrai si un noeud du chemin est partagé.
+ *
+ *  \return Vrai si le chemin mène à la racine de la version courante.
+ */
+static bool verifier_chemin(arbre_binaire* arbre, bool* partage)
+{
+    arbre_binaire* parent = NOEUD_ETENDU(arbre)->parent;
+
+    *partage = false;
+    while (parent && (parent->premier_fils == arbre ||
+                      parent->second_fils == arbre)) {
+        if (NOEUD_PERSISTANT(arbre)->references > 1) {
+            *partage = true;
+        }
+        arbre = parent;
+        parent = NOEUD_ETENDU(arbre)->parent;
+    }
+    return parent == NULL && arbre == arbre->contexte->racine;
+}
+
+/**
+ *  \brief Indique si un noeud d'un arbre persistant appartient à la
+ *         version courante (et non seulement à un instantané).
+ *
+ *  \param arbre : Le noeud.
+ *
+ *  \return Vrai si ses parents mènent à la racine de la version courante.
+ */
+bool version_courante_arbre_binaire(arbre_binaire* arbre)
+{
+    bool partage;
+
+    return verifier_chemin(arbre, &partage);
+}
+
+/**
+ *  \brief Prépare la modification d'un noeud d'un arbre persistant: les
+ *         noeuds partagés avec un instantané, de la racine jusqu'au noeud,
+ *         sont remplacés par des copies.
+ *
+ *  \param arbre : Le noeud à modifier.
+ *
+ *  \return Le noeud à modifier dans la version courante, ou NULL (avec une
+ *          erreur) s'il n'appartient pas à la version courante ou s'il n'y
+ *          a plus de mémoire.
+ */
+arbre_binaire* preparer_ecriture_arbre_binaire(arbre_binaire* arbre)
+{
+    struct arbre_binaire_pile pile;
+    struct arbre_binaire_element_pile element;
+    arbre_binaire* noeud;
+    arbre_binaire* parent = NULL;
+    arbre_binaire* copie;
+    bool partage;
+    bool memoire = true;
+
+    if (!(arbre->contexte->options & ARBRE_BINAIRE_OPTION_PERSISTANT)) {
+        return arbre;
+    }
+    if (!verifier_chemin(arbre, &partage)) {
+        inscrire_erreur_arbre_binaire(arbre, MESSAGE_INSTANTANE);
+        return NULL;
+    }
+    if (partage == false) {
+        return arbre;
+    }
+    initialiser_pile(&pile);
+    for (noeud = arbre; noeud && memoire;
+         noeud = NOEUD_ETENDU(noeud)->parent) {
+        memoire = empiler_pile(&pile, noeud, 0, 0);
+    }
+    while (memoire && depiler_pile(&pile, &element)) {
+        noeud = element.noeud;
+        if (NOEUD_PERSISTANT(noeud)->references > 1) {
+            copie = copier_noeud(noeud);
+            memoire = copie != NULL;
+            if (memoire) {
+                NOEUD_PERSISTANT(noeud)->references =
+                        NOEUD_PERSISTANT(noeud)->references - 1;
+                NOEUD_ETENDU(copie)->parent = parent;
+                if (parent->premier_fils == noeud) {
+                    parent->premier_fils = copie;
+                } else {
+                    parent->second_fils = copie;
+                }
+                if (copie->premier_fils) {
+                    NOEUD_ETENDU(copie->premier_fils)->parent = copie;
+                }
+                if (copie->second_fils) {
+                    NOEUD_ETENDU(copie->second_fils)->parent = copie;
+                }
+                noeud = copie;
+            }
+        }
+        parent = noeud;
+    }
+    vider_pile(&pile);
+    if (memoire == false) {
+        inscrire_erreur_arbre_binaire(arbre, "Il n'y a plus de memoire.");
+        parent = NULL;
+    }
+    return parent;
+}
+
+/**
+ *  \brief Libère une référence vers un noeud persistant. Les noeuds qui
+ *         ne sont plus référencés sont libérés. Si le noeud est la racine
+ *         d'une version, le contexte est libéré avec la dernière version.
+ *
+ *  \param arbre : Le noeud à libérer.
+ */
+void detruire_persistant_arbre_binaire(arbre_binaire* arbre)
+{
+    arbre_binaire_contexte* contexte = arbre->contexte;
+    arbre_binaire* liberes = NULL;
+    arbre_binaire* noeud;
+    arbre_binaire* enfants[2];
+    bool version = NOEUD_ETENDU(arbre)->parent == NULL;
+    bool racine = contexte->racine == arbre;
+    int i;
+
+    NOEUD_PERSISTANT(arbre)->references =
+            NOEUD_PERSISTANT(arbre)->references - 1;
+    if (NOEUD_PERSISTANT(arbre)->references == 0) {
+        NOEUD_ETENDU(arbre)->parent = NULL;
+        liberes = arbre;
+    }
+    /* Les noeuds à libérer sont chaînés par leur champ "parent", qui ne
+       sert plus: la libération n'a besoin d'aucune mémoire. */
+    while (liberes) {
+        noeud = liberes;
+        liberes = NOEUD_ETENDU(noeud)->parent;
+        enfants[0] = noeud->premier_fils;
+        enfants[1] = noeud->second_fils;
+        for (i = 0; i < 2; i = i + 1) {
+            if (enfants[i]) {
+                NOEUD_PERSISTANT(enfants[i])->references =
+                        NOEUD_PERSISTANT(enfants[i])->references - 1;
+                if (NOEUD_PERSISTANT(enfants[i])->references == 0) {
+                    NOEUD_ETENDU(enfants[i])->parent = liberes;
+                    liberes = enfants[i];
+                }
+            }
+        }
+        liberer_noeud_arbre_binaire(noeud);
+    }
+    if (version) {
+        if (racine) {
+            contexte->racine = NULL;
+        }
+        contexte->versions = contexte->versions - 1;
+        if (contexte->versions == 0) {
+            if (contexte->options & ARBRE_BINAIRE_OPTION_ARENE) {
+                STATISTIQUE_AJOUTER(noeuds_liberes,
+                                    compter_noeuds_arene(&contexte->arene));
+                vider_arene(&contexte->arene);
+            }
+            free(contexte);
+        }
+    }
+}
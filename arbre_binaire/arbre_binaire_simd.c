@@ -0,0 +1,225 @@
+/*
+
+    Copyright (c) 2015 Nicolas Bisson
+
+    L'autorisation est accordée, gracieusement, à toute personne acquérant une
+    copie de cette bibliothèque et des fichiers de documentation associés
+    (la "Bibliothèque"), de commercialiser la Bibliothèque sans restriction,
+    notamment les droits d'utiliser, de copier, de modifier, de fusionner, de
+    publier, de distribuer, de sous-licencier et / ou de vendre des copies de
+    la Bibliothèque, ainsi que d'autoriser les personnes auxquelles la
+    Bibliothèque est fournie à le faire, sous réserve des conditions suivantes:
+
+    La déclaration de copyright ci-dessus et la présente autorisation doivent
+    être incluses dans toutes copies ou parties substantielles de la
+    Bibliothèque.
+
+    LA BIBLIOTHÈQUE EST FOURNIE "TELLE QUELLE", SANS GARANTIE D'AUCUNE SORTE,
+    EXPLICITE OU IMPLICITE, NOTAMMENT SANS GARANTIE DE QUALITÉ MARCHANDE,
+    D’ADÉQUATION À UN USAGE PARTICULIER ET D'ABSENCE DE CONTREFAÇON. EN AUCUN
+    CAS, LES AUTEURS OU TITULAIRES DU DROIT D'AUTEUR NE SERONT RESPONSABLES DE
+    TOUT DOMMAGE, RÉCLAMATION OU AUTRE RESPONSABILITÉ, QUE CE SOIT DANS LE
+    CADRE D'UN CONTRAT, D'UN DÉLIT OU AUTRE, EN PROVENANCE DE, CONSÉCUTIF À OU
+    EN RELATION AVEC LA BIBLIOTHÈQUE OU SON UTILISATION, OU AVEC D'AUTRES
+    ÉLÉMENTS DE LA BIBLIOTHÈQUE.
+
+*/
+
+/**
+ *  \file arbre_binaire_simd.c
+ *
+ *  Recherche de valeurs dans un tableau contigu (par exemple les valeurs
+ *  d'un arbre figé). Sur x86, la version AVX2 (8 "int" par comparaison) ou
+ *  SSE4.1 (4 "int") est choisie à l'exécution selon le processeur; sinon
+ *  une boucle simple est utilisée.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "arbre_binaire.h"
+#include "arbre_binaire_interne.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ARBRE_BINAIRE_SIMD_X86
+#include <immintrin.h>
+#endif
+
+/**
+ *  \brief Nombre de valeurs d'un bloc du tableau lors d'une recherche de
+ *         plusieurs valeurs. Un bloc reste dans la cache pendant qu'il est
+ *         comparé à chacune des valeurs cherchées.
+ */
+#define RECHERCHE_BLOC 2048
+
+/**
+ *  \brief Fonction qui cherche une valeur dans un tableau.
+ */
+typedef bool (*noyau_recherche)(const int* valeurs, size_t nombre,
+                                int valeur);
+
+/**
+ *  \brief Recherche sans instructions vectorielles.
+ */
+static bool chercher_scalaire(const int* valeurs, size_t nombre, int valeur)
+{
+    size_t i;
+    bool trouve = false;
+
+    for (i = 0; i < nombre && trouve == false; i = i + 1) {
+        trouve = valeurs[i] == valeur;
+    }
+    return trouve;
+}
+
+#ifdef ARBRE_BINAIRE_SIMD_X86
+
+/**
+ *  \brief Recherche SSE4.1: 16 valeurs (4 registres) par itération.
+ */
+__attribute__((target("sse4.1")))
+static bool chercher_sse41(const int* valeurs, size_t nombre, int valeur)
+{
+    const __m128i* bloc;
+    __m128i cle = _mm_set1_epi32(valeur);
+    __m128i egal;
+    size_t i = 0;
+    bool trouve = false;
+
+    while (trouve == false && i + 16 <= nombre) {
+        bloc = (const __m128i*)(valeurs + i);
+        egal = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi32(_mm_loadu_si128(bloc), cle),
+                         _mm_cmpeq_epi32(_mm_loadu_si128(bloc + 1), cle)),
+            _mm_or_si128(_mm_cmpeq_epi32(_mm_loadu_si128(bloc + 2), cle),
+                         _mm_cmpeq_epi32(_mm_loadu_si128(bloc + 3), cle)));
+        trouve = !_mm_testz_si128(egal, egal);
+        i = i + 16;
+    }
+    if (trouve == false) {
+        trouve = chercher_scalaire(valeurs + i, nombre - i, valeur);
+    }
+    return trouve;
+}
+
+/**
+ *  \brief Recherche AVX2: 32 valeurs (4 registres) par itération.
+ */
+__attribute__((target("avx2")))
+static bool chercher_avx2(const int* valeurs, size_t nombre, int valeur)
+{
+    const __m256i* bloc;
+    __m256i cle = _mm256_set1_epi32(valeur);
+    __m256i egal;
+    size_t i = 0;
+    bool trouve = false;
+
+    while (trouve == false && i + 32 <= nombre) {
+        bloc = (const __m256i*)(valeurs + i);
+        egal = _mm256_or_si256(
+            _mm256_or_si256(
+                _mm256_cmpeq_epi32(_mm256_loadu_si256(bloc), cle),
+                _mm256_cmpeq_epi32(_mm256_loadu_si256(bloc + 1), cle)),
+            _mm256_or_si256(
+                _mm256_cmpeq_epi32(_mm256_loadu_si256(bloc + 2), cle),
+                _mm256_cmpeq_epi32(_mm256_loadu_si256(bloc + 3), cle)));
+        trouve = !_mm256_testz_si256(egal, egal);
+        i = i + 32;
+    }
+    if (trouve == false) {
+        trouve = chercher_sse41(valeurs + i, nombre - i, valeur);
+    }
+    return trouve;
+}
+
+#endif
+
+/**
+ *  \brief Recherche choisie pour le processeur courant (NULL tant qu'elle
+ *         n'a pas été choisie).
+ */
+static _Atomic(noyau_recherche) noyau_choisi;
+
+/**
+ *  \brief Donne la meilleure recherche pour le processeur courant. Elle est
+ *         choisie au premier appel, puis conservée: deux fils qui la
+ *         choisissent en même temps obtiennent la même.
+ *
+ *  \return La fonction de recherche.
+ */
+static noyau_recherche choisir_noyau(void)
+{
+    noyau_recherche noyau = atomic_load_explicit(&noyau_choisi,
+                                                 memory_order_relaxed);
+
+    if (noyau == NULL) {
+        noyau = chercher_scalaire;
+#ifdef ARBRE_BINAIRE_SIMD_X86
+        if (__builtin_cpu_supports("avx2")) {
+            noyau = chercher_avx2;
+        } else if (__builtin_cpu_supports("sse4.1")) {
+            noyau = chercher_sse41;
+        }
+#endif
+        atomic_store_explicit(&noyau_choisi, noyau, memory_order_relaxed);
+    }
+    return noyau;
+}
+
+/**
+ *  \brief Vérifie si une valeur est dans un tableau.
+ *
+ *  \param valeurs : Le tableau.
+ *  \param nombre  : Le nombre de valeurs du tableau.
+ *  \param valeur  : La valeur à chercher.
+ *
+ *  \return Vrai si la valeur est présente.
+ */
+bool chercher_valeur_tableau(const int* valeurs, size_t nombre, int valeur)
+{
+    return choisir_noyau()(valeurs, nombre, valeur);
+}
+
+/**
+ *  \brief Vérifie quelles valeurs sont dans un tableau. Le tableau est lu
+ *         une seule fois, par blocs; chaque bloc est comparé aux valeurs
+ *         qui n'ont pas encore été trouvées.
+ *
+ *  \param valeurs    : Le tableau.
+ *  \param nombre     : Le nombre de valeurs du tableau.
+ *  \param cherchees  : Les valeurs à chercher.
+ *  \param k          : Le nombre de valeurs à chercher.
+ *  \param resultats  : Le bit i (bit i % 8 de l'octet i / 8) est mis à 1
+ *                      si cherchees[i] est présente. Les bits déjà à 1 ne
+ *                      sont pas cherchés.
+ *
+ *  \return Le nombre de valeurs trouvées.
+ */
+size_t chercher_valeurs_tableau(const int* valeurs, size_t nombre,
+                                const int* cherchees, size_t k,
+                                unsigned char* resultats)
+{
+    noyau_recherche noyau = choisir_noyau();
+    size_t trouvees = 0;
+    size_t debut;
+    size_t taille;
+    size_t i;
+
+    for (i = 0; i < k; i = i + 1) {
+        trouvees = trouvees + (resultats[i / 8] >> (i % 8) & 1);
+    }
+    for (debut = 0; debut < nombre && trouvees < k;
+         debut = debut + RECHERCHE_BLOC) {
+        taille = nombre - debut < RECHERCHE_BLOC ? nombre - debut
+                                                 : RECHERCHE_BLOC;
+        for (i = 0; i < k; i = i + 1) {
+            if ((resultats[i / 8] >> (i % 8) & 1) == 0 &&
+                noyau(valeurs + debut, taille, cherchees[i])) {
+                resultats[i / 8] = resultats[i / 8] | 1 << (i % 8);
+                trouvees = trouvees + 1;
+            }
+        }
+    }
+    return trouvees;
+}
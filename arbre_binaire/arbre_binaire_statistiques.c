@@ -0,0 +1,196 @@
+/*
+
+    Copyright (c) 2015 Nicolas Bisson
+
+    L'autorisation est accordée, gracieusement, à toute personne acquérant une
+    copie de cette bibliothèque et des fichiers de documentation associés
+    (la "Bibliothèque"), de commercialiser la Bibliothèque sans restriction,
+    notamment les droits d'utiliser, de copier, de modifier, de fusionner, de
+    publier, de distribuer, de sous-licencier et / ou de vendre des copies de
+    la Bibliothèque, ainsi que d'autoriser les personnes auxquelles la
+    Bibliothèque est fournie à le faire, sous réserve des conditions suivantes:
+
+    La déclaration de copyright ci-dessus et la présente autorisation doivent
+    être incluses dans toutes copies ou parties substantielles de la
+    Bibliothèque.
+
+    LA BIBLIOTHÈQUE EST FOURNIE "TELLE QUELLE", SANS GARANTIE D'AUCUNE SORTE,
+    EXPLICITE OU IMPLICITE, NOTAMMENT SANS GARANTIE DE QUALITÉ MARCHANDE,
+    D’ADÉQUATION À UN USAGE PARTICULIER ET D'ABSENCE DE CONTREFAÇON. EN AUCUN
+    CAS, LES AUTEURS OU TITULAIRES DU DROIT D'AUTEUR NE SERONT RESPONSABLES DE
+    TOUT DOMMAGE, RÉCLAMATION OU AUTRE RESPONSABILITÉ, QUE CE SOIT DANS LE
+    CADRE D'UN CONTRAT, D'UN DÉLIT OU AUTRE, EN PROVENANCE DE, CONSÉCUTIF À OU
+    EN RELATION AVEC LA BIBLIOTHÈQUE OU SON UTILISATION, OU AVEC D'AUTRES
+    ÉLÉMENTS DE LA BIBLIOTHÈQUE.
+
+*/
+
+/**
+ *  \file arbre_binaire_statistiques.c
+ *
+ *  Statistiques de la librairie: noeuds alloués, libérés et visités,
+ *  lectures et écritures des fichiers, taille des piles de parcours et
+ *  histogramme des durées des fonctions principales. Les compteurs sont
+ *  propres à chaque fil d'exécution pour ne pas être partagés entre les
+ *  processeurs. Ils ne sont remplis que si la librairie est compilée avec
+ *  ARBRE_BINAIRE_STATISTIQUES (make STATISTIQUES=1); sinon seules les
+ *  fonctions de lecture et de remise à zéro existent.
+ *
+ */
+
+#include <string.h>
+#include <time.h>
+#include "arbre_binaire.h"
+#include "arbre_binaire_interne.h"
+
+#ifdef ARBRE_BINAIRE_STATISTIQUES
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+/**
+ *  \brief Nombre de mesures imbriquées conservées. Les mesures plus
+ *         profondes ne sont pas ajoutées aux histogrammes.
+ */
+#define MESURES_IMBRIQUEES 8
+
+/**
+ *  \brief Une mesure de durée en cours.
+ */
+struct mesure_en_cours {
+    arbre_binaire_fonction fonction;
+    unsigned long long debut;
+};
+
+LOCAL_AU_FIL arbre_binaire_statistiques statistiques_arbre_binaire;
+
+LOCAL_AU_FIL arbre_binaire_fonction fonction_arbre_binaire;
+
+static LOCAL_AU_FIL struct mesure_en_cours mesures[MESURES_IMBRIQUEES];
+
+static LOCAL_AU_FIL int imbrication;
+
+/**
+ *  \brief Donne le temps écoulé, en nanosecondes, depuis un moment fixe.
+ */
+static unsigned long long horloge(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER compteur;
+    LARGE_INTEGER frequence;
+
+    QueryPerformanceCounter(&compteur);
+    QueryPerformanceFrequency(&frequence);
+    return (unsigned long long)((double)compteur.QuadPart * 1e9 /
+                                (double)frequence.QuadPart);
+#else
+    struct timespec temps;
+
+    clock_gettime(CLOCK_MONOTONIC, &temps);
+    return (unsigned long long)temps.tv_sec * 1000000000ULL +
+           (unsigned long long)temps.tv_nsec;
+#endif
+}
+
+/**
+ *  \brief Commence la mesure de la durée d'une fonction.
+ *
+ *  \param fonction : La fonction mesurée.
+ */
+void commencer_mesure_arbre_binaire(arbre_binaire_fonction fonction)
+{
+    if (imbrication == 0) {
+        fonction_arbre_binaire = fonction;
+    }
+    if (imbrication < MESURES_IMBRIQUEES) {
+        mesures[imbrication].fonction = fonction;
+        mesures[imbrication].debut = horloge();
+    }
+    imbrication = imbrication + 1;
+}
+
+/**
+ *  \brief Termine la dernière mesure commencée et l'ajoute à
+ *         l'histogramme de sa fonction.
+ */
+void terminer_mesure_arbre_binaire(void)
+{
+    struct mesure_en_cours* mesure;
+    unsigned long long duree;
+    int classe = 0;
+
+    imbrication = imbrication - 1;
+    if (imbrication < MESURES_IMBRIQUEES) {
+        mesure = &mesures[imbrication];
+        duree = horloge() - mesure->debut;
+        while (classe < ARBRE_BINAIRE_CLASSES_DUREE - 1 &&
+               duree >> (classe + 1) != 0) {
+            classe = classe + 1;
+        }
+        statistiques_arbre_binaire.appels[mesure->fonction] += 1;
+        statistiques_arbre_binaire.nanosecondes[mesure->fonction] += duree;
+        statistiques_arbre_binaire.durees[mesure->fonction][classe] += 1;
+    }
+    if (imbrication == 0) {
+        fonction_arbre_binaire = ARBRE_BINAIRE_FONCTION_AUTRE;
+    }
+}
+
+/**
+ *  \brief Compte les noeuds utilisés d'une arène.
+ *
+ *  \param arene : L'arène.
+ *
+ *  \return Le nombre de noeuds alloués et non libérés.
+ */
+size_t compter_noeuds_arene(const struct arbre_binaire_arene* arene)
+{
+    struct arbre_binaire_page* page;
+    size_t nombre = 0;
+    void** libre;
+
+    for (page = arene->pages; page; page = page->suivante) {
+        nombre = nombre + (fin_page_arene(arene, page) - page->debut) /
+                          arene->taille_noeud;
+    }
+    for (libre = arene->libres; libre; libre = *libre) {
+        nombre = nombre - 1;
+    }
+    return nombre;
+}
+
+#endif
+
+/**
+ *  \brief Copie les statistiques du fil d'exécution appelant. Les fils
+ *         créés par les fonctions *_parallele_arbre_binaire ont leurs
+ *         propres compteurs, qui ne sont pas repris.
+ *
+ *  \param statistiques : Reçoit les compteurs (mis à zéro si la librairie
+ *                        a été compilée sans ARBRE_BINAIRE_STATISTIQUES).
+ *
+ *  \return Faux si la librairie a été compilée sans statistiques.
+ */
+bool lire_statistiques_arbre_binaire(arbre_binaire_statistiques*
+                                     statistiques)
+{
+#ifdef ARBRE_BINAIRE_STATISTIQUES
+    *statistiques = statistiques_arbre_binaire;
+    return true;
+#else
+    memset(statistiques, 0, sizeof(arbre_binaire_statistiques));
+    return false;
+#endif
+}
+
+/**
+ *  \brief Remet à zéro les statistiques du fil d'exécution appelant.
+ */
+void remettre_statistiques_arbre_binaire(void)
+{
+#ifdef ARBRE_BINAIRE_STATISTIQUES
+    memset(&statistiques_arbre_binaire, 0,
+           sizeof(arbre_binaire_statistiques));
+#endif
+}
@@ -0,0 +1,615 @@
+/*
+
+    Copyright (c) 2015 Nicolas Bisson
+
+    L'autorisation est accorde, gracieusement,  toute personne acqurant une
+    copie de cette bibliothque et des fichiers de documentation associs
+    (la "Bibliothque"), de commercialiser la Bibliothque sans restriction,
+    notamment les droits d'utiliser, de copier, de modifier, de fusionner, de
+    publier, de distribuer, de sous-licencier et / ou de vendre des copies de
+    la Bibliothque, ainsi que d'autoriser les personnes auxquelles la
+    Bibliothque est fournie  le faire, sous rserve des conditions suivantes:
+
+    La dclaration de copyright ci-dessus et la prsente autorisation doivent
+    tre incluses dans toutes copies ou parties substantielles de la
+    Bibliothque.
+
+    LA BIBLIOTHQUE EST FOURNIE "TELLE QUELLE", SANS GARANTIE D'AUCUNE SORTE,
+    EXPLICITE OU IMPLICITE, NOTAMMENT SANS GARANTIE DE QUALIT MARCHANDE,
+    DADQUATION  UN USAGE PARTICULIER ET D'ABSENCE DE CONTREFAON. EN AUCUN
+    CAS, LES AUTEURS OU TITULAIRES DU DROIT D'AUTEUR NE SERONT RESPONSABLES DE
+    TOUT DOMMAGE, RCLAMATION OU AUTRE RESPONSABILIT, QUE CE SOIT DANS LE
+    CADRE D'UN CONTRAT, D'UN DLIT OU AUTRE, EN PROVENANCE DE, CONSCUTIF  OU
+    EN RELATION AVEC LA BIBLIOTHQUE OU SON UTILISATION, OU AVEC D'AUTRES
+    LMENTS DE LA BIBLIOTHQUE.
+
+*/
+
+/**
+ *  \file main.c
+ *
+ *  Mesure les performances de l'arbre binaire: cration des noeuds avec
+ *  creer_*_enfant_arbre_binaire, recherche, compteurs, sauvegarde,
+ *  chargement et destruction, pour plusieurs formes d'arbre. Les rsultats
+ *  sont affichs et crits en JSON pour comparer les versions.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "arbre_binaire.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+/**
+ *  \brief Les formes d'arbre mesures.
+ */
+typedef enum {
+    FORME_EQUILIBRE,    /**< Arbre complet, rempli en ordre de largeur. */
+    FORME_ALEATOIRE,    /**< Chaque noeud est plac sur une place libre
+                             choisie au hasard. */
+    FORME_GAUCHE,       /**< Chane de premiers enfants. */
+    FORME_DROITE,       /**< Chane de seconds enfants. */
+    NOMBRE_FORMES
+} forme_arbre;
+
+/**
+ *  \brief Les oprations mesures.
+ */
+typedef enum {
+    OPERATION_CREER,
+    OPERATION_CONTIENT,
+    OPERATION_ELEMENTS,
+    OPERATION_FEUILLES,
+    OPERATION_HAUTEUR,
+    OPERATION_SAUVEGARDER,
+    OPERATION_CHARGER,
+    OPERATION_DETRUIRE,
+    NOMBRE_OPERATIONS
+} operation_arbre;
+
+static const char* noms_formes[NOMBRE_FORMES] = {
+    "equilibre", "aleatoire", "gauche", "droite"
+};
+
+static const char* noms_operations[NOMBRE_OPERATIONS] = {
+    "creer", "contient", "nombre_elements", "nombre_feuilles", "hauteur",
+    "sauvegarder", "charger", "detruire"
+};
+
+/**
+ *  \brief Le meilleur temps d'une opration parmi les rptitions.
+ */
+struct mesure {
+    double secondes;    /**< Le meilleur temps, pour toutes les oprations
+                             d'une rptition. */
+    long operations;    /**< Le nombre d'appels par rptition. */
+    double noeuds;      /**< Le nombre de noeuds traits par rptition. */
+    double octets;      /**< Le nombre d'octets lus ou crits par
+                             rptition (0 si l'opration n'en lit pas). */
+};
+
+/**
+ *  \brief Les rsultats d'une forme d'arbre.
+ */
+struct resultat {
+    bool mesuree;
+    struct mesure mesures[NOMBRE_OPERATIONS];
+};
+
+/**
+ *  \brief Une place libre sous un noeud dj cr.
+ */
+struct emplacement {
+    arbre_binaire* noeud;
+    bool premier;
+};
+
+/**
+ *  \brief Les paramtres de la ligne de commande.
+ */
+struct parametres {
+    int taille;
+    int repetitions;
+    unsigned int options;
+    unsigned int sauvegarde;
+    bool formes[NOMBRE_FORMES];
+    char* json;
+    char* fichier;
+};
+
+/**
+ *  \brief Donne le temps coul, en secondes, depuis un moment fixe.
+ */
+static double maintenant(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER compteur;
+    LARGE_INTEGER frequence;
+
+    QueryPerformanceCounter(&compteur);
+    QueryPerformanceFrequency(&frequence);
+    return (double)compteur.QuadPart / (double)frequence.QuadPart;
+#else
+    struct timespec temps;
+
+    clock_gettime(CLOCK_MONOTONIC, &temps);
+    return (double)temps.tv_sec + (double)temps.tv_nsec / 1e9;
+#endif
+}
+
+/**
+ *  \brief Donne le pic de mmoire rsidente du processus, en kilo-octets
+ *         (0 s'il n'est pas connu).
+ */
+static long pic_memoire_ko(void)
+{
+#ifdef _WIN32
+    return 0;
+#else
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+/**
+ *  \brief Gnrateur pseudo-alatoire (xorshift), identique sur toutes les
+ *         plateformes pour que les arbres alatoires soient comparables.
+ */
+static unsigned int hasard(unsigned int* graine)
+{
+    unsigned int x = *graine;
+
+    x = x ^ (x << 13);
+    x = x ^ (x >> 17);
+    x = x ^ (x << 5);
+    *graine = x;
+    return x;
+}
+
+/**
+ *  \brief Cre un enfant  une place libre et y place deux nouvelles
+ *         places libres.
+ *
+ *  \return L'enfant cr, ou NULL en cas d'erreur.
+ */
+static arbre_binaire* remplir_emplacement(struct emplacement* places,
+                                          int* fin, struct emplacement place,
+                                          int valeur)
+{
+    arbre_binaire* enfant = NULL;
+
+    if (place.premier) {
+        if (creer_premier_enfant_arbre_binaire(place.noeud, valeur) ==
+                ARBRE_BINAIRE_SUCCES) {
+            enfant = premier_enfant_arbre_binaire(place.noeud);
+        }
+    } else if (creer_second_enfant_arbre_binaire(place.noeud, valeur) ==
+                   ARBRE_BINAIRE_SUCCES) {
+        enfant = second_enfant_arbre_binaire(place.noeud);
+    }
+    if (enfant && places) {
+        places[*fin].noeud = enfant;
+        places[*fin].premier = true;
+        places[*fin + 1].noeud = enfant;
+        places[*fin + 1].premier = false;
+        *fin = *fin + 2;
+    }
+    return enfant;
+}
+
+/**
+ *  \brief Construit un arbre d'une forme donne avec
+ *         creer_*_enfant_arbre_binaire. Le noeud i a la valeur i.
+ *
+ *  \param forme   : La forme de l'arbre.
+ *  \param taille  : Le nombre de noeuds.
+ *  \param options : Les options de l'arbre.
+ *  \param places  : Espace pour 2 * taille + 1 places libres, allou
+ *                   d'avance pour ne pas tre mesur.
+ *
+ *  \return L'arbre, ou NULL en cas d'erreur.
+ */
+static arbre_binaire* construire(forme_arbre forme, int taille,
+                                 unsigned int options,
+                                 struct emplacement* places)
+{
+    struct emplacement place;
+    arbre_binaire* racine;
+    arbre_binaire* noeud;
+    unsigned int graine = 2463534242u;
+    int debut = 0;
+    int fin = 0;
+    int choix;
+    int i;
+
+    racine = creer_arbre_binaire_options(0, options);
+    noeud = racine;
+    if (racine && (forme == FORME_EQUILIBRE || forme == FORME_ALEATOIRE)) {
+        place.noeud = racine;
+        place.premier = true;
+        places[fin] = place;
+        place.premier = false;
+        places[fin + 1] = place;
+        fin = 2;
+    }
+    for (i = 1; noeud && i < taille; i++) {
+        if (forme == FORME_GAUCHE || forme == FORME_DROITE) {
+            place.noeud = noeud;
+            place.premier = forme == FORME_GAUCHE;
+            noeud = remplir_emplacement(NULL, &fin, place, i);
+        } else {
+            if (forme == FORME_ALEATOIRE) {
+                choix = debut + (int)(hasard(&graine) % (fin - debut));
+                place = places[choix];
+                places[choix] = places[debut];
+                places[debut] = place;
+            }
+            place = places[debut];
+            debut = debut + 1;
+            noeud = remplir_emplacement(places, &fin, place, i);
+        }
+    }
+    if (racine && noeud == NULL) {
+        fprintf(stderr, "Impossible de creer l'arbre: %s\n",
+                a_erreur_arbre_binaire(racine) ?
+                    erreur_arbre_binaire(racine) : "plus de memoire");
+        detruire_arbre_binaire(racine);
+        racine = NULL;
+    }
+    return racine;
+}
+
+/**
+ *  \brief Garde le meilleur temps d'une opration.
+ */
+static void noter(struct mesure* mesure, double debut, long operations,
+                  double noeuds, double octets)
+{
+    double secondes = maintenant() - debut;
+
+    if (mesure->operations == 0 || secondes < mesure->secondes) {
+        mesure->secondes = secondes;
+    }
+    mesure->operations = operations;
+    mesure->noeuds = noeuds;
+    mesure->octets = octets;
+}
+
+/**
+ *  \brief Donne la taille d'un fichier, en octets.
+ */
+static double taille_fichier(char* nom)
+{
+    FILE* fichier = fopen(nom, "rb");
+    double taille = 0;
+
+    if (fichier) {
+        if (fseek(fichier, 0, SEEK_END) == 0) {
+            taille = (double)ftell(fichier);
+        }
+        fclose(fichier);
+    }
+    return taille;
+}
+
+/**
+ *  \brief Effectue une rptition des mesures sur une forme d'arbre.
+ *
+ *  \return Faux si une opration a chou.
+ */
+static bool mesurer_repetition(struct parametres* parametres,
+                               forme_arbre forme, struct emplacement* places,
+                               struct resultat* resultat)
+{
+    struct mesure* mesures = resultat->mesures;
+    arbre_binaire* arbre;
+    arbre_binaire* charge;
+    double taille = parametres->taille;
+    double octets;
+    double debut;
+    long requetes;
+    long total = 0;
+    long i;
+    bool reussi = true;
+
+    /* Les recherches et les compteurs sont rpts sur les petits arbres
+       pour que le temps mesur ne soit pas trop court. */
+    requetes = 4000000 / parametres->taille;
+    if (requetes < 1) {
+        requetes = 1;
+    } else if (requetes > 10000) {
+        requetes = 10000;
+    }
+    debut = maintenant();
+    arbre = construire(forme, parametres->taille, parametres->options,
+                       places);
+    noter(&mesures[OPERATION_CREER], debut, parametres->taille, taille, 0);
+    if (arbre == NULL) {
+        return false;
+    }
+    /* Les valeurs cherches sont absentes: tout l'arbre est parcouru. */
+    debut = maintenant();
+    for (i = 0; i < requetes; i++) {
+        total = total + contient_element_arbre_binaire(arbre, -1 - (int)i);
+    }
+    noter(&mesures[OPERATION_CONTIENT], debut, requetes, taille * requetes,
+          0);
+    debut = maintenant();
+    for (i = 0; i < requetes; i++) {
+        total = total + nombre_elements_arbre_binaire(arbre);
+    }
+    noter(&mesures[OPERATION_ELEMENTS], debut, requetes, taille * requetes,
+          0);
+    debut = maintenant();
+    for (i = 0; i < requetes; i++) {
+        total = total + nombre_feuilles_arbre_binaire(arbre);
+    }
+    noter(&mesures[OPERATION_FEUILLES], debut, requetes, taille * requetes,
+          0);
+    debut = maintenant();
+    for (i = 0; i < requetes; i++) {
+        total = total + hauteur_arbre_binaire(arbre);
+    }
+    noter(&mesures[OPERATION_HAUTEUR], debut, requetes, taille * requetes,
+          0);
+    debut = maintenant();
+    if (sauvegarder_arbre_binaire_options(arbre, parametres->fichier,
+                                          parametres->sauvegarde) !=
+            ARBRE_BINAIRE_SUCCES) {
+        fprintf(stderr, "Impossible de sauvegarder l'arbre: %s\n",
+                erreur_arbre_binaire(arbre));
+        reussi = false;
+    }
+    octets = taille_fichier(parametres->fichier);
+    noter(&mesures[OPERATION_SAUVEGARDER], debut, 1, taille, octets);
+    if (reussi) {
+        debut = maintenant();
+        charge = charger_arbre_binaire_options(parametres->fichier,
+                                               parametres->options);
+        noter(&mesures[OPERATION_CHARGER], debut, 1, taille, octets);
+        if (charge == NULL || a_erreur_arbre_binaire(charge) ||
+                nombre_elements_arbre_binaire(charge) != parametres->taille) {
+            fprintf(stderr, "Impossible de charger l'arbre.\n");
+            reussi = false;
+        }
+        if (charge) {
+            detruire_arbre_binaire(charge);
+        }
+        remove(parametres->fichier);
+    }
+    debut = maintenant();
+    detruire_arbre_binaire(arbre);
+    noter(&mesures[OPERATION_DETRUIRE], debut, parametres->taille, taille,
+          0);
+    /* Le total est utilis pour que les appels ne soient pas retirs. */
+    return reussi && total != -1;
+}
+
+/**
+ *  \brief Affiche les rsultats d'une forme d'arbre. Ils sont affichs sur
+ *         la sortie d'erreur si le JSON est crit sur la sortie standard.
+ */
+static void afficher(struct parametres* parametres, forme_arbre forme,
+                     struct resultat* resultat)
+{
+    FILE* sortie = stdout;
+    struct mesure* mesure;
+    int i;
+
+    if (strcmp(parametres->json, "-") == 0) {
+        sortie = stderr;
+    }
+    fprintf(sortie, "Forme %s: %d noeuds, options 0x%02X, %d repetitions\n",
+            noms_formes[forme], parametres->taille, parametres->options,
+            parametres->repetitions);
+    fprintf(sortie, "  %-16s %14s %14s %10s\n", "operation", "ns/op",
+            "noeuds/s", "Mo/s");
+    for (i = 0; i < NOMBRE_OPERATIONS; i++) {
+        mesure = &resultat->mesures[i];
+        fprintf(sortie, "  %-16s %14.1f %14.0f", noms_operations[i],
+                mesure->secondes * 1e9 / mesure->operations,
+                mesure->noeuds / mesure->secondes);
+        if (mesure->octets > 0) {
+            fprintf(sortie, " %10.1f\n",
+                    mesure->octets / mesure->secondes / 1e6);
+        } else {
+            fprintf(sortie, " %10s\n", "-");
+        }
+    }
+    fprintf(sortie, "\n");
+}
+
+/**
+ *  \brief crit les rsultats en JSON.
+ *
+ *  \return Faux si le fichier n'a pas pu tre crit.
+ */
+static bool ecrire_json(struct parametres* parametres,
+                        struct resultat* resultats, long pic_ko)
+{
+    struct mesure* mesure;
+    FILE* fichier;
+    bool premiere = true;
+    int forme;
+    int i;
+
+    if (strcmp(parametres->json, "-") == 0) {
+        fichier = stdout;
+    } else {
+        fichier = fopen(parametres->json, "w");
+    }
+    if (fichier == NULL) {
+        return false;
+    }
+    fprintf(fichier, "{\n  \"taille\": %d,\n  \"repetitions\": %d,\n"
+            "  \"options\": %u,\n  \"sauvegarde\": %u,\n"
+            "  \"pic_rss_ko\": %ld,\n  \"formes\": [",
+            parametres->taille, parametres->repetitions,
+            parametres->options, parametres->sauvegarde, pic_ko);
+    for (forme = 0; forme < NOMBRE_FORMES; forme++) {
+        if (resultats[forme].mesuree) {
+            fprintf(fichier, "%s\n    {\n      \"forme\": \"%s\",\n"
+                    "      \"mesures\": [",
+                    premiere ? "" : ",", noms_formes[forme]);
+            for (i = 0; i < NOMBRE_OPERATIONS; i++) {
+                mesure = &resultats[forme].mesures[i];
+                fprintf(fichier, "%s\n        {\"operation\": \"%s\", "
+                        "\"ns_op\": %.1f, \"noeuds_s\": %.0f, "
+                        "\"mo_s\": %.1f}",
+                        i ? "," : "", noms_operations[i],
+                        mesure->secondes * 1e9 / mesure->operations,
+                        mesure->noeuds / mesure->secondes,
+                        mesure->octets / mesure->secondes / 1e6);
+            }
+            fprintf(fichier, "\n      ]\n    }");
+            premiere = false;
+        }
+    }
+    fprintf(fichier, "\n  ]\n}\n");
+    if (fichier != stdout) {
+        return fclose(fichier) == 0;
+    }
+    return true;
+}
+
+/**
+ *  \brief Affiche la manire d'utiliser le programme.
+ */
+static void afficher_usage(char* programme)
+{
+    fprintf(stderr,
+            "Usage: %s [-n taille] [-r repetitions] [-f forme]\n"
+            "          [-o options] [-s sauvegarde] [-j fichier.json]\n"
+            "  -n : nombre de noeuds (1000000 par defaut)\n"
+            "  -r : nombre de repetitions, le meilleur temps est garde"
+            " (3)\n"
+            "  -f : equilibre, aleatoire, gauche ou droite (toutes les"
+            " formes\n"
+            "       par defaut; peut etre repete)\n"
+            "  -o : options ARBRE_BINAIRE_OPTION_* de l'arbre (0)\n"
+            "  -s : options ARBRE_BINAIRE_SAUVEGARDE_* (0)\n"
+            "  -j : fichier JSON, - pour la sortie standard"
+            " (arbre_binaire_bench.json);\n"
+            "       les resultats sont alors affiches sur la sortie"
+            " d'erreur\n", programme);
+}
+
+/**
+ *  \brief Lit les paramtres de la ligne de commande.
+ *
+ *  \return Faux si un paramtre est invalide.
+ */
+static bool lire_parametres(int argc, char* argv[],
+                            struct parametres* parametres)
+{
+    bool forme_choisie = false;
+    bool reussi = true;
+    int forme;
+    int i;
+
+    parametres->taille = 1000000;
+    parametres->repetitions = 3;
+    parametres->options = 0;
+    parametres->sauvegarde = 0;
+    parametres->json = "arbre_binaire_bench.json";
+    parametres->fichier = "arbre_binaire_bench.bin";
+    for (i = 1; reussi && i < argc; i = i + 2) {
+        if (i + 1 >= argc || argv[i][0] != '-' || argv[i][1] == '\0' ||
+                argv[i][2] != '\0') {
+            reussi = false;
+        } else if (argv[i][1] == 'n') {
+            parametres->taille = atoi(argv[i + 1]);
+            reussi = parametres->taille > 0;
+        } else if (argv[i][1] == 'r') {
+            parametres->repetitions = atoi(argv[i + 1]);
+            reussi = parametres->repetitions > 0;
+        } else if (argv[i][1] == 'o') {
+            parametres->options = strtoul(argv[i + 1], NULL, 0);
+        } else if (argv[i][1] == 's') {
+            parametres->sauvegarde = strtoul(argv[i + 1], NULL, 0);
+        } else if (argv[i][1] == 'j') {
+            parametres->json = argv[i + 1];
+        } else if (argv[i][1] == 'f') {
+            reussi = false;
+            for (forme = 0; forme < NOMBRE_FORMES; forme++) {
+                if (strcmp(argv[i + 1], noms_formes[forme]) == 0) {
+                    parametres->formes[forme] = true;
+                    reussi = true;
+                }
+            }
+            forme_choisie = true;
+        } else {
+            reussi = false;
+        }
+    }
+    for (forme = 0; !forme_choisie && forme < NOMBRE_FORMES; forme++) {
+        parametres->formes[forme] = true;
+    }
+    return reussi;
+}
+
+/**
+ * \brief Mesure les performances de l'arbre binaire.
+ */
+int main(int argc, char* argv[])
+{
+    struct parametres parametres;
+    struct resultat resultats[NOMBRE_FORMES];
+    struct emplacement* places;
+    bool reussi = true;
+    long pic_ko;
+    int forme;
+    int i;
+
+    memset(&parametres, 0, sizeof(parametres));
+    memset(resultats, 0, sizeof(resultats));
+    if (!lire_parametres(argc, argv, &parametres)) {
+        afficher_usage(argv[0]);
+        return 2;
+    }
+    places = malloc((2 * (size_t)parametres.taille + 1) *
+                    sizeof(struct emplacement));
+    if (places == NULL) {
+        fprintf(stderr, "Il n'y a plus de memoire.\n");
+        return 1;
+    }
+    for (forme = 0; reussi && forme < NOMBRE_FORMES; forme++) {
+        if (parametres.formes[forme]) {
+            for (i = 0; reussi && i < parametres.repetitions; i++) {
+                reussi = mesurer_repetition(&parametres, forme, places,
+                                            &resultats[forme]);
+            }
+            resultats[forme].mesuree = reussi;
+            if (reussi) {
+                afficher(&parametres, forme, &resultats[forme]);
+            }
+        }
+    }
+    free(places);
+    pic_ko = pic_memoire_ko();
+    if (reussi) {
+        fprintf(strcmp(parametres.json, "-") == 0 ? stderr : stdout,
+                "Pic de memoire residente du processus: %ld Ko\n", pic_ko);
+    }
+    if (reussi && !ecrire_json(&parametres, resultats, pic_ko)) {
+        fprintf(stderr, "Impossible d'ecrire %s.\n", parametres.json);
+        reussi = false;
+    }
+    return reussi ? 0 : 1;
+}
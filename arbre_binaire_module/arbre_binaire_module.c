@@ -25,15 +25,23 @@
 
 */
 
+
 /**
  *  \file arbre_binaire_module.c
  *
  *  Fichier d'implmentation du module Python permettant d'interfacer
  *  avec la librairie "arbre_binaire".
  *
+ *  Un arbre est reprsent par un objet Python de type "Arbre". L'objet
+ *  de la racine dtient l'arbre et le dtruit lorsqu'il est libr; les
+ *  objets des autres noeuds gardent une rfrence vers lui. Les valeurs
+ *  exportes sont ranges dans des objets "Tableau", qui respectent le
+ *  protocole "buffer" et peuvent tre lus par NumPy sans copie.
+ *
  */
 
 #include <Python.h>
+#include <limits.h>
 #include "arbre_binaire.h"
 
 /**
@@ -42,98 +50,159 @@
 static PyObject *arbre_binaire_erreur;
 
 /**
- * \brief "Wrapper" pour la fonction 'creer_arbre_binaire'
+ * \brief Objet Python reprsentant un noeud d'un arbre binaire.
+ */
+typedef struct {
+    PyObject_HEAD
+    arbre_binaire *noeud;       /**< Le noeud de la librairie. */
+    PyObject *racine;           /**< L'objet de la racine, NULL si c'est
+                                     la racine elle-mme. */
+    unsigned long retraits;     /**< Nombre de retraits d'enfants (racine
+                                     seulement). */
+    unsigned long generation;   /**< Valeur de "retraits" de la racine
+                                     lorsque l'objet a t cr. */
+    int lecteurs;               /**< Nombre de lectures en cours sans le
+                                     GIL (racine seulement). */
+    unsigned int options;       /**< Options demandes  la cration de
+                                     l'arbre (racine seulement). */
+} ArbreObjet;
+
+/**
+ * \brief Tableau contigu de valeurs export par un arbre.
+ */
+typedef struct {
+    PyObject_HEAD
+    void *donnees;              /**< Les lments du tableau. */
+    Py_ssize_t nombre;          /**< Le nombre d'lments. */
+    Py_ssize_t taille_element;  /**< La taille d'un lment en octets. */
+    char *format;               /**< Le format "struct" d'un lment. */
+} TableauObjet;
+
+/**
+ * \brief tat de l'exportation d'un arbre pendant son parcours.
+ */
+struct exportation {
+    int *valeurs;
+    unsigned char *masques;     /**< NULL si seules les valeurs sont
+                                     demandes. */
+    Py_ssize_t indice;
+};
+
+/**
+ * \brief Entiers reus de Python: la mmoire d'un objet qui respecte le
+ *        protocole "buffer" avec le format "i", sinon une copie.
+ */
+struct entiers {
+    int *valeurs;
+    Py_ssize_t nombre;
+    Py_buffer vue;
+    bool copie;
+};
+
+static PyTypeObject ArbreType;
+static PyTypeObject TableauType;
+
+/**
+ * \brief Donne l'objet qui dtient l'arbre d'un noeud.
  *
- * \param self L'objet python reprsentant le module
- * \param args Conteneur possdant les arguments envoys  la fonction
+ * \param self L'objet d'un noeud
  *
- * \return Objet Python contenant l'adresse de l'arbre cr
+ * \return L'objet de la racine
  */
-static PyObject *arbre_binaire_creer(PyObject *sefl, PyObject *args)
+static ArbreObjet *arbre_binaire_racine(ArbreObjet *self)
 {
-    bool contient_erreur = false;
-    void* arbre = NULL;
-    PyObject * resultat;
-    int valeur;
-    if (!PyArg_ParseTuple(args, "i", &valeur)) {
-        contient_erreur = true;
+    ArbreObjet *racine = self;
+    if (self->racine) {
+        racine = (ArbreObjet *)self->racine;
     }
-    if (contient_erreur) {
-        resultat = NULL;
-    } else {
-        arbre = creer_arbre_binaire(valeur);
-        if (arbre) {
-            resultat = Py_BuildValue("i", arbre);
-        } else {
-            PyErr_SetString(arbre_binaire_erreur, "Ne peut pas crer d'arbre binaire");
-            resultat = NULL;
-        }
+    return racine;
+}
+
+/**
+ * \brief Vrifie que le noeud d'un objet existe encore. Un retrait
+ *        d'enfant peut avoir libr n'importe quel noeud de l'arbre: les
+ *        objets crs avant un retrait ne sont donc plus utilisables.
+ *
+ * \param self L'objet d'un noeud
+ *
+ * \return Vrai si le noeud existe, Faux (avec une exception) sinon
+ */
+static bool arbre_binaire_verifier(ArbreObjet *self)
+{
+    bool valide = true;
+    if (self->racine &&
+            self->generation != arbre_binaire_racine(self)->retraits) {
+        PyErr_SetString(arbre_binaire_erreur,
+                        "Le noeud a pu etre retire de l'arbre.");
+        valide = false;
     }
-    return resultat;
+    return valide;
 }
 
 /**
- * \brief "Wrapper" pour la fonction 'charger_arbre_binaire'
+ * \brief Vrifie qu'un noeud peut tre modifi: il existe encore et aucune
+ *        lecture de son arbre n'est en cours dans un autre fil.
  *
- * \param self L'objet python reprsentant le module
- * \param args Conteneur possdant les arguments envoys  la fonction
+ * \param self L'objet d'un noeud
  *
- * \return Objet Python contenant l'adresse de l'arbre binaire cr
+ * \return Vrai si le noeud peut tre modifi, Faux (avec une exception)
+ *         sinon
  */
-static PyObject *arbre_binaire_charger(PyObject *self, PyObject *args)
+static bool arbre_binaire_modifiable(ArbreObjet *self)
 {
-    bool contient_erreur = false;
-    void* arbre = NULL;
-    PyObject * resultat;
-    char *nom_fichier;
-    if (!PyArg_ParseTuple(args, "s", &nom_fichier)) {
-        contient_erreur = true;
+    bool valide = arbre_binaire_verifier(self);
+    if (valide && arbre_binaire_racine(self)->lecteurs > 0) {
+        PyErr_SetString(arbre_binaire_erreur,
+                        "L'arbre est lu par un autre fil.");
+        valide = false;
     }
-    if (contient_erreur) {
+    return valide;
+}
+
+/**
+ * \brief Transforme l'erreur de l'arbre, s'il y en a une, en exception.
+ *
+ * \param self L'objet d'un noeud
+ * \param resultat Le rsultat  renvoyer s'il n'y a pas d'erreur
+ *
+ * \return resultat, ou NULL s'il y a une erreur
+ */
+static PyObject *arbre_binaire_resultat(ArbreObjet *self, PyObject *resultat)
+{
+    if (resultat && a_erreur_arbre_binaire(self->noeud)) {
+        PyErr_SetString(arbre_binaire_erreur,
+                        erreur_arbre_binaire(self->noeud));
+        Py_DECREF(resultat);
         resultat = NULL;
-    } else {
-        arbre = charger_arbre_binaire(nom_fichier);
-        if (arbre) {
-            if (a_erreur_arbre_binaire(arbre)) {
-                contient_erreur = true;
-                PyErr_SetString(arbre_binaire_erreur, erreur_arbre_binaire(arbre));
-                detruire_arbre_binaire(arbre);
-                resultat = NULL;
-            } else {
-                resultat = Py_BuildValue("i", arbre);
-            }
-        } else {
-            PyErr_SetString(arbre_binaire_erreur, "Ne peut pas crer d'arbre binaire.");
-            resultat = NULL;
-        }
     }
     return resultat;
 }
 
 /**
- * \brief "Wrapper" pour la fonction 'detruire_arbre_binaire'
+ * \brief Cre l'objet Python d'un noeud de l'arbre d'un autre objet.
  *
- * \param self L'objet python reprsentant le module
- * \param args Conteneur possdant les arguments envoys  la fonction
+ * \param self L'objet d'un noeud du mme arbre
+ * \param noeud Le noeud (peut tre NULL)
  *
- * \return Objet Python 'None' (type NULL de Python)
+ * \return L'objet du noeud, ou None si le noeud est NULL
  */
-static PyObject *arbre_binaire_detruire(PyObject *self, PyObject *args)
+static PyObject *arbre_binaire_noeud(ArbreObjet *self, arbre_binaire *noeud)
 {
-    bool contient_erreur = false;
-    void* arbre = NULL;
-    PyObject * resultat;
-    if (PyArg_ParseTuple(args, "i", &arbre)) {
-        if (arbre) {
-            detruire_arbre_binaire(arbre);
-        } else {
-            contient_erreur = true;
+    ArbreObjet *racine = arbre_binaire_racine(self);
+    ArbreObjet *objet;
+    PyObject *resultat;
+    if (noeud) {
+        objet = PyObject_New(ArbreObjet, &ArbreType);
+        if (objet) {
+            objet->noeud = noeud;
+            objet->racine = (PyObject *)racine;
+            objet->retraits = 0;
+            objet->generation = racine->retraits;
+            objet->lecteurs = 0;
+            objet->options = 0;
+            Py_INCREF(racine);
         }
-    } else {
-        contient_erreur = true;
-    }
-    if (contient_erreur) {
-        resultat = NULL;
+        resultat = (PyObject *)objet;
     } else {
         Py_INCREF(Py_None);
         resultat = Py_None;
@@ -142,209 +211,429 @@ static PyObject *arbre_binaire_detruire(PyObject *self, PyObject *args)
 }
 
 /**
- * \brief "Wrapper" pour la fonction 'sauvegarder_arbre_binaire'
+ * \brief Cre l'objet Python de la racine d'un arbre.
  *
- * \param self L'objet python reprsentant le module
- * \param args Conteneur possdant les arguments envoys  la fonction
+ * \param arbre La racine de l'arbre (dtruite en cas d'erreur)
+ * \param options Les options demandes  la cration de l'arbre
  *
- * \return Objet Python 'None' (type NULL de Python)
+ * \return L'objet de la racine
  */
-static PyObject *arbre_binaire_sauvegarder(PyObject *self, PyObject *args)
+static PyObject *arbre_binaire_envelopper(arbre_binaire *arbre,
+                                          unsigned int options)
 {
-    bool contient_erreur = false;
-    void* arbre = NULL;
-    PyObject * resultat;
-    char *nom_fichier;
-    if (PyArg_ParseTuple(args, "is", &arbre, &nom_fichier)) {
-        if (arbre) {
-            sauvegarder_arbre_binaire(arbre, nom_fichier);
-            if (a_erreur_arbre_binaire(arbre)) {
-                contient_erreur = true;
-                PyErr_SetString(arbre_binaire_erreur, erreur_arbre_binaire(arbre));
-            }
+    ArbreObjet *objet = NULL;
+    if (arbre) {
+        objet = PyObject_New(ArbreObjet, &ArbreType);
+        if (objet) {
+            objet->noeud = arbre;
+            objet->racine = NULL;
+            objet->retraits = 0;
+            objet->generation = 0;
+            objet->lecteurs = 0;
+            objet->options = options;
         } else {
-            contient_erreur = true;
+            detruire_arbre_binaire(arbre);
         }
     } else {
-        contient_erreur = true;
+        PyErr_SetString(arbre_binaire_erreur,
+                        "Ne peut pas creer d'arbre binaire.");
     }
-    if (contient_erreur) {
-        resultat = NULL;
+    return (PyObject *)objet;
+}
+
+/**
+ * \brief Cre un objet "Tableau" qui prend possession de donnes.
+ *
+ * \param donnees Les lments (librs avec PyMem_Free)
+ * \param nombre Le nombre d'lments
+ * \param taille_element La taille d'un lment
+ * \param format Le format "struct" d'un lment
+ *
+ * \return L'objet du tableau
+ */
+static PyObject *arbre_binaire_tableau(void *donnees, Py_ssize_t nombre,
+                                       Py_ssize_t taille_element,
+                                       char *format)
+{
+    TableauObjet *tableau = PyObject_New(TableauObjet, &TableauType);
+    if (tableau) {
+        tableau->donnees = donnees;
+        tableau->nombre = nombre;
+        tableau->taille_element = taille_element;
+        tableau->format = format;
     } else {
-        Py_INCREF(Py_None);
-        resultat = Py_None;
+        PyMem_Free(donnees);
     }
-    return resultat;
+    return (PyObject *)tableau;
 }
 
 /**
- * \brief "Wrapper" pour la fonction 'nombre_elements_arbre_binaire'
+ * \brief Lit des entiers reus de Python. Les objets qui respectent le
+ *        protocole "buffer" avec des lments "i" contigus (array('i'),
+ *        tableaux NumPy int32, objets "Tableau") sont lus sans copie; les
+ *        autres objets itrables sont copis.
  *
- * \param self L'objet python reprsentant le module
- * \param args Conteneur possdant les arguments envoys  la fonction
+ * \param objet L'objet Python
+ * \param entiers Reoit les entiers ( librer avec
+ *                'arbre_binaire_liberer_entiers')
  *
- * \return Objet Python contenant l'lment reu
+ * \return Vrai si les entiers ont t lus, Faux (avec une exception) sinon
  */
-static PyObject *arbre_binaire_nombre_elements(PyObject *self, PyObject *args)
+static bool arbre_binaire_lire_entiers(PyObject *objet,
+                                       struct entiers *entiers)
 {
-    bool contient_erreur = false;
-    void* arbre = NULL;
-    PyObject * resultat;
-    int nombre_element = 0;
-    if (PyArg_ParseTuple(args, "i", &arbre)) {
-        if (arbre) {
-            nombre_element = nombre_elements_arbre_binaire(arbre);
-            if (a_erreur_arbre_binaire(arbre)) {
-                contient_erreur = true;
-                PyErr_SetString(arbre_binaire_erreur, erreur_arbre_binaire(arbre));
-            }
+    PyObject *sequence = NULL;
+    PyObject *element;
+    long valeur;
+    Py_ssize_t i;
+    bool valide = true;
+    entiers->copie = true;
+    entiers->valeurs = NULL;
+    if (PyObject_CheckBuffer(objet) &&
+            PyObject_GetBuffer(objet, &entiers->vue,
+                               PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == 0) {
+        if (entiers->vue.itemsize == sizeof(int) && entiers->vue.format &&
+                (strcmp(entiers->vue.format, "i") == 0 ||
+                 strcmp(entiers->vue.format, "@i") == 0 ||
+                 strcmp(entiers->vue.format, "=i") == 0)) {
+            entiers->copie = false;
+            entiers->valeurs = entiers->vue.buf;
+            entiers->nombre = entiers->vue.len / sizeof(int);
         } else {
-            contient_erreur = true;
+            PyBuffer_Release(&entiers->vue);
         }
     } else {
-        contient_erreur = true;
+        PyErr_Clear();
     }
-    if (contient_erreur) {
-        resultat = NULL;
+    if (entiers->copie) {
+        sequence = PySequence_Fast(objet, "Les valeurs doivent etre des "
+                                          "entiers.");
+        valide = sequence != NULL;
+    }
+    if (sequence) {
+        entiers->nombre = PySequence_Fast_GET_SIZE(sequence);
+        entiers->valeurs = PyMem_Malloc(entiers->nombre * sizeof(int));
+        if (entiers->valeurs == NULL) {
+            PyErr_NoMemory();
+            valide = false;
+        }
+        for (i = 0; valide && i < entiers->nombre; i = i + 1) {
+            element = PySequence_Fast_GET_ITEM(sequence, i);
+            valeur = PyLong_AsLong(element);
+            if (valeur == -1 && PyErr_Occurred()) {
+                valide = false;
+            } else if (valeur < INT_MIN || valeur > INT_MAX) {
+                PyErr_SetString(PyExc_OverflowError,
+                                "Une valeur depasse la taille d'un int.");
+                valide = false;
+            } else {
+                entiers->valeurs[i] = (int)valeur;
+            }
+        }
+        Py_DECREF(sequence);
+        if (valide == false) {
+            PyMem_Free(entiers->valeurs);
+        }
+    }
+    return valide;
+}
+
+/**
+ * \brief Libre les entiers lus par 'arbre_binaire_lire_entiers'.
+ *
+ * \param entiers Les entiers
+ */
+static void arbre_binaire_liberer_entiers(struct entiers *entiers)
+{
+    if (entiers->copie) {
+        PyMem_Free(entiers->valeurs);
     } else {
-        resultat = Py_BuildValue("i", nombre_element);
+        PyBuffer_Release(&entiers->vue);
     }
-    return resultat
 }
 
 /**
- * \brief "Wrapper" pour la fonction 'nombre_feuilles_arbre_binaire'
+ * \brief Constructeur du type "Arbre": Arbre(valeur, options=0)
  *
- * \param self L'objet python reprsentant le module
+ * \param type Le type de l'objet
  * \param args Conteneur possdant les arguments envoys  la fonction
+ * \param kwds Les arguments nomms
  *
- * \return Objet Python contenant l'lment reu
+ * \return Objet Python de la racine de l'arbre cr
  */
-static PyObject *arbre_binaire_nombre_feuilles(PyObject *self, PyObject *args)
+static PyObject *arbre_binaire_nouveau(PyTypeObject *type, PyObject *args,
+                                       PyObject *kwds)
 {
-    bool contient_erreur = false;
-    void* arbre = NULL;
-    PyObject * resultat;
-    int nombre_feuille = 0;
-    if (PyArg_ParseTuple(args, "i", &arbre)) {
-        if (arbre) {
-            nombre_feuille = nombre_feuilles_arbre_binaire(arbre);
-            if (a_erreur_arbre_binaire(arbre)) {
-                contient_erreur = true;
-                PyErr_SetString(arbre_binaire_erreur, erreur_arbre_binaire(arbre));
-            }
-        } else {
-            contient_erreur = true;
-        }
-    } else {
-        contient_erreur = true;
+    static char *mots_cles[] = {"valeur", "options", NULL};
+    PyObject *resultat = NULL;
+    int valeur;
+    unsigned int options = 0;
+    if (PyArg_ParseTupleAndKeywords(args, kwds, "i|I", mots_cles,
+                                    &valeur, &options)) {
+        resultat = arbre_binaire_envelopper(
+                creer_arbre_binaire_options(valeur, options), options);
     }
-    if (contient_erreur) {
-        resultat = NULL;
+    return resultat;
+}
+
+/**
+ * \brief Libre l'objet d'un noeud. L'objet de la racine dtruit l'arbre.
+ *
+ * \param self L'objet  librer
+ */
+static void arbre_binaire_liberer(ArbreObjet *self)
+{
+    if (self->racine) {
+        Py_DECREF(self->racine);
     } else {
-        resultat = Py_BuildValue("i", nombre_feuille);
+        detruire_arbre_binaire(self->noeud);
     }
-    return resultat
+    PyObject_Del(self);
 }
 
 /**
- * \brief "Wrapper" pour la fonction 'hauteur_arbre_binaire'
+ * \brief "Wrapper" pour la fonction 'charger_arbre_binaire_options'
  *
  * \param self L'objet python reprsentant le module
  * \param args Conteneur possdant les arguments envoys  la fonction
  *
- * \return Objet Python contenant l'lment reu
+ * \return Objet Python de la racine de l'arbre charg
  */
-static PyObject *arbre_binaire_hauteur(PyObject *self, PyObject *args)
+static PyObject *arbre_binaire_charger(PyObject *self, PyObject *args)
 {
-    bool contient_erreur = false;
-    void* arbre = NULL;
-    PyObject * resultat;
-    int hauteur = 0;
-    if (PyArg_ParseTuple(args, "i", &arbre)) {
-        if (arbre) {
-            hauteur = hauteur_arbre_binaire(arbre);
-            if (a_erreur_arbre_binaire(arbre)) {
-                contient_erreur = true;
-                PyErr_SetString(arbre_binaire_erreur, erreur_arbre_binaire(arbre));
-            }
+    PyObject *resultat = NULL;
+    arbre_binaire *arbre;
+    char *nom_fichier;
+    unsigned int options = 0;
+    if (PyArg_ParseTuple(args, "s|I", &nom_fichier, &options)) {
+        arbre = charger_arbre_binaire_options(nom_fichier, options);
+        if (arbre && a_erreur_arbre_binaire(arbre)) {
+            PyErr_SetString(arbre_binaire_erreur, erreur_arbre_binaire(arbre));
+            detruire_arbre_binaire(arbre);
         } else {
-            contient_erreur = true;
+            resultat = arbre_binaire_envelopper(arbre, options);
         }
-    } else {
-        contient_erreur = true;
     }
-    if (contient_erreur) {
-        resultat = NULL;
-    } else {
-        resultat = Py_BuildValue("i", hauteur);
+    return resultat;
+}
+
+/**
+ * \brief Construit un arbre quilibr  partir de valeurs tries, en un
+ *        seul appel  'construire_trie_arbre_binaire' fait sans le GIL.
+ *
+ * \param self L'objet python reprsentant le module
+ * \param args Conteneur possdant les arguments envoys  la fonction
+ * \param kwds Les arguments nomms (options=0)
+ *
+ * \return Objet Python de la racine de l'arbre construit
+ */
+static PyObject *arbre_binaire_from_sorted(PyObject *self, PyObject *args,
+                                           PyObject *kwds)
+{
+    static char *mots_cles[] = {"values", "options", NULL};
+    struct entiers entiers;
+    PyObject *objet;
+    PyObject *resultat = NULL;
+    arbre_binaire *arbre;
+    unsigned int options = 0;
+    if (PyArg_ParseTupleAndKeywords(args, kwds, "O|I", mots_cles,
+                                    &objet, &options) &&
+            arbre_binaire_lire_entiers(objet, &entiers)) {
+        Py_BEGIN_ALLOW_THREADS
+        arbre = construire_trie_arbre_binaire(entiers.valeurs,
+                                              entiers.nombre, options);
+        Py_END_ALLOW_THREADS
+        arbre_binaire_liberer_entiers(&entiers);
+        if (arbre && a_erreur_arbre_binaire(arbre)) {
+            PyErr_SetString(arbre_binaire_erreur, erreur_arbre_binaire(arbre));
+            detruire_arbre_binaire(arbre);
+        } else {
+            resultat = arbre_binaire_envelopper(arbre, options);
+        }
     }
-    return resultat
+    return resultat;
 }
 
 /**
- * \brief "Wrapper" pour la fonction 'element_arbre_binaire'
+ * \brief Construit un arbre  partir de ses valeurs en ordre prfixe et
+ *        des masques de leurs enfants (le format de 'exporter'), en un
+ *        seul appel  'construire_prefixe_arbre_binaire' fait sans le GIL.
  *
  * \param self L'objet python reprsentant le module
  * \param args Conteneur possdant les arguments envoys  la fonction
+ * \param kwds Les arguments nomms (options=0)
  *
- * \return Objet Python contenant l'lment reu
+ * \return Objet Python de la racine de l'arbre construit
  */
-static PyObject *arbre_binaire_element(PyObject *self, PyObject *args)
+static PyObject *arbre_binaire_from_preorder(PyObject *self, PyObject *args,
+                                             PyObject *kwds)
 {
-    bool contient_erreur = false;
-    void* arbre = NULL;
-    PyObject * resultat;
-    int element = 0;
-    if (PyArg_ParseTuple(args, "i", &arbre)) {
-        if (arbre) {
-            element = element_arbre_binaire(arbre);
-            if (a_erreur_arbre_binaire(arbre)) {
-                contient_erreur = true;
-                PyErr_SetString(arbre_binaire_erreur, erreur_arbre_binaire(arbre));
+    static char *mots_cles[] = {"values", "masks", "options", NULL};
+    struct entiers entiers;
+    Py_buffer masques;
+    PyObject *objet;
+    PyObject *objet_masques;
+    PyObject *octets = NULL;
+    PyObject *resultat = NULL;
+    arbre_binaire *arbre;
+    unsigned int options = 0;
+    bool valide;
+    if (PyArg_ParseTupleAndKeywords(args, kwds, "OO|I", mots_cles, &objet,
+                                    &objet_masques, &options)) {
+        if (!PyObject_CheckBuffer(objet_masques)) {
+            /* Une liste d'entiers est accepte comme bytes(masques) */
+            octets = PyBytes_FromObject(objet_masques);
+            objet_masques = octets;
+        }
+        valide = objet_masques &&
+                 PyObject_GetBuffer(objet_masques, &masques,
+                                    PyBUF_C_CONTIGUOUS) == 0;
+        if (valide && masques.itemsize != 1) {
+            PyErr_SetString(PyExc_TypeError,
+                            "Les masques doivent etre des octets.");
+            PyBuffer_Release(&masques);
+            valide = false;
+        }
+        if (valide && arbre_binaire_lire_entiers(objet, &entiers)) {
+            if (entiers.nombre != masques.len) {
+                PyErr_SetString(PyExc_ValueError, "Il doit y avoir un "
+                                "masque par valeur.");
+            } else {
+                Py_BEGIN_ALLOW_THREADS
+                arbre = construire_prefixe_arbre_binaire(entiers.valeurs,
+                        masques.buf, entiers.nombre, options);
+                Py_END_ALLOW_THREADS
+                if (arbre && a_erreur_arbre_binaire(arbre)) {
+                    PyErr_SetString(arbre_binaire_erreur,
+                                    erreur_arbre_binaire(arbre));
+                    detruire_arbre_binaire(arbre);
+                } else {
+                    resultat = arbre_binaire_envelopper(arbre, options);
+                }
             }
-        } else {
-            contient_erreur = true;
+            arbre_binaire_liberer_entiers(&entiers);
         }
-    } else {
-        contient_erreur = true;
+        if (valide) {
+            PyBuffer_Release(&masques);
+        }
+        Py_XDECREF(octets);
     }
-    if (contient_erreur) {
-        resultat = NULL;
-    } else {
-        resultat = Py_BuildValue("i", element);
+    return resultat;
+}
+
+/**
+ * \brief "Wrapper" pour la fonction 'sauvegarder_arbre_binaire'
+ *
+ * \param self L'objet du noeud
+ * \param args Conteneur possdant les arguments envoys  la fonction
+ *
+ * \return Objet Python 'None' (type NULL de Python)
+ */
+static PyObject *arbre_binaire_sauvegarder(ArbreObjet *self, PyObject *args)
+{
+    PyObject *resultat = NULL;
+    char *nom_fichier;
+    if (arbre_binaire_verifier(self) &&
+            PyArg_ParseTuple(args, "s", &nom_fichier)) {
+        sauvegarder_arbre_binaire(self->noeud, nom_fichier);
+        Py_INCREF(Py_None);
+        resultat = arbre_binaire_resultat(self, Py_None);
+    }
+    return resultat;
+}
+
+/**
+ * \brief "Wrapper" pour la fonction 'nombre_elements_arbre_binaire'
+ *
+ * \param self L'objet du noeud
+ * \param args Aucun argument
+ *
+ * \return Objet Python contenant le nombre d'lments du sous-arbre
+ */
+static PyObject *arbre_binaire_nombre_elements(ArbreObjet *self,
+                                               PyObject *args)
+{
+    PyObject *resultat = NULL;
+    if (arbre_binaire_verifier(self)) {
+        resultat = arbre_binaire_resultat(self, PyLong_FromLong(
+                nombre_elements_arbre_binaire(self->noeud)));
     }
-    return resultat
+    return resultat;
+}
+
+/**
+ * \brief "Wrapper" pour la fonction 'nombre_feuilles_arbre_binaire'
+ *
+ * \param self L'objet du noeud
+ * \param args Aucun argument
+ *
+ * \return Objet Python contenant le nombre de feuilles du sous-arbre
+ */
+static PyObject *arbre_binaire_nombre_feuilles(ArbreObjet *self,
+                                               PyObject *args)
+{
+    PyObject *resultat = NULL;
+    if (arbre_binaire_verifier(self)) {
+        resultat = arbre_binaire_resultat(self, PyLong_FromLong(
+                nombre_feuilles_arbre_binaire(self->noeud)));
+    }
+    return resultat;
+}
+
+/**
+ * \brief "Wrapper" pour la fonction 'hauteur_arbre_binaire'
+ *
+ * \param self L'objet du noeud
+ * \param args Aucun argument
+ *
+ * \return Objet Python contenant la hauteur du sous-arbre
+ */
+static PyObject *arbre_binaire_hauteur(ArbreObjet *self, PyObject *args)
+{
+    PyObject *resultat = NULL;
+    if (arbre_binaire_verifier(self)) {
+        resultat = arbre_binaire_resultat(self, PyLong_FromLong(
+                hauteur_arbre_binaire(self->noeud)));
+    }
+    return resultat;
+}
+
+/**
+ * \brief "Wrapper" pour la fonction 'element_arbre_binaire'
+ *
+ * \param self L'objet du noeud
+ * \param args Aucun argument
+ *
+ * \return Objet Python contenant la valeur du noeud
+ */
+static PyObject *arbre_binaire_element(ArbreObjet *self, PyObject *args)
+{
+    PyObject *resultat = NULL;
+    if (arbre_binaire_verifier(self)) {
+        resultat = arbre_binaire_resultat(self, PyLong_FromLong(
+                element_arbre_binaire(self->noeud)));
+    }
+    return resultat;
 }
 
 /**
  * \brief "Wrapper" pour la fonction 'modifier_element_arbre_binaire'
  *
- * \param self L'objet python reprsentant le module
+ * \param self L'objet du noeud
  * \param args Conteneur possdant les arguments envoys  la fonction
  *
  * \return Objet Python 'None' (type NULL de Python)
  */
-static PyObject *arbre_binaire_modifier_element(PyObject *self, PyObject *args)
+static PyObject *arbre_binaire_modifier_element(ArbreObjet *self,
+                                                PyObject *args)
 {
-    bool contient_erreur = false;
-    void* arbre = NULL;
-    PyObject * resultat;
+    PyObject *resultat = NULL;
     int valeur;
-    if (PyArg_ParseTuple(args, "ii", &arbre, &valeur)) {
-        if (arbre) {
-            modifier_element_arbre_binaire(arbre, valeur);
-        } else {
-            contient_erreur = true;
-        }
-    } else {
-        contient_erreur = true;
-    }
-    if (contient_erreur) {
-        resultat = NULL;
-    } else {
+    if (arbre_binaire_modifiable(self) &&
+            PyArg_ParseTuple(args, "i", &valeur)) {
+        modifier_element_arbre_binaire(self->noeud, valeur);
         Py_INCREF(Py_None);
-        resultat = Py_None;
+        resultat = arbre_binaire_resultat(self, Py_None);
     }
     return resultat;
 }
@@ -352,277 +641,546 @@ static PyObject *arbre_binaire_modifier_element(PyObject *self, PyObject *args)
 /**
  * \brief "Wrapper" pour la fonction 'contient_element_arbre_binaire'
  *
- * \param self L'objet python reprsentant le module
+ * \param self L'objet du noeud
  * \param args Conteneur possdant les arguments envoys  la fonction
  *
- * \return Objet Python contenant l'lment reu
+ * \return Objet Python boolen
  */
-static PyObject *arbre_binaire_element(PyObject *self, PyObject *args)
+static PyObject *arbre_binaire_contient_element(ArbreObjet *self,
+                                                PyObject *args)
 {
-    bool contient_erreur = false;
-    void* arbre = NULL;
-    PyObject * resultat;
-    bool contient_element;
+    PyObject *resultat = NULL;
     int valeur;
-    if (PyArg_ParseTuple(args, "ii", &arbre, &valeur)) {
-        if (arbre) {
-            contient_element = contient_element_arbre_binaire(arbre, valeur);
-            if (a_erreur_arbre_binaire(arbre)) {
-                contient_erreur = true;
-                PyErr_SetString(arbre_binaire_erreur, erreur_arbre_binaire(arbre));
-            }
-        } else {
-            contient_erreur = true;
-        }
-    } else {
-        contient_erreur = true;
-    }
-    if (contient_erreur) {
-        resultat = NULL;
-    } else {
-        resultat = Py_BuildValue("i", contient_element);
+    if (arbre_binaire_verifier(self) &&
+            PyArg_ParseTuple(args, "i", &valeur)) {
+        resultat = arbre_binaire_resultat(self, PyBool_FromLong(
+                contient_element_arbre_binaire(self->noeud, valeur)));
     }
-    return resultat
+    return resultat;
 }
 
 /**
  * \brief "Wrapper" pour la fonction 'premier_enfant_arbre_binaire'
  *
- * \param self L'objet python reprsentant le module
- * \param args Conteneur possdant les arguments envoys  la fonction
+ * \param self L'objet du noeud
+ * \param args Aucun argument
  *
- * \return Objet Python contenant l'lment reu
+ * \return Objet Python du premier enfant, ou None
  */
-static PyObject *arbre_binaire_premier_enfant(PyObject *self, PyObject *args)
+static PyObject *arbre_binaire_premier_enfant(ArbreObjet *self,
+                                              PyObject *args)
 {
-    bool contient_erreur = false;
-    void* arbre = NULL;
-    PyObject * resultat;
-    bool premier_enfant;
-    if (PyArg_ParseTuple(args, "i", &arbre)) {
-        if (arbre) {
-            premier_enfant = premier_enfant_arbre_binaire(arbre);
-            if (a_erreur_arbre_binaire(arbre)) {
-                contient_erreur = true;
-                PyErr_SetString(arbre_binaire_erreur, erreur_arbre_binaire(arbre));
-            }
-        } else {
-            contient_erreur = true;
-        }
-    } else {
-        contient_erreur = true;
-    }
-    if (contient_erreur) {
-        resultat = NULL;
-    } else {
-        resultat = Py_BuildValue("i", premier_enfant);
+    PyObject *resultat = NULL;
+    if (arbre_binaire_verifier(self)) {
+        resultat = arbre_binaire_noeud(self,
+                premier_enfant_arbre_binaire(self->noeud));
     }
-    if (resultat == NULL) {
-        resultat = Py_None;
+    return resultat;
+}
+
+/**
+ * \brief "Wrapper" pour la fonction 'second_enfant_arbre_binaire'
+ *
+ * \param self L'objet du noeud
+ * \param args Aucun argument
+ *
+ * \return Objet Python du second enfant, ou None
+ */
+static PyObject *arbre_binaire_second_enfant(ArbreObjet *self,
+                                             PyObject *args)
+{
+    PyObject *resultat = NULL;
+    if (arbre_binaire_verifier(self)) {
+        resultat = arbre_binaire_noeud(self,
+                second_enfant_arbre_binaire(self->noeud));
     }
-    return resultat
+    return resultat;
 }
 
 /**
  * \brief "Wrapper" pour la fonction 'creer_premier_enfant_arbre_binaire'
  *
- * \param self L'objet python reprsentant le module
+ * \param self L'objet du noeud
  * \param args Conteneur possdant les arguments envoys  la fonction
  *
- * \return Objet Python 'None' (type NULL de Python)
+ * \return Objet Python du nouvel enfant
  */
-static PyObject *arbre_binaire_creer_premier_enfant(PyObject *self, PyObject *args)
+static PyObject *arbre_binaire_creer_premier_enfant(ArbreObjet *self,
+                                                    PyObject *args)
 {
-    bool contient_erreur = false;
-    void* arbre = NULL;
-    PyObject * resultat;
+    PyObject *resultat = NULL;
     int valeur;
-    if (PyArg_ParseTuple(args, "ii", &arbre, &valeur)) {
-        if (arbre) {
-            creer_premier_enfant_arbre_binaire(arbre, valeur);
+    if (arbre_binaire_modifiable(self) &&
+            PyArg_ParseTuple(args, "i", &valeur)) {
+        if (creer_premier_enfant_arbre_binaire(self->noeud, valeur) ==
+                ARBRE_BINAIRE_SUCCES) {
+            resultat = arbre_binaire_noeud(self,
+                    premier_enfant_arbre_binaire(self->noeud));
         } else {
-            contient_erreur = true;
+            PyErr_SetString(arbre_binaire_erreur,
+                            erreur_arbre_binaire(self->noeud));
         }
-    } else {
-        contient_erreur = true;
-    }
-    if (contient_erreur) {
-        resultat = NULL;
-    } else {
-        Py_INCREF(Py_None);
-        resultat = Py_None;
     }
     return resultat;
 }
 
 /**
- * \brief "Wrapper" pour la fonction 'retirer_premier_enfant_arbre_binaire'
+ * \brief "Wrapper" pour la fonction 'creer_second_enfant_arbre_binaire'
  *
- * \param self L'objet python reprsentant le module
+ * \param self L'objet du noeud
  * \param args Conteneur possdant les arguments envoys  la fonction
  *
- * \return Objet Python 'None' (type NULL de Python)
+ * \return Objet Python du nouvel enfant
  */
-static PyObject *arbre_binaire_retirer_premier_enfant(PyObject *self, PyObject *args)
+static PyObject *arbre_binaire_creer_second_enfant(ArbreObjet *self,
+                                                   PyObject *args)
 {
-    bool contient_erreur = false;
-    void* arbre = NULL;
-    PyObject * resultat;
-    if (PyArg_ParseTuple(args, "i", &arbre)) {
-        if (arbre) {
-            retirer_premier_enfant_arbre_binaire(arbre);
+    PyObject *resultat = NULL;
+    int valeur;
+    if (arbre_binaire_modifiable(self) &&
+            PyArg_ParseTuple(args, "i", &valeur)) {
+        if (creer_second_enfant_arbre_binaire(self->noeud, valeur) ==
+                ARBRE_BINAIRE_SUCCES) {
+            resultat = arbre_binaire_noeud(self,
+                    second_enfant_arbre_binaire(self->noeud));
         } else {
-            contient_erreur = true;
+            PyErr_SetString(arbre_binaire_erreur,
+                            erreur_arbre_binaire(self->noeud));
         }
-    } else {
-        contient_erreur = true;
     }
-    if (contient_erreur) {
-        resultat = NULL;
-    } else {
+    return resultat;
+}
+
+/**
+ * \brief "Wrapper" pour la fonction 'retirer_premier_enfant_arbre_binaire'.
+ *        Les objets des autres noeuds de l'arbre deviennent inutilisables.
+ *
+ * \param self L'objet du noeud
+ * \param args Aucun argument
+ *
+ * \return Objet Python 'None' (type NULL de Python)
+ */
+static PyObject *arbre_binaire_retirer_premier_enfant(ArbreObjet *self,
+                                                      PyObject *args)
+{
+    PyObject *resultat = NULL;
+    ArbreObjet *racine = arbre_binaire_racine(self);
+    if (arbre_binaire_modifiable(self)) {
+        retirer_premier_enfant_arbre_binaire(self->noeud);
+        racine->retraits = racine->retraits + 1;
+        self->generation = racine->retraits;
         Py_INCREF(Py_None);
-        resultat = Py_None;
+        resultat = arbre_binaire_resultat(self, Py_None);
     }
     return resultat;
 }
 
 /**
- * \brief "Wrapper" pour la fonction 'second_enfant_arbre_binaire'
+ * \brief "Wrapper" pour la fonction 'retirer_second_enfant_arbre_binaire'.
+ *        Les objets des autres noeuds de l'arbre deviennent inutilisables.
  *
- * \param self L'objet python reprsentant le module
+ * \param self L'objet du noeud
+ * \param args Aucun argument
+ *
+ * \return Objet Python 'None' (type NULL de Python)
+ */
+static PyObject *arbre_binaire_retirer_second_enfant(ArbreObjet *self,
+                                                     PyObject *args)
+{
+    PyObject *resultat = NULL;
+    ArbreObjet *racine = arbre_binaire_racine(self);
+    if (arbre_binaire_modifiable(self)) {
+        retirer_second_enfant_arbre_binaire(self->noeud);
+        racine->retraits = racine->retraits + 1;
+        self->generation = racine->retraits;
+        Py_INCREF(Py_None);
+        resultat = arbre_binaire_resultat(self, Py_None);
+    }
+    return resultat;
+}
+
+/**
+ * \brief Visiteur qui copie la valeur et le masque des enfants d'un noeud.
+ */
+static bool arbre_binaire_exporter_noeud(arbre_binaire *noeud,
+                                         int profondeur, void *donnees)
+{
+    struct exportation *exportation = donnees;
+    unsigned char masque = 0;
+    exportation->valeurs[exportation->indice] = element_arbre_binaire(noeud);
+    if (exportation->masques) {
+        if (premier_enfant_arbre_binaire(noeud)) {
+            masque = masque | 1;
+        }
+        if (second_enfant_arbre_binaire(noeud)) {
+            masque = masque | 2;
+        }
+        exportation->masques[exportation->indice] = masque;
+    }
+    exportation->indice = exportation->indice + 1;
+    return true;
+}
+
+/**
+ * \brief Parcourt le sous-arbre d'un objet sans le GIL et copie ses
+ *        valeurs (et les masques de ses enfants si "masques" n'est pas
+ *        NULL) dans l'ordre demand.
+ *
+ * \param self L'objet du noeud
+ * \param ordre L'ordre du parcours
+ * \param exportation Les tableaux  remplir, assez grands pour tous les
+ *                    noeuds du sous-arbre
+ */
+static void arbre_binaire_exporter_sans_gil(ArbreObjet *self, int ordre,
+                                            struct exportation *exportation)
+{
+    ArbreObjet *racine = arbre_binaire_racine(self);
+    racine->lecteurs = racine->lecteurs + 1;
+    Py_BEGIN_ALLOW_THREADS
+    parcourir_arbre_binaire(self->noeud, ordre, arbre_binaire_exporter_noeud,
+                            exportation);
+    Py_END_ALLOW_THREADS
+    racine->lecteurs = racine->lecteurs - 1;
+}
+
+/**
+ * \brief Vrifie qu'un ordre reu de Python est un ordre de parcours.
+ *
+ * \param ordre L'ordre
+ *
+ * \return Vrai si l'ordre existe, Faux (avec une exception) sinon
+ */
+static bool arbre_binaire_verifier_ordre(int ordre)
+{
+    bool valide = true;
+    if (ordre < ARBRE_BINAIRE_PREFIXE || ordre > ARBRE_BINAIRE_LARGEUR) {
+        PyErr_SetString(PyExc_ValueError, "L'ordre n'existe pas.");
+        valide = false;
+    }
+    return valide;
+}
+
+/**
+ * \brief Copie les valeurs du sous-arbre et les enfants de chaque noeud
+ *        dans deux tableaux contigus, en un seul parcours. Les masques ont
+ *        le format de 'construire_prefixe_arbre_binaire': 1 pour le
+ *        premier enfant, 2 pour le second, 3 pour les deux.
+ *
+ * \param self L'objet du noeud
  * \param args Conteneur possdant les arguments envoys  la fonction
+ * \param kwds Les arguments nomms (ordre=PREFIXE)
  *
- * \return Objet Python contenant l'lment reu
+ * \return Tuple (valeurs, masques) de deux objets "Tableau"
  */
-static PyObject *arbre_binaire_second_enfant(PyObject *self, PyObject *args)
+static PyObject *arbre_binaire_exporter(ArbreObjet *self, PyObject *args,
+                                        PyObject *kwds)
 {
-    bool contient_erreur = false;
-    void* arbre = NULL;
-    PyObject * resultat;
-    bool second_enfant;
-    if (PyArg_ParseTuple(args, "i", &arbre)) {
-        if (arbre) {
-            second_enfant = second_enfant_arbre_binaire(arbre);
-            if (a_erreur_arbre_binaire(arbre)) {
-                contient_erreur = true;
-                PyErr_SetString(arbre_binaire_erreur, erreur_arbre_binaire(arbre));
-            }
+    static char *mots_cles[] = {"ordre", NULL};
+    struct exportation exportation;
+    PyObject *valeurs = NULL;
+    PyObject *masques = NULL;
+    PyObject *resultat = NULL;
+    int ordre = ARBRE_BINAIRE_PREFIXE;
+    Py_ssize_t nombre;
+    if (arbre_binaire_verifier(self) &&
+            PyArg_ParseTupleAndKeywords(args, kwds, "|i", mots_cles,
+                                        &ordre) &&
+            arbre_binaire_verifier_ordre(ordre)) {
+        nombre = nombre_elements_arbre_binaire(self->noeud);
+        exportation.valeurs = PyMem_Malloc(nombre * sizeof(int));
+        exportation.masques = PyMem_Malloc(nombre);
+        exportation.indice = 0;
+        if (exportation.valeurs == NULL || exportation.masques == NULL) {
+            PyMem_Free(exportation.valeurs);
+            PyMem_Free(exportation.masques);
+            PyErr_NoMemory();
         } else {
-            contient_erreur = true;
+            arbre_binaire_exporter_sans_gil(self, ordre, &exportation);
+            valeurs = arbre_binaire_tableau(exportation.valeurs, nombre,
+                                            sizeof(int), "i");
+            masques = arbre_binaire_tableau(exportation.masques, nombre,
+                                            1, "B");
         }
-    } else {
-        contient_erreur = true;
     }
-    if (contient_erreur) {
-        resultat = NULL;
-    } else {
-        resultat = Py_BuildValue("i", second_enfant);
+    if (valeurs && masques) {
+        resultat = arbre_binaire_resultat(self,
+                                          PyTuple_Pack(2, valeurs, masques));
     }
-    if (resultat == NULL) {
-        resultat = Py_None;
-    }
-    return resultat
+    Py_XDECREF(valeurs);
+    Py_XDECREF(masques);
+    return resultat;
 }
 
 /**
- * \brief "Wrapper" pour la fonction 'creer_second_enfant_arbre_binaire'
+ * \brief Renvoie les valeurs du sous-arbre dans une liste, dans l'ordre
+ *        demand. Le parcours est fait en un seul appel, sans le GIL.
  *
- * \param self L'objet python reprsentant le module
+ * \param self L'objet du noeud
  * \param args Conteneur possdant les arguments envoys  la fonction
+ * \param kwds Les arguments nomms (order=PREFIXE)
  *
- * \return Objet Python 'None' (type NULL de Python)
+ * \return Liste Python des valeurs
  */
-static PyObject *arbre_binaire_creer_second_enfant(PyObject *self, PyObject *args)
+static PyObject *arbre_binaire_to_list(ArbreObjet *self, PyObject *args,
+                                       PyObject *kwds)
 {
-    bool contient_erreur = false;
-    void* arbre = NULL;
-    PyObject * resultat;
-    int valeur;
-    if (PyArg_ParseTuple(args, "ii", &arbre, &valeur)) {
-        if (arbre) {
-            creer_second_enfant_arbre_binaire(arbre, valeur);
+    static char *mots_cles[] = {"order", NULL};
+    struct exportation exportation;
+    PyObject *resultat = NULL;
+    PyObject *element;
+    int ordre = ARBRE_BINAIRE_PREFIXE;
+    Py_ssize_t nombre;
+    Py_ssize_t i;
+    if (arbre_binaire_verifier(self) &&
+            PyArg_ParseTupleAndKeywords(args, kwds, "|i", mots_cles,
+                                        &ordre) &&
+            arbre_binaire_verifier_ordre(ordre)) {
+        nombre = nombre_elements_arbre_binaire(self->noeud);
+        exportation.valeurs = PyMem_Malloc(nombre * sizeof(int));
+        exportation.masques = NULL;
+        exportation.indice = 0;
+        if (exportation.valeurs) {
+            arbre_binaire_exporter_sans_gil(self, ordre, &exportation);
+            resultat = PyList_New(nombre);
         } else {
-            contient_erreur = true;
+            PyErr_NoMemory();
         }
-    } else {
-        contient_erreur = true;
-    }
-    if (contient_erreur) {
-        resultat = NULL;
-    } else {
-        Py_INCREF(Py_None);
-        resultat = Py_None;
+        for (i = 0; resultat && i < nombre; i = i + 1) {
+            element = PyLong_FromLong(exportation.valeurs[i]);
+            if (element) {
+                PyList_SET_ITEM(resultat, i, element);
+            } else {
+                Py_DECREF(resultat);
+                resultat = NULL;
+            }
+        }
+        PyMem_Free(exportation.valeurs);
     }
     return resultat;
 }
 
 /**
- * \brief "Wrapper" pour la fonction 'retirer_second_enfant_arbre_binaire'
+ * \brief Vrifie quelles valeurs sont dans le sous-arbre, en un seul appel
+ *         'contient_elements_arbre_binaire' fait sans le GIL. Un arbre
+ *        cr avec l'option MORRIS garde le GIL: son parcours modifie
+ *        temporairement les liens des noeuds.
  *
- * \param self L'objet python reprsentant le module
+ * \param self L'objet du noeud
  * \param args Conteneur possdant les arguments envoys  la fonction
  *
- * \return Objet Python 'None' (type NULL de Python)
+ * \return Objet "Tableau" de boolens (format "?"), un par valeur
  */
-static PyObject *arbre_binaire_retirer_second_enfant(PyObject *self, PyObject *args)
+static PyObject *arbre_binaire_contains_many(ArbreObjet *self,
+                                             PyObject *args)
 {
-    bool contient_erreur = false;
-    void* arbre = NULL;
-    PyObject * resultat;
-    if (PyArg_ParseTuple(args, "i", &arbre)) {
-        if (arbre) {
-            retirer_second_enfant_arbre_binaire(arbre);
+    ArbreObjet *racine = arbre_binaire_racine(self);
+    struct entiers entiers;
+    PyObject *objet;
+    PyObject *resultat = NULL;
+    unsigned char *bits = NULL;
+    unsigned char *presents = NULL;
+    PyThreadState *etat = NULL;
+    Py_ssize_t i;
+    if (arbre_binaire_verifier(self) && PyArg_ParseTuple(args, "O", &objet) &&
+            arbre_binaire_lire_entiers(objet, &entiers)) {
+        if (entiers.nombre > INT_MAX) {
+            PyErr_SetString(PyExc_OverflowError, "Il y a trop de valeurs.");
         } else {
-            contient_erreur = true;
+            bits = PyMem_Malloc((entiers.nombre + 7) / 8);
+            presents = PyMem_Malloc(entiers.nombre);
+            if (bits == NULL || presents == NULL) {
+                PyErr_NoMemory();
+            }
         }
-    } else {
-        contient_erreur = true;
+        if (bits && presents) {
+            if (!(racine->options & ARBRE_BINAIRE_OPTION_MORRIS)) {
+                racine->lecteurs = racine->lecteurs + 1;
+                etat = PyEval_SaveThread();
+            }
+            contient_elements_arbre_binaire(self->noeud, entiers.valeurs,
+                                            (int)entiers.nombre, bits);
+            for (i = 0; i < entiers.nombre; i = i + 1) {
+                presents[i] = bits[i / 8] >> (i % 8) & 1;
+            }
+            if (etat) {
+                PyEval_RestoreThread(etat);
+                racine->lecteurs = racine->lecteurs - 1;
+            }
+            resultat = arbre_binaire_resultat(self, arbre_binaire_tableau(
+                    presents, entiers.nombre, 1, "?"));
+        } else {
+            PyMem_Free(presents);
+        }
+        PyMem_Free(bits);
+        arbre_binaire_liberer_entiers(&entiers);
     }
-    if (contient_erreur) {
-        resultat = NULL;
+    return resultat;
+}
+
+/**
+ * \brief Remplit la vue d'un objet "Tableau" (protocole "buffer"). Les
+ *        donnes ne sont pas copies et ne peuvent pas tre modifies.
+ *
+ * \param self L'objet du tableau
+ * \param vue La vue  remplir
+ * \param drapeaux Les informations demandes (PyBUF_*)
+ *
+ * \return 0, ou -1 (avec une exception) si une vue modifiable est demande
+ */
+static int arbre_binaire_tableau_vue(TableauObjet *self, Py_buffer *vue,
+                                     int drapeaux)
+{
+    int resultat = 0;
+    if (drapeaux & PyBUF_WRITABLE) {
+        PyErr_SetString(PyExc_BufferError, "Le tableau est en lecture seule.");
+        vue->obj = NULL;
+        resultat = -1;
     } else {
-        Py_INCREF(Py_None);
-        resultat = Py_None;
+        vue->buf = self->donnees;
+        vue->obj = (PyObject *)self;
+        vue->len = self->nombre * self->taille_element;
+        vue->readonly = 1;
+        vue->itemsize = self->taille_element;
+        vue->format = NULL;
+        if (drapeaux & PyBUF_FORMAT) {
+            vue->format = self->format;
+        }
+        vue->ndim = 1;
+        vue->shape = NULL;
+        if (drapeaux & PyBUF_ND) {
+            vue->shape = &self->nombre;
+        }
+        vue->strides = NULL;
+        if ((drapeaux & PyBUF_STRIDES) == PyBUF_STRIDES) {
+            vue->strides = &self->taille_element;
+        }
+        vue->suboffsets = NULL;
+        vue->internal = NULL;
+        Py_INCREF(self);
     }
     return resultat;
 }
 
 /**
- * \brief Liste toutes les fonctions du module
+ * \brief Indique le nombre d'lments d'un objet "Tableau" (len()).
  */
-static PyMethodDef liste_liee_methods[] = {
-    {"creer",  arbre_binaire_creer, METH_VARARGS,
-     "Crer un arbre binaire"},
-    {"charger",  arbre_binaire_charger, METH_VARARGS,
-     "Charger un arbre binaire  partir du contenue d'un fichier"},
-    {"detruire",  arbre_binaire_detruire, METH_VARARGS,
-     "Dsalloue l'arbre binaire"},
-    {"sauvegarder",  arbre_binaire_sauvegarder, METH_VARARGS,
+static Py_ssize_t arbre_binaire_tableau_longueur(TableauObjet *self)
+{
+    return self->nombre;
+}
+
+/**
+ * \brief Libre un objet "Tableau" et ses donnes. Les vues gardent une
+ *        rfrence vers le tableau: il n'est libr qu'aprs elles.
+ */
+static void arbre_binaire_tableau_liberer(TableauObjet *self)
+{
+    PyMem_Free(self->donnees);
+    PyObject_Del(self);
+}
+
+/**
+ * \brief Liste toutes les mthodes du type "Arbre"
+ */
+static PyMethodDef arbre_binaire_methodes[] = {
+    {"sauvegarder", (PyCFunction)arbre_binaire_sauvegarder, METH_VARARGS,
      "Sauvegarder le contenue de l'arbre binaire dans un fichier"},
-    {"nombre_elements", arbre_binaire_nombre_elements, METH_VARARGS,
-     "Indique le nombre d'lments dans l'arbre"},
-    {"nombre_feuilles", arbre_binaire_nombre_feuilles, METH_VARARGS,
-     "Indique le nombre de feuilles dans l'arbre"},
-    {"hauteur", arbre_binaire_hauteur, METH_VARARGS,
+    {"nombre_elements", (PyCFunction)arbre_binaire_nombre_elements,
+     METH_NOARGS, "Indique le nombre d'elements dans l'arbre"},
+    {"nombre_feuilles", (PyCFunction)arbre_binaire_nombre_feuilles,
+     METH_NOARGS, "Indique le nombre de feuilles dans l'arbre"},
+    {"hauteur", (PyCFunction)arbre_binaire_hauteur, METH_NOARGS,
      "Indique la hauteur de l'arbre"},
-    {"element", arbre_binaire_element, METH_VARARGS,
-     "Indique l'lment  la racine"},
-    {"modifier_element", arbre_binaire_modifier_element, METH_VARARGS,
-     "Modifie la valeur de la racine"},
-    {"contient_element", arbre_binaire_contient_element, METH_VARARGS,
-     "Indique si la valeur se trouve dans l'arbre"},
-    {"premier_enfant", arbre_binaire_premier_enfant, METH_VARARGS,
-     "Renvoie le premier_enfant"},
-    {"creer_premier_enfant", arbre_binaire_creer_premier_enfant, METH_VARARGS,
-     "Creer le premier_enfant"},
-    {"retirer_premier_enfant", arbre_binaire_retirer_premier_enfant, METH_VARARGS,
-     "Supprime le premier_enfant"},
-     {"second_enfant", arbre_binaire_second_enfant, METH_VARARGS,
-     "Renvoie le second_enfant"},
-    {"creer_second_enfant", arbre_binaire_second_premier_enfant, METH_VARARGS,
-     "Creer le second_enfant"},
-    {"retirer_second_enfant", arbre_binaire_second_premier_enfant, METH_VARARGS,
-     "Supprime le second_enfant"}
+    {"element", (PyCFunction)arbre_binaire_element, METH_NOARGS,
+     "Indique l'element du noeud"},
+    {"modifier_element", (PyCFunction)arbre_binaire_modifier_element,
+     METH_VARARGS, "Modifie la valeur du noeud"},
+    {"contient_element", (PyCFunction)arbre_binaire_contient_element,
+     METH_VARARGS, "Indique si la valeur se trouve dans l'arbre"},
+    {"premier_enfant", (PyCFunction)arbre_binaire_premier_enfant,
+     METH_NOARGS, "Renvoie le premier enfant, ou None"},
+    {"second_enfant", (PyCFunction)arbre_binaire_second_enfant,
+     METH_NOARGS, "Renvoie le second enfant, ou None"},
+    {"creer_premier_enfant", (PyCFunction)arbre_binaire_creer_premier_enfant,
+     METH_VARARGS, "Creer le premier enfant et le renvoie"},
+    {"creer_second_enfant", (PyCFunction)arbre_binaire_creer_second_enfant,
+     METH_VARARGS, "Creer le second enfant et le renvoie"},
+    {"retirer_premier_enfant",
+     (PyCFunction)arbre_binaire_retirer_premier_enfant, METH_NOARGS,
+     "Supprime le premier enfant"},
+    {"retirer_second_enfant",
+     (PyCFunction)arbre_binaire_retirer_second_enfant, METH_NOARGS,
+     "Supprime le second enfant"},
+    {"exporter", (PyCFunction)arbre_binaire_exporter,
+     METH_VARARGS | METH_KEYWORDS,
+     "Renvoie les tableaux (valeurs, masques) du sous-arbre dans l'ordre "
+     "demande"},
+    {"to_list", (PyCFunction)arbre_binaire_to_list,
+     METH_VARARGS | METH_KEYWORDS,
+     "Renvoie la liste des valeurs du sous-arbre dans l'ordre demande"},
+    {"contains_many", (PyCFunction)arbre_binaire_contains_many, METH_VARARGS,
+     "Renvoie un tableau de booleens: la presence de chaque valeur"},
+    {NULL, NULL, 0, NULL}        /* Sentinel */
+};
+
+/**
+ * \brief Le type "Arbre": un noeud d'un arbre binaire
+ */
+static PyTypeObject ArbreType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "arbre_binaire_externe.Arbre",
+    .tp_basicsize = sizeof(ArbreObjet),
+    .tp_dealloc = (destructor)arbre_binaire_liberer,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Noeud d'un arbre binaire: Arbre(valeur, options=0) cree la "
+              "racine d'un nouvel arbre",
+    .tp_methods = arbre_binaire_methodes,
+    .tp_new = arbre_binaire_nouveau,
+};
+
+/**
+ * \brief Le protocole "buffer" du type "Tableau"
+ */
+static PyBufferProcs arbre_binaire_tableau_buffer = {
+    (getbufferproc)arbre_binaire_tableau_vue,
+    NULL
+};
+
+/**
+ * \brief La longueur du type "Tableau"
+ */
+static PySequenceMethods arbre_binaire_tableau_sequence = {
+    .sq_length = (lenfunc)arbre_binaire_tableau_longueur,
+};
+
+/**
+ * \brief Le type "Tableau": des valeurs contigus lisibles sans copie
+ *        (memoryview, numpy.frombuffer, ...)
+ */
+static PyTypeObject TableauType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "arbre_binaire_externe.Tableau",
+    .tp_basicsize = sizeof(TableauObjet),
+    .tp_dealloc = (destructor)arbre_binaire_tableau_liberer,
+    .tp_as_sequence = &arbre_binaire_tableau_sequence,
+    .tp_as_buffer = &arbre_binaire_tableau_buffer,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Tableau de valeurs contigues exporte par un arbre",
+};
+
+/**
+ * \brief Liste toutes les fonctions du module
+ */
+static PyMethodDef arbre_binaire_fonctions[] = {
+    {"charger", arbre_binaire_charger, METH_VARARGS,
+     "Charger un arbre binaire a partir du contenue d'un fichier"},
+    {"from_sorted", (PyCFunction)arbre_binaire_from_sorted,
+     METH_VARARGS | METH_KEYWORDS,
+     "Construit un arbre equilibre a partir de valeurs triees"},
+    {"from_preorder", (PyCFunction)arbre_binaire_from_preorder,
+     METH_VARARGS | METH_KEYWORDS,
+     "Construit un arbre a partir de ses valeurs en ordre prefixe et des "
+     "masques de leurs enfants"},
     {NULL, NULL, 0, NULL}        /* Sentinel */
 };
 
@@ -635,7 +1193,7 @@ static struct PyModuleDef arbre_binaire_module = {
    NULL, /* documentation du module, NULL si aucun */
    -1,       /*  Taille de l'tat "per-interpreter" du module,
                 ou -1 si le module ce situe en variable globale. */
-   arbre_binaire_methods /* La liste des fonctions du module */
+   arbre_binaire_fonctions /* La liste des fonctions du module */
 };
 
 /**
@@ -643,13 +1201,37 @@ static struct PyModuleDef arbre_binaire_module = {
  */
 PyMODINIT_FUNC PyInit_arbre_binaire_externe(void)
 {
-	PyObject *l_module;
-	l_module = PyModule_Create(&arbre_binaire_module); /* Crer le module */
-	if (l_module) {
-		/* Ajouter un gestionnaire d'exception dans le module */
-		arbre_binaire_erreur = PyErr_NewException("arbre_binaire_externe.erreur", NULL, NULL);
-		Py_INCREF(arbre_binaire_erreur);
-		PyModule_AddObject(l_module, "erreur", arbre_binaire_erreur);
-	}
+    PyObject *l_module = NULL;
+    if (PyType_Ready(&ArbreType) == 0 && PyType_Ready(&TableauType) == 0) {
+        l_module = PyModule_Create(&arbre_binaire_module); /* Crer le module */
+    }
+    if (l_module) {
+        /* Ajouter un gestionnaire d'exception dans le module */
+        arbre_binaire_erreur = PyErr_NewException("arbre_binaire_externe.erreur",
+                                                  NULL, NULL);
+        Py_INCREF(arbre_binaire_erreur);
+        PyModule_AddObject(l_module, "erreur", arbre_binaire_erreur);
+        Py_INCREF(&ArbreType);
+        PyModule_AddObject(l_module, "Arbre", (PyObject *)&ArbreType);
+        Py_INCREF(&TableauType);
+        PyModule_AddObject(l_module, "Tableau", (PyObject *)&TableauType);
+        /* Les ordres de parcours et les options des arbres */
+        PyModule_AddIntConstant(l_module, "PREFIXE", ARBRE_BINAIRE_PREFIXE);
+        PyModule_AddIntConstant(l_module, "INFIXE", ARBRE_BINAIRE_INFIXE);
+        PyModule_AddIntConstant(l_module, "POSTFIXE", ARBRE_BINAIRE_POSTFIXE);
+        PyModule_AddIntConstant(l_module, "LARGEUR", ARBRE_BINAIRE_LARGEUR);
+        PyModule_AddIntConstant(l_module, "OPTION_ARENE",
+                                ARBRE_BINAIRE_OPTION_ARENE);
+        PyModule_AddIntConstant(l_module, "OPTION_AUGMENTE",
+                                ARBRE_BINAIRE_OPTION_AUGMENTE);
+        PyModule_AddIntConstant(l_module, "OPTION_ORDONNE",
+                                ARBRE_BINAIRE_OPTION_ORDONNE);
+        PyModule_AddIntConstant(l_module, "OPTION_EQUILIBRE",
+                                ARBRE_BINAIRE_OPTION_EQUILIBRE);
+        PyModule_AddIntConstant(l_module, "OPTION_CONCURRENT",
+                                ARBRE_BINAIRE_OPTION_CONCURRENT);
+        PyModule_AddIntConstant(l_module, "OPTION_MORRIS",
+                                ARBRE_BINAIRE_OPTION_MORRIS);
+    }
     return l_module;
 }
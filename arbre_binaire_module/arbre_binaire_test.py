@@ -12,63 +12,104 @@
 # python_version  :3.4.0
 # =============================================================================
 
+import threading
 import arbre_binaire_externe
 
-arbre1 = arbre_binaire_externe.creer(1)
-arbre_binaire_externe.creer_premier_enfant(arbre1, 3)
-arbre_binaire_externe.creer_second_enfant(arbre1, 4)
-arbre_binaire_externe.sauvegarder(arbre1, "arbre_binaire_test.bin")
-arbre_binaire_externe.detruire(arbre1)
+arbre1 = arbre_binaire_externe.Arbre(1)
+arbre1.creer_premier_enfant(3)
+arbre1.creer_second_enfant(4)
+arbre1.sauvegarder("arbre_binaire_test.bin")
+del arbre1
 arbre2 = arbre_binaire_externe.charger("arbre_binaire_test.bin")
 
 try:
-	arbre_binaire_externe.modifier_element(arbre2, 2)
-except Exception as message:
-	print("Ne peut modifier la valeur de la racine: " + str(message) + "\n")
+	arbre2.creer_premier_enfant(2)
+except arbre_binaire_externe.erreur as message:
+	print("Ne peut pas creer un second premier enfant: " + str(message) + "\n")
 
-if(arbre_binaire_externe.hauteur(arbre2) == 2):
+if(arbre2.hauteur() == 2):
 	print("La hauteur de l'arbre est: 2 \n")
 else:
 	print("Une erreur est survenue \n")
 
-if(arbre_binaire_externe.nombre_elements(arbre2) == 3):
+if(arbre2.nombre_elements() == 3):
 	print("Le nombre d'element est: 3 \n")
 else:
 	print("Une erreur est survenue \n")
 	
-if(arbre_binaire_externe.nombre_feuilles(arbre2) == 2):
+if(arbre2.nombre_feuilles() == 2):
 	print("Le nombre de feuilles est: 2 \n")
 else:
 	print("Une erreur est survenue \n")
 
-if(arbre_binaire_externe(arbre2) == 2):
+arbre2.modifier_element(2)
+if(arbre2.element() == 2):
 	print("La valeur de la racine est: 2 \n")
 else:
 	print("Une erreur est survenue \n")
 	
-if(arbre_binaire_externe.contient_element(arbre2, 4) == true):
+if(arbre2.contient_element(4) == True):
 	print("L'element '4' est present dans l'arbre \n")
 else:
 	print("Une erreur est survenue \n")
 	
-premier_enfant = arbre_binaire_externe.premier_enfant(arbre2)
-arbre_binaire_externe.creer_premier_enfant(premier_enfant, 5)
+premier_enfant = arbre2.premier_enfant()
+premier_enfant.creer_premier_enfant(5)
 
-if(arbre_binaire_externe.hauteur(arbre2) == 3):
+if(arbre2.hauteur() == 3):
 	print("La hauteur de l'arbre est: 3")
 else:
 	print("Une erreur est survenue")
 
-arbre_binaire_externe.retirer_premier_enfant(premier_enfant)
+valeurs, masques = arbre2.exporter(arbre_binaire_externe.LARGEUR)
+if(list(memoryview(valeurs)) == [2, 3, 4, 5] and
+		list(memoryview(masques)) == [3, 1, 0, 0]):
+	print("L'arbre a ete exporte en ordre de largeur")
+else:
+	print("Une erreur est survenue")
+
+premier_enfant.retirer_premier_enfant()
 
-if(arbre_binaire_externe.hauteur(arbre2) == 2):
+if(arbre2.hauteur() == 2):
 	print("La hauteur de l'arbre est: 2")
 else:
 	print("Une erreur est survenue")
 
-	
-	
-	
+try:
+	arbre2.second_enfant().element()
+	premier_enfant.element()
+	arbre_binaire_externe.Arbre.element(arbre2.premier_enfant())
+	print("Les noeuds sont toujours accessibles")
+except arbre_binaire_externe.erreur:
+	print("Une erreur est survenue")
 
-	
-	
\ No newline at end of file
+arbre3 = arbre_binaire_externe.from_sorted(range(1, 8))
+if(arbre3.to_list(order=arbre_binaire_externe.INFIXE) == [1, 2, 3, 4, 5, 6, 7] and
+		arbre3.hauteur() == 3):
+	print("L'arbre a ete construit a partir de valeurs triees")
+else:
+	print("Une erreur est survenue")
+
+valeurs, masques = arbre3.exporter()
+arbre4 = arbre_binaire_externe.from_preorder(valeurs, masques)
+if(arbre4.to_list() == arbre3.to_list() and
+		list(memoryview(arbre4.contains_many([0, 4, 8]))) == [False, True, False]):
+	print("L'arbre a ete reconstruit en ordre prefixe")
+else:
+	print("Une erreur est survenue")
+
+arbre5 = arbre_binaire_externe.from_sorted(range(65536),
+		options=arbre_binaire_externe.OPTION_MORRIS)
+resultats = []
+def chercher():
+	for i in range(5):
+		resultats.extend(memoryview(arbre5.contains_many(range(0, 65536, 64))))
+fils = [threading.Thread(target=chercher) for i in range(8)]
+for fil in fils:
+	fil.start()
+for fil in fils:
+	fil.join()
+if(len(resultats) == 8 * 5 * 1024 and all(resultats)):
+	print("Les recherches simultanees ont toutes reussi")
+else:
+	print("Une erreur est survenue")
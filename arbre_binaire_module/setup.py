@@ -16,7 +16,7 @@ from distutils.core import setup, Extension
 
 arbre_binaire_externe = Extension('arbre_binaire_externe',
                     include_dirs = ['../arbre_binaire/'],
-                    libraries = ['arbre_binaire'],
+                    libraries = ['arbre_binaire', 'pthread'],
                     library_dirs = ['../arbre_binaire/bin/Release/'],
                     sources = ['arbre_binaire_module.c'])
 
@@ -37,6 +37,18 @@
 
 #include "arbre_binaire.h"
 
+/**
+ * \brief Visiteur qui inscrit les valeurs visites dans un tableau.
+ */
+static bool noter_valeur(arbre_binaire* noeud, int profondeur, void* donnees)
+{
+    int* valeurs = donnees;
+
+    valeurs[0] = valeurs[0] + 1;
+    valeurs[valeurs[0]] = element_arbre_binaire(noeud);
+    return valeurs[0] < 3;
+}
+
 /**
  * \brief Test de l'arbre binaire.
  */
@@ -44,6 +56,18 @@ int main()
 {
     arbre_binaire* arbre1;
     arbre_binaire* arbre2;
+    arbre_binaire* arbre3;
+    arbre_binaire* noeud;
+    arbre_binaire_flux* flux;
+    arbre_binaire_fige* fige;
+    arbre_binaire_compact* compact;
+    int i;
+    int valeurs[5] = {0};
+    unsigned char presents[1];
+    int chaine[3] = {30, 20, 10};
+    unsigned char masques[3] = {1, 1, 0};
+    arbre_binaire_iterateur iterateur;
+    arbre_binaire_statistiques statistiques;
     arbre1 = creer_arbre_binaire(1);
 
     if (arbre1)
@@ -67,6 +91,10 @@ int main()
         detruire_arbre_binaire(arbre1);
         arbre2 = charger_arbre_binaire("arbre_binaire_test.bin");
         sauvegarder_arbre_binaire(arbre2, "arbrebinaire2.bin");
+        if (sauvegarder_arbre_binaire_options(arbre2, "arbrebinaire2.bin",
+                ARBRE_BINAIRE_SAUVEGARDE_SYNCHRONISER) != ARBRE_BINAIRE_SUCCES) {
+            printf("Une erreur s'est produite\n");
+        }
         if (arbre2) {
              if (a_erreur_arbre_binaire(arbre2)) {
                 printf("Ne peut charger le fichier 'arbre_binaire_test.bin':\
@@ -96,6 +124,15 @@ int main()
                 } else {
                     printf("Une erreur s'est produite\n");
                 }
+                if (parcourir_arbre_binaire(arbre2, ARBRE_BINAIRE_INFIXE,
+                                            noter_valeur, valeurs) == false &&
+                        valeurs[0] == 3 && valeurs[1] == 5 &&
+                        valeurs[2] == 3 && valeurs[3] == 2) {
+                    printf("Le parcours infixe s'est arrete apres 3 \
+elements.\n");
+                } else {
+                    printf("Une erreur s'est produite\n");
+                }
                 retirer_premier_enfant_arbre_binaire(arbre2);
                 retirer_second_enfant_arbre_binaire(arbre2);
                 if (nombre_elements_arbre_binaire(arbre2) == 1) {
@@ -111,6 +148,426 @@ int main()
     } else {
         printf("Une erreur s'est produite\n");
     }
+    arbre3 = creer_arbre_binaire_options(0, ARBRE_BINAIRE_OPTION_ARENE);
+    if (arbre3) {
+        noeud = arbre3;
+        for (i = 1; i < 1000; i++) {
+            creer_second_enfant_arbre_binaire(noeud, i);
+            noeud = second_enfant_arbre_binaire(noeud);
+        }
+        retirer_second_enfant_arbre_binaire(arbre3);
+        creer_second_enfant_arbre_binaire(arbre3, 1);
+        if (nombre_elements_arbre_binaire(arbre3) == 2) {
+            printf("L'arbre alloue dans une arene a ete construit.\n");
+        } else {
+            printf("Une erreur s'est produite\n");
+        }
+        detruire_arbre_binaire(arbre3);
+    } else {
+        printf("Une erreur s'est produite\n");
+    }
+    arbre3 = creer_arbre_binaire_options(1, ARBRE_BINAIRE_OPTION_AUGMENTE);
+    if (arbre3) {
+        creer_premier_enfant_arbre_binaire(arbre3, 2);
+        creer_second_enfant_arbre_binaire(arbre3, 3);
+        creer_premier_enfant_arbre_binaire(premier_enfant_arbre_binaire(arbre3),
+                                           4);
+        if (nombre_elements_arbre_binaire(arbre3) == 4 &&
+                nombre_feuilles_arbre_binaire(arbre3) == 2 &&
+                hauteur_arbre_binaire(arbre3) == 3) {
+            printf("Les informations de l'arbre augmente sont a jour.\n");
+        } else {
+            printf("Une erreur s'est produite\n");
+        }
+        retirer_premier_enfant_arbre_binaire(arbre3);
+        if (nombre_elements_arbre_binaire(arbre3) == 2 &&
+                nombre_feuilles_arbre_binaire(arbre3) == 1 &&
+                hauteur_arbre_binaire(arbre3) == 2) {
+            printf("Les informations de l'arbre augmente ont ete mises a \
+jour.\n");
+        } else {
+            printf("Une erreur s'est produite\n");
+        }
+        detruire_arbre_binaire(arbre3);
+    } else {
+        printf("Une erreur s'est produite\n");
+    }
+    arbre3 = creer_arbre_binaire_options(50, ARBRE_BINAIRE_OPTION_ORDONNE);
+    if (arbre3) {
+        for (i = 0; i < 100; i = i + 3) {
+            inserer_element_arbre_binaire(arbre3, i);
+        }
+        supprimer_element_arbre_binaire(arbre3, 50);
+        if (contient_element_arbre_binaire(arbre3, 51) &&
+                !contient_element_arbre_binaire(arbre3, 50) &&
+                element_arbre_binaire(borne_inferieure_arbre_binaire(arbre3,
+                                                                     52)) == 54 &&
+                element_arbre_binaire(borne_superieure_arbre_binaire(arbre3,
+                                                                     54)) == 57 &&
+                nombre_elements_arbre_binaire(arbre3) == 34) {
+            printf("L'arbre ordonne trouve ses elements.\n");
+        } else {
+            printf("Une erreur s'est produite\n");
+        }
+        if (creer_premier_enfant_arbre_binaire(arbre3, 1) != ARBRE_BINAIRE_SUCCES) {
+            printf("Ne peut creer un enfant: %s\n", erreur_arbre_binaire(arbre3));
+        }
+        detruire_arbre_binaire(arbre3);
+    } else {
+        printf("Une erreur s'est produite\n");
+    }
+    arbre3 = creer_arbre_binaire_options(0, ARBRE_BINAIRE_OPTION_EQUILIBRE);
+    if (arbre3) {
+        for (i = 1; i < 1023; i++) {
+            inserer_element_arbre_binaire(arbre3, i);
+        }
+        if (hauteur_arbre_binaire(arbre3) == 10 &&
+                nombre_elements_arbre_binaire(arbre3) == 1023 &&
+                contient_element_arbre_binaire(arbre3, 1022)) {
+            printf("L'arbre equilibre a 10 etages pour 1023 elements.\n");
+        } else {
+            printf("Une erreur s'est produite\n");
+        }
+        retirer_premier_enfant_arbre_binaire(arbre3);
+        if (a_erreur_arbre_binaire(arbre3)) {
+            printf("Ne peut retirer un enfant: %s\n",
+                   erreur_arbre_binaire(arbre3));
+        } else {
+            printf("Une erreur s'est produite\n");
+        }
+        if (nombre_elements_arbre_binaire(arbre3) != 1023) {
+            printf("Une erreur s'est produite\n");
+        }
+        detruire_arbre_binaire(arbre3);
+    } else {
+        printf("Une erreur s'est produite\n");
+    }
+    arbre3 = charger_arbre_binaire_options("arbre_binaire_test.bin",
+                                           ARBRE_BINAIRE_OPTION_ARENE);
+    if (arbre3 && !a_erreur_arbre_binaire(arbre3) &&
+            nombre_elements_arbre_binaire(arbre3) == 4 &&
+            hauteur_arbre_binaire(arbre3) == 3) {
+        printf("Le fichier a ete charge dans une arene.\n");
+    } else {
+        printf("Une erreur s'est produite\n");
+    }
+    if (arbre3) {
+        detruire_arbre_binaire(arbre3);
+    }
+    arbre3 = charger_arbre_binaire_options("arbre_binaire_test.bin",
+                                           ARBRE_BINAIRE_OPTION_EQUILIBRE);
+    if (arbre3 && a_erreur_arbre_binaire(arbre3)) {
+        printf("L'arbre non ordonne a ete refuse au chargement.\n");
+    } else {
+        printf("Une erreur s'est produite\n");
+    }
+    if (arbre3) {
+        detruire_arbre_binaire(arbre3);
+    }
+    arbre3 = charger_arbre_binaire("arbre_binaire_test.bin");
+    if (arbre3 && sauvegarder_arbre_binaire_options(arbre3,
+                "arbre_binaire_compact.bin", ARBRE_BINAIRE_SAUVEGARDE_COMPACT)
+            == ARBRE_BINAIRE_SUCCES) {
+        detruire_arbre_binaire(arbre3);
+        arbre3 = charger_arbre_binaire("arbre_binaire_compact.bin");
+    }
+    if (arbre3 && !a_erreur_arbre_binaire(arbre3) &&
+            nombre_elements_arbre_binaire(arbre3) == 4 &&
+            nombre_feuilles_arbre_binaire(arbre3) == 2 &&
+            contient_element_arbre_binaire(arbre3, 5)) {
+        printf("Le fichier compact a ete relu.\n");
+    } else {
+        printf("Une erreur s'est produite\n");
+    }
+    if (arbre3) {
+        detruire_arbre_binaire(arbre3);
+    }
+    flux = ouvrir_flux_arbre_binaire("arbre_binaire_test.bin");
+    if (flux && lire_flux_arbre_binaire(flux, &valeurs[0], &valeurs[1],
+                                        &valeurs[2]) &&
+            valeurs[1] == 1 && valeurs[2] == 3 &&
+            nombre_feuilles_flux_arbre_binaire(flux) == 2 &&
+            !a_erreur_flux_arbre_binaire(flux)) {
+        printf("Le fichier a ete lu comme un flux.\n");
+    } else {
+        printf("Une erreur s'est produite\n");
+    }
+    fermer_flux_arbre_binaire(flux);
+    flux = ouvrir_flux_arbre_binaire("arbre_binaire_compact.bin");
+    if (flux && hauteur_flux_arbre_binaire(flux) == 3) {
+        printf("Le flux compact a 3 etages.\n");
+    } else {
+        printf("Une erreur s'est produite\n");
+    }
+    fermer_flux_arbre_binaire(flux);
+    arbre3 = charger_arbre_binaire("arbre_binaire_test.bin");
+    fige = figer_arbre_binaire(arbre3);
+    if (arbre3) {
+        detruire_arbre_binaire(arbre3);
+    }
+    if (fige && nombre_elements_arbre_binaire_fige(fige) == 4 &&
+            nombre_feuilles_arbre_binaire_fige(fige) == 2 &&
+            hauteur_arbre_binaire_fige(fige) == 3 &&
+            contient_element_arbre_binaire_fige(fige, 5) &&
+            !contient_element_arbre_binaire_fige(fige, 6)) {
+        printf("L'arbre fige a 4 elements.\n");
+    } else {
+        printf("Une erreur s'est produite\n");
+    }
+    valeurs[0] = 5;
+    valeurs[1] = 6;
+    valeurs[2] = 2;
+    if (fige && contient_elements_arbre_binaire_fige(fige, valeurs, 3,
+                                                     presents) == 2 &&
+            presents[0] == 5) {
+        printf("Les elements 5 et 2 sont dans l'arbre fige.\n");
+    } else {
+        printf("Une erreur s'est produite\n");
+    }
+    arbre3 = fige ? degeler_arbre_binaire(fige) : NULL;
+    if (arbre3 && hauteur_arbre_binaire(arbre3) == 3 &&
+            premier_enfant_arbre_binaire(arbre3)->premier_fils->valeur == 5) {
+        printf("L'arbre a ete degele.\n");
+    } else {
+        printf("Une erreur s'est produite\n");
+    }
+    if (arbre3) {
+        detruire_arbre_binaire(arbre3);
+    }
+    detruire_arbre_binaire_fige(fige);
+    arbre3 = creer_arbre_binaire_options(0, ARBRE_BINAIRE_OPTION_ARENE);
+    noeud = arbre3;
+    for (i = 1; noeud && i <= 100000; i++) {
+        creer_second_enfant_arbre_binaire(noeud, i);
+        creer_premier_enfant_arbre_binaire(noeud, -i);
+        noeud = premier_enfant_arbre_binaire(noeud);
+    }
+    if (noeud && nombre_elements_parallele_arbre_binaire(arbre3, 4) == 200001 &&
+            nombre_feuilles_parallele_arbre_binaire(arbre3, 4) == 100001 &&
+            hauteur_parallele_arbre_binaire(arbre3, 4) == 100001 &&
+            contient_element_parallele_arbre_binaire(arbre3, 99999, 4) &&
+            !contient_element_parallele_arbre_binaire(arbre3, 100001, 4)) {
+        printf("Le parcours parallele a compte 200001 elements.\n");
+    } else {
+        printf("Une erreur s'est produite\n");
+    }
+    if (arbre3) {
+        detruire_arbre_binaire(arbre3);
+    }
+    arbre3 = creer_arbre_binaire_options(1, ARBRE_BINAIRE_OPTION_CONCURRENT |
+                                            ARBRE_BINAIRE_OPTION_ORDONNE);
+    for (i = 0; arbre3 && i < 200; i++) {
+        creer_premier_enfant_arbre_binaire(arbre3, i);
+        creer_premier_enfant_arbre_binaire(premier_enfant_arbre_binaire(arbre3),
+                                           -i);
+        retirer_premier_enfant_arbre_binaire(arbre3);
+    }
+    if (arbre3 && creer_second_enfant_arbre_binaire(arbre3, 7) ==
+            ARBRE_BINAIRE_SUCCES) {
+        i = entrer_lecture_arbre_binaire(arbre3);
+        noeud = second_enfant_arbre_binaire(arbre3);
+        sortir_lecture_arbre_binaire(arbre3, i);
+    }
+    if (arbre3 && i >= 0 && element_arbre_binaire(noeud) == 7 &&
+            nombre_elements_arbre_binaire(arbre3) == 2 &&
+            creer_second_enfant_arbre_binaire(arbre3, 8) ==
+            ARBRE_BINAIRE_ERREUR && a_erreur_arbre_binaire(arbre3)) {
+        printf("L'arbre concurrent a libere les enfants retires.\n");
+    } else {
+        printf("Une erreur s'est produite\n");
+    }
+    if (arbre3) {
+        detruire_arbre_binaire(arbre3);
+    }
+    arbre3 = creer_arbre_binaire_options(1, ARBRE_BINAIRE_OPTION_PERSISTANT);
+    creer_premier_enfant_arbre_binaire(arbre3, 2);
+    creer_second_enfant_arbre_binaire(arbre3, 3);
+    arbre2 = instantane_arbre_binaire(arbre3);
+    modifier_element_arbre_binaire(premier_enfant_arbre_binaire(arbre3), 20);
+    retirer_second_enfant_arbre_binaire(arbre3);
+    if (arbre2 && nombre_elements_arbre_binaire(arbre3) == 2 &&
+            nombre_elements_arbre_binaire(arbre2) == 3 &&
+            element_arbre_binaire(premier_enfant_arbre_binaire(arbre3)) == 20 &&
+            element_arbre_binaire(premier_enfant_arbre_binaire(arbre2)) == 2) {
+        printf("L'instantane n'a pas ete modifie.\n");
+    } else {
+        printf("Une erreur s'est produite\n");
+    }
+    if (arbre2) {
+        creer_second_enfant_arbre_binaire(arbre2, 4);
+        if (a_erreur_arbre_binaire(arbre2)) {
+            printf("L'instantane ne peut pas etre modifie.\n");
+        } else {
+            printf("Une erreur s'est produite\n");
+        }
+        detruire_arbre_binaire(arbre2);
+    }
+    detruire_arbre_binaire(arbre3);
+    for (i = 0; i < 5; i++) {
+        valeurs[i] = 10 * (i + 1);
+    }
+    arbre3 = construire_trie_arbre_binaire(valeurs, 5,
+                                           ARBRE_BINAIRE_OPTION_EQUILIBRE);
+    if (arbre3 && nombre_elements_arbre_binaire(arbre3) == 5 &&
+            hauteur_arbre_binaire(arbre3) == 3 &&
+            element_arbre_binaire(arbre3) == 30 &&
+            chercher_element_arbre_binaire(arbre3, 50) != NULL) {
+        printf("L'arbre equilibre a ete construit a partir du tableau.\n");
+    } else {
+        printf("Une erreur s'est produite\n");
+    }
+    if (arbre3) {
+        detruire_arbre_binaire(arbre3);
+    }
+    presents[0] = 0x0F;
+    arbre3 = construire_largeur_arbre_binaire(valeurs, presents, 5, 0);
+    if (arbre3 && !a_erreur_arbre_binaire(arbre3) &&
+            nombre_elements_arbre_binaire(arbre3) == 4 &&
+            element_arbre_binaire(premier_enfant_arbre_binaire(
+                premier_enfant_arbre_binaire(arbre3))) == 40) {
+        printf("L'arbre a ete construit en ordre de largeur.\n");
+    } else {
+        printf("Une erreur s'est produite\n");
+    }
+    if (arbre3) {
+        detruire_arbre_binaire(arbre3);
+    }
+    arbre2 = construire_largeur_arbre_binaire(valeurs, presents, 5,
+                                              ARBRE_BINAIRE_OPTION_ORDONNE);
+    arbre3 = construire_prefixe_arbre_binaire(chaine, masques, 3,
+                                              ARBRE_BINAIRE_OPTION_EQUILIBRE);
+    if (arbre2 && a_erreur_arbre_binaire(arbre2) &&
+            arbre3 && a_erreur_arbre_binaire(arbre3)) {
+        printf("Les arbres ordonnes invalides ont ete refuses.\n");
+    } else {
+        printf("Une erreur s'est produite\n");
+    }
+    if (arbre2) {
+        detruire_arbre_binaire(arbre2);
+    }
+    if (arbre3) {
+        detruire_arbre_binaire(arbre3);
+    }
+    arbre2 = construire_trie_arbre_binaire(valeurs, 5, 0);
+    arbre3 = construire_trie_arbre_binaire(valeurs, 5,
+                                           ARBRE_BINAIRE_OPTION_ORDONNE);
+    valeurs[0] = 15;
+    valeurs[3] = 55;
+    if (arbre2 && arbre3 &&
+            contient_elements_arbre_binaire(arbre3, valeurs, 5, presents) == 3 &&
+            presents[0] == 0x16 &&
+            contient_elements_arbre_binaire(arbre2, valeurs, 5, presents) == 3 &&
+            presents[0] == 0x16) {
+        printf("Les valeurs ont ete cherchees en lot.\n");
+    } else {
+        printf("Une erreur s'est produite\n");
+    }
+    if (arbre2) {
+        detruire_arbre_binaire(arbre2);
+    }
+    if (arbre3) {
+        detruire_arbre_binaire(arbre3);
+    }
+    arbre3 = creer_arbre_binaire_options(30, ARBRE_BINAIRE_OPTION_ORDONNE |
+                                         ARBRE_BINAIRE_OPTION_PARENT);
+    for (i = 0; i < 5; i++) {
+        inserer_element_arbre_binaire(arbre3, 10 * (i + 1));
+    }
+    i = 0;
+    for (noeud = commencer_iterateur_arbre_binaire(&iterateur, arbre3); noeud;
+         noeud = suivant_iterateur_arbre_binaire(&iterateur)) {
+        if (element_arbre_binaire(noeud) == 10 * (i + 1)) {
+            i = i + 1;
+        }
+    }
+    noeud = chercher_iterateur_arbre_binaire(&iterateur, arbre3, 25);
+    if (i == 5 && noeud && element_arbre_binaire(noeud) == 30 &&
+            element_arbre_binaire(
+                precedent_iterateur_arbre_binaire(&iterateur)) == 20) {
+        printf("L'arbre a ete parcouru avec un iterateur.\n");
+    } else {
+        printf("Une erreur s'est produite\n");
+    }
+    detruire_arbre_binaire(arbre3);
+    arbre3 = creer_arbre_binaire_options(1, ARBRE_BINAIRE_OPTION_MORRIS);
+    creer_premier_enfant_arbre_binaire(arbre3, 2);
+    creer_second_enfant_arbre_binaire(arbre3, 3);
+    noeud = premier_enfant_arbre_binaire(arbre3);
+    creer_premier_enfant_arbre_binaire(noeud, 4);
+    creer_second_enfant_arbre_binaire(noeud, 5);
+    valeurs[0] = 0;
+    if (hauteur_arbre_binaire(arbre3) == 3 &&
+            contient_element_arbre_binaire(arbre3, 4) &&
+            parcourir_arbre_binaire(arbre3, ARBRE_BINAIRE_INFIXE_MORRIS,
+                                    noter_valeur, valeurs) == false &&
+            valeurs[1] == 4 && valeurs[2] == 2 && valeurs[3] == 5 &&
+            second_enfant_arbre_binaire(second_enfant_arbre_binaire(noeud))
+                == NULL &&
+            nombre_elements_arbre_binaire(arbre3) == 5) {
+        printf("L'arbre a ete parcouru sans pile.\n");
+    } else {
+        printf("Une erreur s'est produite\n");
+    }
+    arbre2 = cloner_arbre_binaire(arbre3);
+    noeud = premier_enfant_arbre_binaire(noeud);
+    if (arbre2 && greffer_second_enfant_arbre_binaire(noeud, arbre2) ==
+                ARBRE_BINAIRE_SUCCES &&
+            greffer_second_enfant_arbre_binaire(noeud, arbre2) ==
+                ARBRE_BINAIRE_ERREUR &&
+            nombre_elements_arbre_binaire(arbre3) == 10 &&
+            nombre_elements_arbre_binaire(arbre2) == 5 &&
+            hauteur_arbre_binaire(arbre3) == 6) {
+        printf("L'arbre a ete copie puis greffe.\n");
+    } else {
+        printf("Une erreur s'est produite\n");
+    }
+    if (arbre2) {
+        detruire_arbre_binaire(arbre2);
+    }
+    detruire_arbre_binaire(arbre3);
+    remettre_statistiques_arbre_binaire();
+    arbre3 = creer_arbre_binaire(1);
+    creer_premier_enfant_arbre_binaire(arbre3, 2);
+    contient_element_arbre_binaire(arbre3, 3);
+    detruire_arbre_binaire(arbre3);
+    if (!lire_statistiques_arbre_binaire(&statistiques) ||
+            (statistiques.noeuds_alloues == 2 &&
+             statistiques.noeuds_liberes == 2 &&
+             statistiques.noeuds_visites[
+                 ARBRE_BINAIRE_FONCTION_CONTIENT] == 2 &&
+             statistiques.appels[ARBRE_BINAIRE_FONCTION_CREER_ENFANT] == 1)) {
+        printf("Les statistiques ont ete lues.\n");
+    } else {
+        printf("Une erreur s'est produite\n");
+    }
+    compact = creer_arbre_binaire_compact(1);
+    if (compact && creer_premier_enfant_arbre_binaire_compact(compact,
+                        ARBRE_BINAIRE_COMPACT_RACINE, 2) ==
+                ARBRE_BINAIRE_SUCCES &&
+            creer_second_enfant_arbre_binaire_compact(compact,
+                        ARBRE_BINAIRE_COMPACT_RACINE, 3) ==
+                ARBRE_BINAIRE_SUCCES &&
+            creer_premier_enfant_arbre_binaire_compact(compact,
+                        ARBRE_BINAIRE_COMPACT_RACINE, 4) ==
+                ARBRE_BINAIRE_ERREUR) {
+        retirer_premier_enfant_arbre_binaire_compact(compact,
+                                            ARBRE_BINAIRE_COMPACT_RACINE);
+        arbre3 = decompacter_arbre_binaire(compact);
+    } else {
+        arbre3 = NULL;
+    }
+    if (arbre3 && nombre_elements_arbre_binaire(arbre3) == 2 &&
+            element_arbre_binaire(second_enfant_arbre_binaire(arbre3)) == 3 &&
+            contient_element_arbre_binaire_compact(compact, 3) &&
+            !contient_element_arbre_binaire_compact(compact, 2)) {
+        printf("L'arbre compact a 2 elements.\n");
+    } else {
+        printf("Une erreur s'est produite\n");
+    }
+    if (arbre3) {
+        detruire_arbre_binaire(arbre3);
+    }
+    detruire_arbre_binaire_compact(compact);
     printf("Tous les tests ont ete executes.\n");
 
     return 0;